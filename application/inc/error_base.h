@@ -11,6 +11,7 @@
 // Peripherals.
 #include "adc.h"
 #include "aes.h"
+#include "dma.h"
 #include "flash.h"
 #include "i2c.h"
 #include "iwdg.h"
@@ -34,7 +35,9 @@
 // Middleware.
 #include "analog.h"
 #include "cli.h"
+#include "clock.h"
 #include "gps.h"
+#include "overlay.h"
 #include "power.h"
 // Sigfox.
 #include "sigfox_error.h"
@@ -50,7 +53,8 @@ typedef enum {
     // Peripherals.
     ERROR_BASE_ADC = 0x0100,
     ERROR_BASE_AES = (ERROR_BASE_ADC + ADC_ERROR_BASE_LAST),
-    ERROR_BASE_FLASH = (ERROR_BASE_AES + AES_ERROR_BASE_LAST),
+    ERROR_BASE_DMA_TERMINAL = (ERROR_BASE_AES + AES_ERROR_BASE_LAST),
+    ERROR_BASE_FLASH = (ERROR_BASE_DMA_TERMINAL + DMA_ERROR_BASE_LAST),
     ERROR_BASE_I2C_SENSORS = (ERROR_BASE_FLASH + FLASH_ERROR_BASE_LAST),
     ERROR_BASE_IWDG = (ERROR_BASE_I2C_SENSORS + I2C_ERROR_BASE_LAST),
     ERROR_BASE_LPTIM = (ERROR_BASE_IWDG + IWDG_ERROR_BASE_LAST),
@@ -76,8 +80,10 @@ typedef enum {
     // Middleware.
     ERROR_BASE_ANALOG = (ERROR_BASE_SHT30 + SHT3X_ERROR_BASE_LAST),
     ERROR_BASE_CLI = (ERROR_BASE_ANALOG + ANALOG_ERROR_BASE_LAST),
-    ERROR_BASE_GPS = (ERROR_BASE_CLI + CLI_ERROR_BASE_LAST),
-    ERROR_BASE_POWER = (ERROR_BASE_GPS + GPS_ERROR_BASE_LAST),
+    ERROR_BASE_CLOCK = (ERROR_BASE_CLI + CLI_ERROR_BASE_LAST),
+    ERROR_BASE_GPS = (ERROR_BASE_CLOCK + CLOCK_ERROR_BASE_LAST),
+    ERROR_BASE_OVERLAY = (ERROR_BASE_GPS + GPS_ERROR_BASE_LAST),
+    ERROR_BASE_POWER = (ERROR_BASE_OVERLAY + OVERLAY_ERROR_BASE_LAST),
     ERROR_BASE_SIGFOX_EP_LIB = (ERROR_BASE_POWER + POWER_ERROR_BASE_LAST),
     ERROR_BASE_SIGFOX_EP_ADDON_RFP = (ERROR_BASE_SIGFOX_EP_LIB + (SIGFOX_ERROR_SOURCE_LAST * ERROR_BASE_STEP)),
     // Last base value.
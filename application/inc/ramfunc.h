@@ -0,0 +1,22 @@
+/*
+ * ramfunc.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __RAMFUNC_H__
+#define __RAMFUNC_H__
+
+/*** RAMFUNC macros ***/
+
+/*!******************************************************************
+ * \def RAMFUNC
+ * \brief Place a function in the .ramfunc section, copied from flash to RAM by the startup code.
+ * \details Long calls are required since RAM and flash are too far apart for a BL instruction.
+ * Total size is bounded by the linker script (1.5K), so keep this attribute for short interrupt paths only.
+ * Flash stays powered in sleep mode (FLASH_ACR_SLEEP_PD is not set): the vector table and the drivers code called by these paths are still fetched from flash.
+ *******************************************************************/
+#define RAMFUNC     __attribute__((section(".ramfunc"), noinline, long_call))
+
+#endif /* __RAMFUNC_H__ */
@@ -22,6 +22,22 @@
 //#define TKFX_MODE_CLI
 //#define TKFX_MODE_DEBUG
 
+/*** Uplink frames ***/
+
+//#define TKFX_GEOLOC_COMPACT // 6 bytes scaled integer position frame (no altitude) instead of the 11 bytes geolocation frame.
+
+/*** Sensors bus ***/
+
+#define TKFX_SENSORS_I2C_FAST_MODE // 400kHz sensors I2C bus when the system clock is HSI16 (standard mode otherwise).
+#define TKFX_SENSORS_I2C_DMA // Sensors I2C transfers by DMA with the core in sleep mode.
+
+/*** Diagnostics ***/
+
+//#define TKFX_MONITORING_STACK_USAGE // Append stack high-water mark (bytes) to the monitoring frame.
+//#define TKFX_PROFILER // Execution time probes on TIM22 (readable with $PROF? in CLI mode).
+//#define TKFX_MARKERS // State and RF/GPS sub-phase pulse codes on TP2 (PA4) for power analyzer synchronization.
+//#define TKFX_DIAGNOSTICS_UPLINK // Daily awake time and wake duration histogram frame.
+
 /*** Board parameters ***/
 
 #ifdef TKFX_MODE_SUPERCAPACITOR
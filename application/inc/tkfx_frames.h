@@ -0,0 +1,99 @@
+/*
+ * tkfx_frames.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TKFX_FRAMES_H__
+#define __TKFX_FRAMES_H__
+
+/*
+ * Sigfox uplink frames layout, shared by the firmware and the host decoder (script/tkfx_decoder).
+ * TKFX_SIGFOX_<FRAME>_FIELDS(FIELD) expands FIELD(name, size_bits) for each field, in transmission order (MSB first).
+ * This file must only contain macros so that host tools can include it.
+ */
+
+/*** TKFX FRAMES macros ***/
+
+// Startup frame.
+#define TKFX_SIGFOX_STARTUP_DATA_SIZE                   8
+#define TKFX_SIGFOX_STARTUP_FIELDS(FIELD) \
+    FIELD(reset_reason, 8) \
+    FIELD(major_version, 8) \
+    FIELD(minor_version, 8) \
+    FIELD(commit_index, 8) \
+    FIELD(commit_id, 28) \
+    FIELD(dirty_flag, 4)
+
+// Monitoring frame (stack usage field is only sent when TKFX_MONITORING_STACK_USAGE is defined).
+#define TKFX_SIGFOX_MONITORING_BASE_DATA_SIZE           7
+#define TKFX_SIGFOX_MONITORING_STACK_USAGE_DATA_SIZE    9
+#define TKFX_SIGFOX_MONITORING_BASE_FIELDS(FIELD) \
+    FIELD(tamb_degrees, 8) \
+    FIELD(hamb_degrees, 8) \
+    FIELD(vsrc_mv, 16) \
+    FIELD(vstr_mv, 16) \
+    FIELD(status, 8)
+#define TKFX_SIGFOX_MONITORING_STACK_USAGE_FIELDS(FIELD) \
+    TKFX_SIGFOX_MONITORING_BASE_FIELDS(FIELD) \
+    FIELD(stack_high_water_mark_bytes, 16)
+
+// Geolocation frame (seconds field is the fractional part of minutes in 1/100000 minute).
+#define TKFX_SIGFOX_GEOLOC_DATA_SIZE                    11
+#define TKFX_SIGFOX_GEOLOC_FIELDS(FIELD) \
+    FIELD(latitude_degrees, 8) \
+    FIELD(latitude_minutes, 6) \
+    FIELD(latitude_seconds, 17) \
+    FIELD(latitude_north_flag, 1) \
+    FIELD(longitude_degrees, 8) \
+    FIELD(longitude_minutes, 6) \
+    FIELD(longitude_seconds, 17) \
+    FIELD(longitude_east_flag, 1) \
+    FIELD(altitude_meters, 16) \
+    FIELD(gps_fix_duration_seconds, 8)
+
+// Compact geolocation frame (sent instead of the geolocation frame when TKFX_GEOLOC_COMPACT is defined).
+// Coordinates are scaled integers of the position in 1/100000 minute (units) offset to be positive:
+//   code = round(units * 2^size_bits / full_scale), saturated to 2^size_bits - 1 for the latitude,
+//   modulo 2^size_bits for the longitude (180 degrees east and west both give code 0).
+// Altitude is not transmitted in this 6 bytes frame.
+// The resolution is chosen with the fields sizes (which must keep the frame size), default is the same angular step of
+// 180 / 2^22 degree for both axes (4.8 m of latitude, maximum rounding error 2.4 m).
+// Fix duration class n is [2^(n-1), 2^n - 1] seconds (0 for less than 1 second, 7 for 64 seconds and more).
+#define TKFX_SIGFOX_GEOLOC_COMPACT_DATA_SIZE            6
+#define TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_SIZE_BITS   22
+#define TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_SIZE_BITS  23
+#define TKFX_SIGFOX_GEOLOC_COMPACT_DURATION_SIZE_BITS   3
+#define TKFX_SIGFOX_GEOLOC_COMPACT_FIELDS(FIELD) \
+    FIELD(latitude_code, TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_SIZE_BITS) \
+    FIELD(longitude_code, TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_SIZE_BITS) \
+    FIELD(gps_fix_duration_class, TKFX_SIGFOX_GEOLOC_COMPACT_DURATION_SIZE_BITS)
+#define TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(degrees, minutes, seconds)  ((((uint32_t) (degrees) * 60 + (uint32_t) (minutes)) * 100000) + (uint32_t) (seconds))
+#define TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_FULL_SCALE  TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(180, 0, 0)
+#define TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_FULL_SCALE TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(360, 0, 0)
+
+// Geolocation timeout frame.
+#define TKFX_SIGFOX_GEOLOC_TIMEOUT_DATA_SIZE            2
+#define TKFX_SIGFOX_GEOLOC_TIMEOUT_FIELDS(FIELD) \
+    FIELD(gps_acquisition_status, 8) \
+    FIELD(gps_acquisition_duration_seconds, 8)
+
+// Diagnostics frame (only sent when TKFX_DIAGNOSTICS_UPLINK is defined).
+#define TKFX_SIGFOX_DIAGNOSTICS_DATA_SIZE               10
+#define TKFX_SIGFOX_DIAGNOSTICS_FIELDS(FIELD) \
+    FIELD(awake_time_seconds, 16) \
+    FIELD(wake_histogram_0, 8) \
+    FIELD(wake_histogram_1, 8) \
+    FIELD(wake_histogram_2, 8) \
+    FIELD(wake_histogram_3, 8) \
+    FIELD(wake_histogram_4, 8) \
+    FIELD(wake_histogram_5, 8) \
+    FIELD(wake_histogram_6, 8) \
+    FIELD(wake_histogram_7, 8)
+
+// Error stack frame.
+#define TKFX_SIGFOX_ERROR_STACK_DATA_SIZE               12
+// Error stack encoding and FAULT_*_SIZE_BITS fields sizes are defined in middleware fault.h.
+
+#endif /* __TKFX_FRAMES_H__ */
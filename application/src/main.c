@@ -23,21 +23,34 @@
 #include "mma865xfc_configuration.h"
 #include "sensors_hw.h"
 #include "sht3x.h"
+#include "sht3x_measurement.h"
 // Utils.
 #include "error.h"
 #include "types.h"
 // Middleware.
+#include "activity.h"
 #include "analog.h"
 #include "cli.h"
+#include "clock.h"
+#include "fault.h"
+#include "frame.h"
 #include "gps.h"
+#include "marker.h"
+#include "motion.h"
 #include "power.h"
+#include "profiler.h"
+#include "ram.h"
 #include "sigfox_ep_api.h"
 #include "sigfox_types.h"
 #include "sigfox_rc.h"
+#include "timestamp.h"
+#include "trace.h"
 // Applicative.
 #include "at.h"
 #include "error_base.h"
+#include "ramfunc.h"
 #include "tkfx_flags.h"
+#include "tkfx_frames.h"
 #include "version.h"
 
 /*** MAIN macros ***/
@@ -51,6 +64,30 @@
 #ifdef TKFX_MODE_HIKING
 #define TKFX_MODE                               0b10
 #endif
+// Accelerometer profile: wake data rate and oversampling when moving, sleep data rate and oversampling when parked and inactivity delay before auto-sleep.
+#ifdef TKFX_MODE_CAR
+#define TKFX_MMA865XFC_DR                       MMA865XFC_CONFIGURATION_DR_6HZ25
+#define TKFX_MMA865XFC_MODS                     MMA865XFC_CONFIGURATION_MODS_LP
+#define TKFX_MMA865XFC_ASLP_RATE                MMA865XFC_CONFIGURATION_ASLP_RATE_1HZ56
+#define TKFX_MMA865XFC_SMODS                    MMA865XFC_CONFIGURATION_MODS_LP
+#define TKFX_MMA865XFC_ASLP_DELAY_MS            60000
+#endif
+#ifdef TKFX_MODE_BIKE
+#define TKFX_MMA865XFC_DR                       MMA865XFC_CONFIGURATION_DR_12HZ5
+#define TKFX_MMA865XFC_MODS                     MMA865XFC_CONFIGURATION_MODS_LP
+#define TKFX_MMA865XFC_ASLP_RATE                MMA865XFC_CONFIGURATION_ASLP_RATE_1HZ56
+#define TKFX_MMA865XFC_SMODS                    MMA865XFC_CONFIGURATION_MODS_LP
+#define TKFX_MMA865XFC_ASLP_DELAY_MS            30000
+#endif
+#ifdef TKFX_MODE_HIKING
+#define TKFX_MMA865XFC_DR                       MMA865XFC_CONFIGURATION_DR_12HZ5
+#define TKFX_MMA865XFC_MODS                     MMA865XFC_CONFIGURATION_MODS_LP
+#define TKFX_MMA865XFC_ASLP_RATE                MMA865XFC_CONFIGURATION_ASLP_RATE_1HZ56
+#define TKFX_MMA865XFC_SMODS                    MMA865XFC_CONFIGURATION_MODS_LP
+#define TKFX_MMA865XFC_ASLP_DELAY_MS            60000
+#endif
+// Start detection bucket fill per motion IRQ, tuned at 1.56Hz and scaled to the wake data rate (IRQ rate is proportional to the data rate while moving).
+#define TKFX_MOTION_FILL_PER_EVENT              ((MOTION_BUCKET_UNITS_PER_EVENT * MMA865XFC_CONFIGURATION_DR_ODR_MHZ(MMA865XFC_CONFIGURATION_DR_1HZ56)) / MMA865XFC_CONFIGURATION_DR_ODR_MHZ(TKFX_MMA865XFC_DR))
 // Voltage hysteresis for radio.
 #ifdef TKFX_MODE_SUPERCAPACITOR
 #define TKFX_RADIO_OFF_VCAP_THRESHOLD_MV        1000
@@ -59,18 +96,40 @@
 #define TKFX_RADIO_OFF_VCAP_THRESHOLD_MV        3500
 #endif
 #define TKFX_RADIO_ON_VCAP_THRESHOLD_MV         TKFX_ACTIVE_MODE_VSTR_MIN_MV
-// Sigfox payload lengths.
-#define TKFX_SIGFOX_STARTUP_DATA_SIZE           8
-#define TKFX_SIGFOX_GEOLOC_DATA_SIZE            11
-#define TKFX_SIGFOX_GEOLOC_TIMEOUT_DATA_SIZE    2
-#define TKFX_SIGFOX_MONITORING_DATA_SIZE        7
-#define TKFX_SIGFOX_ERROR_STACK_DATA_SIZE       12
+// Sigfox monitoring payload (other frames layouts are fixed in tkfx_frames.h).
+#ifdef TKFX_MONITORING_STACK_USAGE
+#define TKFX_SIGFOX_MONITORING_DATA_SIZE        TKFX_SIGFOX_MONITORING_STACK_USAGE_DATA_SIZE
+#define TKFX_SIGFOX_MONITORING_FIELDS           TKFX_SIGFOX_MONITORING_STACK_USAGE_FIELDS
+#else
+#define TKFX_SIGFOX_MONITORING_DATA_SIZE        TKFX_SIGFOX_MONITORING_BASE_DATA_SIZE
+#define TKFX_SIGFOX_MONITORING_FIELDS           TKFX_SIGFOX_MONITORING_BASE_FIELDS
+#endif
+// Frame buffer (error stack is the largest uplink).
+#define TKFX_SIGFOX_FRAME_SIZE_MAX              TKFX_SIGFOX_ERROR_STACK_DATA_SIZE
 // Error values.
 #define TKFX_ERROR_VALUE_ANALOG_16BITS          0xFFFF
 #define TKFX_ERROR_VALUE_TEMPERATURE            0x7F
 #define TKFX_ERROR_VALUE_HUMIDITY               0xFF
+// Ambient measurement (low repeatability is enough for 1 degree and 1 percent resolution).
+#define TKFX_SHT3X_REPEATABILITY                SHT3X_MEASUREMENT_REPEATABILITY_LOW
+#define TKFX_SHT3X_CLOCK_STRETCHING             1
+// Internal clocks calibration cache (temperature band with hysteresis margin).
+#define TKFX_CLOCK_CALIBRATION_BAND_DEGREES     8
+#define TKFX_CLOCK_CALIBRATION_MARGIN_DEGREES   2
+#define TKFX_CLOCK_CALIBRATION_MAX_AGE_SECONDS  86400
 // Error stack message period.
 #define TKFX_ERROR_STACK_PERIOD_SECONDS         86400
+// Diagnostics message period and histogram resolution (half percent).
+#ifdef TKFX_DIAGNOSTICS_UPLINK
+#define TKFX_DIAGNOSTICS_PERIOD_SECONDS         86400
+#define TKFX_DIAGNOSTICS_HISTOGRAM_FULL_SCALE   200
+#endif
+// Trace value of a message dropped due to low storage element voltage.
+#define TKFX_TRACE_RADIO_DISABLED               0xFFFF
+// Compact geolocation frame fix duration class saturation.
+#ifdef TKFX_GEOLOC_COMPACT
+#define TKFX_GEOLOC_COMPACT_DURATION_CLASS_MAX  ((0b1 << TKFX_SIGFOX_GEOLOC_COMPACT_DURATION_SIZE_BITS) - 1)
+#endif
 // Altitude stability filter.
 #define TKFX_GEOLOC_TIMEOUT_SECONDS             180
 #define TKFX_ALTITUDE_STABILITY_FILTER_MOVING   2
@@ -101,15 +160,16 @@ typedef enum {
 
 /*******************************************************************/
 typedef union {
+    // Native little endian bit fields: declared from LSB (tracker_mode) to MSB (gps_backup_status) of the monitoring status byte.
     struct {
-        unsigned gps_backup_status :1;
-        unsigned accelerometer_status :1;
-        unsigned lse_status :1;
-        unsigned lsi_status :1;
-        unsigned moving_flag :1;
-        unsigned alarm_flag :1;
         unsigned tracker_mode :2;
-    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+        unsigned alarm_flag :1;
+        unsigned moving_flag :1;
+        unsigned lsi_status :1;
+        unsigned lse_status :1;
+        unsigned accelerometer_status :1;
+        unsigned gps_backup_status :1;
+    } __attribute__((packed));
     uint8_t all;
 } TKFX_status_t;
 
@@ -120,67 +180,67 @@ typedef union {
         unsigned geoloc_request :1;
         unsigned monitoring_request :1;
         unsigned por :1;
-    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+    } __attribute__((packed));
     uint8_t all;
 } TKFX_flags_t;
 
 /*******************************************************************/
-typedef union {
-    uint8_t frame[TKFX_SIGFOX_STARTUP_DATA_SIZE];
-    struct {
-        unsigned reset_reason :8;
-        unsigned major_version :8;
-        unsigned minor_version :8;
-        unsigned commit_index :8;
-        unsigned commit_id :28;
-        unsigned dirty_flag :4;
-    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
-} TKFX_sigfox_startup_data_t;
+typedef struct {
+    TKFX_SIGFOX_STARTUP_FIELDS(FRAME_FIELD_VALUE)
+} TKFX_sigfox_startup_fields_t;
 
 /*******************************************************************/
-typedef union {
-    uint8_t frame[TKFX_SIGFOX_MONITORING_DATA_SIZE];
-    struct {
-        unsigned tamb_degrees :8;
-        unsigned hamb_degrees :8;
-        unsigned vsrc_mv :16;
-        unsigned vstr_mv :16;
-        unsigned status :8;
-    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
-} TKFX_sigfox_monitoring_data_t;
+typedef struct {
+    TKFX_SIGFOX_MONITORING_FIELDS(FRAME_FIELD_VALUE)
+} TKFX_sigfox_monitoring_fields_t;
 
 /*******************************************************************/
-typedef union {
-    uint8_t frame[TKFX_SIGFOX_GEOLOC_DATA_SIZE];
-    struct {
-        unsigned latitude_degrees :8;
-        unsigned latitude_minutes :6;
-        unsigned latitude_seconds :17;
-        unsigned latitude_north_flag :1;
-        unsigned longitude_degrees :8;
-        unsigned longitude_minutes :6;
-        unsigned longitude_seconds :17;
-        unsigned longitude_east_flag :1;
-        unsigned altitude_meters :16;
-        unsigned gps_fix_duration_seconds :8;
-    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
-} TKFX_sigfox_geoloc_data_t;
+typedef struct {
+    TKFX_SIGFOX_GEOLOC_FIELDS(FRAME_FIELD_VALUE)
+} TKFX_sigfox_geoloc_fields_t;
+
+#ifdef TKFX_GEOLOC_COMPACT
+/*******************************************************************/
+typedef struct {
+    TKFX_SIGFOX_GEOLOC_COMPACT_FIELDS(FRAME_FIELD_VALUE)
+} TKFX_sigfox_geoloc_compact_fields_t;
+#endif
+
+/*******************************************************************/
+typedef struct {
+    TKFX_SIGFOX_GEOLOC_TIMEOUT_FIELDS(FRAME_FIELD_VALUE)
+} TKFX_sigfox_geoloc_timeout_fields_t;
+
+#ifdef TKFX_DIAGNOSTICS_UPLINK
+/*******************************************************************/
+typedef struct {
+    TKFX_SIGFOX_DIAGNOSTICS_FIELDS(FRAME_FIELD_VALUE)
+} TKFX_sigfox_diagnostics_fields_t;
+#endif
 
 /*******************************************************************/
 typedef union {
-    uint8_t frame[TKFX_SIGFOX_GEOLOC_TIMEOUT_DATA_SIZE];
-    struct {
-        unsigned gps_acquisition_status :8;
-        unsigned gps_acquisition_duration_seconds :8;
-    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
-} TKFX_sigfox_geoloc_timeout_data_t;
+    // Frames are built one at a time.
+    TKFX_sigfox_startup_fields_t startup;
+    TKFX_sigfox_monitoring_fields_t monitoring;
+#ifdef TKFX_GEOLOC_COMPACT
+    TKFX_sigfox_geoloc_compact_fields_t geoloc_compact;
+#else
+    TKFX_sigfox_geoloc_fields_t geoloc;
+#endif
+    TKFX_sigfox_geoloc_timeout_fields_t geoloc_timeout;
+#ifdef TKFX_DIAGNOSTICS_UPLINK
+    TKFX_sigfox_diagnostics_fields_t diagnostics;
+#endif
+} TKFX_sigfox_fields_t;
 
 /*!******************************************************************
  * \struct TKFX_configuration_t
  * \brief Tracker configuration structure.
  *******************************************************************/
 typedef struct {
-    uint32_t start_detection_threshold_irq;
+    const MMA865XFC_register_setting_t* accelerometer_configuration;
+    MOTION_bucket_configuration_t start_detection;
     uint32_t stop_detection_threshold_seconds;
     uint32_t moving_geoloc_period_seconds;
     uint32_t stopped_geoloc_period_seconds;
@@ -195,26 +255,30 @@ typedef struct {
     TKFX_mode_t mode;
     TKFX_flags_t flags;
     // Tracker algorithm.
-    volatile uint32_t start_detection_irq_count;
     volatile uint32_t last_motion_irq_time_seconds;
     uint32_t monitoring_next_time_seconds;
     uint32_t geoloc_next_time_seconds;
     uint32_t error_stack_next_time_seconds;
-    // SW version.
-    TKFX_sigfox_startup_data_t sigfox_startup_data;
+#ifdef TKFX_DIAGNOSTICS_UPLINK
+    uint32_t diagnostics_next_time_seconds;
+#endif
+    // Clocks calibration.
+    int32_t tamb_last_degrees;
+    uint8_t tamb_last_valid;
+    int32_t clock_calibration_band;
+    uint8_t clock_calibration_band_valid;
+    uint32_t clock_calibration_time_seconds;
+    // Uplink frames.
+    TKFX_sigfox_fields_t sigfox_fields;
+    uint8_t sigfox_frame[TKFX_SIGFOX_FRAME_SIZE_MAX];
     // Monitoring.
     TKFX_status_t status;
     uint8_t tamb_degrees;
     uint8_t hamb_percent;
     uint32_t vsrc_mv;
     uint32_t vstr_mv;
-    TKFX_sigfox_monitoring_data_t sigfox_monitoring_data;
     // Geoloc.
     NEOM8X_position_t geoloc_position;
-    TKFX_sigfox_geoloc_data_t sigfox_geoloc_data;
-    TKFX_sigfox_geoloc_timeout_data_t sigfox_geoloc_timeout_data;
-    // Error stack.
-    uint8_t sigfox_error_stack_data[TKFX_SIGFOX_ERROR_STACK_DATA_SIZE];
 } TKFX_context_t;
 #endif
 
@@ -222,34 +286,61 @@ typedef struct {
 
 #ifndef TKFX_MODE_CLI
 static TKFX_context_t tkfx_ctx;
+// Accelerometer active configuration of the tracker mode (auto-sleep enabled).
+static const MMA865XFC_register_setting_t TKFX_MMA865XFC_ACTIVE_CONFIGURATION[MMA865XFC_ACTIVE_CONFIGURATION_SIZE] = MMA865XFC_CONFIGURATION_ACTIVE(TKFX_MMA865XFC_DR, TKFX_MMA865XFC_MODS, TKFX_MMA865XFC_ASLP_RATE, TKFX_MMA865XFC_SMODS, 1, TKFX_MMA865XFC_ASLP_DELAY_MS);
+// Start detection bucket: fill per IRQ, leak per second, start threshold and capacity in MOTION_BUCKET_UNITS_PER_EVENT units.
 #ifdef TKFX_MODE_CAR
-static const TKFX_configuration_t TKFX_CONFIG = { 0, 150, 300, 86400, 3600 };
+static const TKFX_configuration_t TKFX_CONFIG = { TKFX_MMA865XFC_ACTIVE_CONFIGURATION, { TKFX_MOTION_FILL_PER_EVENT, 100, 0, 10000 }, 150, 300, 86400, 3600 };
 #endif
 #ifdef TKFX_MODE_BIKE
-static const TKFX_configuration_t TKFX_CONFIG = {5, 150, 300, 86400, 3600};
+static const TKFX_configuration_t TKFX_CONFIG = { TKFX_MMA865XFC_ACTIVE_CONFIGURATION, { TKFX_MOTION_FILL_PER_EVENT, 100, 5000, 10000 }, 150, 300, 86400, 3600 };
 #endif
 #ifdef TKFX_MODE_HIKING
-static const TKFX_configuration_t TKFX_CONFIG = {5, 60, 600, 86400, 3600};
+static const TKFX_configuration_t TKFX_CONFIG = { TKFX_MMA865XFC_ACTIVE_CONFIGURATION, { TKFX_MOTION_FILL_PER_EVENT, 100, 5000, 10000 }, 60, 600, 86400, 3600 };
+#endif
+// Clock profile applied on state entry (radio transmissions always switch to high performance).
+static const CLOCK_profile_t TKFX_STATE_CLOCK_PROFILE[TKFX_STATE_LAST] = {
+    CLOCK_PROFILE_HIGH_PERFORMANCE, // STARTUP.
+    CLOCK_PROFILE_HIGH_PERFORMANCE, // WAKEUP (clocks calibration).
+    CLOCK_PROFILE_HIGH_PERFORMANCE, // MEASURE (I2C and ADC).
+    CLOCK_PROFILE_HIGH_PERFORMANCE, // MODE_UPDATE (I2C and ADC).
+    CLOCK_PROFILE_HIGH_PERFORMANCE, // MONITORING.
+    CLOCK_PROFILE_HIGH_PERFORMANCE, // GEOLOC (GPS parsing).
+    CLOCK_PROFILE_LOW_POWER, // ERROR_STACK.
+    CLOCK_PROFILE_LOW_POWER, // OFF.
+    CLOCK_PROFILE_LOW_POWER // SLEEP.
+};
+// Uplink frames layouts (fields size in bits, in the order of the fields structures).
+static const uint8_t TKFX_SIGFOX_STARTUP_LAYOUT[] = { TKFX_SIGFOX_STARTUP_FIELDS(FRAME_FIELD_SIZE) };
+static const uint8_t TKFX_SIGFOX_MONITORING_LAYOUT[] = { TKFX_SIGFOX_MONITORING_FIELDS(FRAME_FIELD_SIZE) };
+#ifdef TKFX_GEOLOC_COMPACT
+static const uint8_t TKFX_SIGFOX_GEOLOC_COMPACT_LAYOUT[] = { TKFX_SIGFOX_GEOLOC_COMPACT_FIELDS(FRAME_FIELD_SIZE) };
+#else
+static const uint8_t TKFX_SIGFOX_GEOLOC_LAYOUT[] = { TKFX_SIGFOX_GEOLOC_FIELDS(FRAME_FIELD_SIZE) };
 #endif
+static const uint8_t TKFX_SIGFOX_GEOLOC_TIMEOUT_LAYOUT[] = { TKFX_SIGFOX_GEOLOC_TIMEOUT_FIELDS(FRAME_FIELD_SIZE) };
+#ifdef TKFX_DIAGNOSTICS_UPLINK
+static const uint8_t TKFX_SIGFOX_DIAGNOSTICS_LAYOUT[] = { TKFX_SIGFOX_DIAGNOSTICS_FIELDS(FRAME_FIELD_SIZE) };
+#endif
+// State names used by the activity statistics.
+static const char_t* const TKFX_STATE_NAME[TKFX_STATE_LAST] = { "STARTUP", "WAKEUP", "MEASURE", "MODE_UPDATE", "MONITORING", "GEOLOC", "ERROR_STACK", "OFF", "SLEEP" };
+#else
+static const char_t* const TKFX_STATE_NAME[1] = { "CLI" };
 #endif
 
 /*** MAIN functions ***/
 
 /*******************************************************************/
-static void _TKFX_rtc_wakeup_timer_irq_callback(void) {
-#ifndef TKFX_MODE_CLI
-    // Decrement IRQ count.
-    if (tkfx_ctx.start_detection_irq_count > 0) {
-        tkfx_ctx.start_detection_irq_count--;
-    }
-#endif
+static RAMFUNC void _TKFX_rtc_wakeup_timer_irq_callback(void) {
+    // Track calendar roll-over of the millisecond timestamp.
+    TIMESTAMP_get_milliseconds();
 }
 
 #ifndef TKFX_MODE_CLI
 /*******************************************************************/
-static void _TKFX_motion_irq_callback(void) {
+static RAMFUNC void _TKFX_motion_irq_callback(void) {
     // Update variables.
-    tkfx_ctx.start_detection_irq_count++;
+    MOTION_add_event(TIMESTAMP_get_milliseconds());
     tkfx_ctx.last_motion_irq_time_seconds = RTC_get_uptime_seconds();
 }
 #endif
@@ -265,11 +356,20 @@ static void _TKFX_init_context(void) {
     tkfx_ctx.flags.radio_enabled = 1;
     tkfx_ctx.status.all = 0;
     tkfx_ctx.status.tracker_mode = TKFX_MODE;
-    tkfx_ctx.start_detection_irq_count = 0;
     tkfx_ctx.last_motion_irq_time_seconds = 0;
     tkfx_ctx.monitoring_next_time_seconds = TKFX_CONFIG.monitoring_period_seconds;
     tkfx_ctx.geoloc_next_time_seconds = TKFX_CONFIG.stopped_geoloc_period_seconds;
     tkfx_ctx.error_stack_next_time_seconds = 0;
+#ifdef TKFX_DIAGNOSTICS_UPLINK
+    tkfx_ctx.diagnostics_next_time_seconds = TKFX_DIAGNOSTICS_PERIOD_SECONDS;
+#endif
+    tkfx_ctx.tamb_last_degrees = 0;
+    tkfx_ctx.tamb_last_valid = 0;
+    tkfx_ctx.clock_calibration_band = 0;
+    tkfx_ctx.clock_calibration_band_valid = 0;
+    tkfx_ctx.clock_calibration_time_seconds = 0;
+    // Init start detector.
+    MOTION_init(&TKFX_CONFIG.start_detection);
     // Set motion interrupt callback address.
     SENSORS_HW_set_accelerometer_irq_callback(&_TKFX_motion_irq_callback);
 }
@@ -285,6 +385,7 @@ static void _TKFX_init_hw(void) {
 #endif
     // Init error stack
     ERROR_stack_init();
+    FAULT_init();
     // Init memory.
     NVIC_init();
     // Init power module and clock tree.
@@ -303,26 +404,99 @@ static void _TKFX_init_hw(void) {
     // High speed oscillator.
     rcc_status = RCC_switch_to_hsi();
     RCC_stack_error(ERROR_BASE_RCC);
+    CLOCK_init();
+#ifdef TKFX_PROFILER
+    PROFILER_init();
+#endif
+#ifdef TKFX_MARKERS
+    MARKER_init();
+#endif
     // Calibrate clocks.
     rcc_status = RCC_calibrate_internal_clocks(NVIC_PRIORITY_CLOCK_CALIBRATION);
     RCC_stack_error(ERROR_BASE_RCC);
     // Init RTC.
     rtc_status = RTC_init(&_TKFX_rtc_wakeup_timer_irq_callback, NVIC_PRIORITY_RTC);
     RTC_stack_error(ERROR_BASE_RTC);
+    TIMESTAMP_init();
+    TRACE_init(((RCC->CSR) >> 24) & 0xFF);
+    ACTIVITY_init(TKFX_STATE_NAME, (sizeof(TKFX_STATE_NAME) / sizeof(TKFX_STATE_NAME[0])), TIMESTAMP_get_milliseconds());
     // Init delay timer.
     LPTIM_init(NVIC_PRIORITY_DELAY);
     // Init components.
     POWER_init();
 }
 
+#ifndef TKFX_MODE_CLI
+/*******************************************************************/
+static int32_t _TKFX_get_temperature_band(int32_t temperature_degrees) {
+    // Floor division.
+    if (temperature_degrees >= 0) {
+        return (temperature_degrees / TKFX_CLOCK_CALIBRATION_BAND_DEGREES);
+    }
+    return (-(((-temperature_degrees) + TKFX_CLOCK_CALIBRATION_BAND_DEGREES - 1) / TKFX_CLOCK_CALIBRATION_BAND_DEGREES));
+}
+#endif
+
+#ifndef TKFX_MODE_CLI
+/*******************************************************************/
+static uint8_t _TKFX_is_temperature_band_left(int32_t temperature_degrees) {
+    // Local variables.
+    int32_t band_min_degrees = (tkfx_ctx.clock_calibration_band * TKFX_CLOCK_CALIBRATION_BAND_DEGREES);
+    int32_t band_max_degrees = (band_min_degrees + TKFX_CLOCK_CALIBRATION_BAND_DEGREES - 1);
+    // Band is left only beyond the hysteresis margin, so that a temperature oscillating around an edge does not trigger a calibration on each wake-up.
+    return (((temperature_degrees < (band_min_degrees - TKFX_CLOCK_CALIBRATION_MARGIN_DEGREES)) || (temperature_degrees > (band_max_degrees + TKFX_CLOCK_CALIBRATION_MARGIN_DEGREES))) ? 1 : 0);
+}
+#endif
+
+#ifndef TKFX_MODE_CLI
+/*******************************************************************/
+static void _TKFX_update_clock_calibration(void) {
+    // Local variables.
+    RCC_status_t rcc_status = RCC_SUCCESS;
+    uint32_t uptime_seconds = RTC_get_uptime_seconds();
+    int32_t band = tkfx_ctx.clock_calibration_band;
+    uint8_t calibration_required = 0;
+    // Check temperature band.
+    if (tkfx_ctx.tamb_last_valid != 0) {
+        if ((tkfx_ctx.clock_calibration_band_valid == 0) || (_TKFX_is_temperature_band_left(tkfx_ctx.tamb_last_degrees) != 0)) {
+            band = _TKFX_get_temperature_band(tkfx_ctx.tamb_last_degrees);
+            calibration_required = 1;
+        }
+    }
+    // Check staleness.
+    if (uptime_seconds >= (tkfx_ctx.clock_calibration_time_seconds + TKFX_CLOCK_CALIBRATION_MAX_AGE_SECONDS)) {
+        calibration_required = 1;
+    }
+    // Previous results stored in the RCC driver are kept if the oscillators did not drift.
+    if (calibration_required == 0) goto errors;
+    rcc_status = RCC_calibrate_internal_clocks(NVIC_PRIORITY_CLOCK_CALIBRATION);
+    RCC_stack_error(ERROR_BASE_RCC);
+    // Retry on next wake-up in case of failure.
+    if (rcc_status != RCC_SUCCESS) goto errors;
+    // Update cache.
+    tkfx_ctx.clock_calibration_time_seconds = uptime_seconds;
+    tkfx_ctx.clock_calibration_band = band;
+    tkfx_ctx.clock_calibration_band_valid = tkfx_ctx.tamb_last_valid;
+errors:
+    return;
+}
+#endif
+
 #ifndef TKFX_MODE_CLI
 /*******************************************************************/
 static void _TKFX_send_sigfox_message(SIGFOX_EP_API_application_message_t* application_message) {
     // Local variables.
     SIGFOX_EP_API_status_t sigfox_ep_api_status = SIGFOX_EP_API_SUCCESS;
     SIGFOX_EP_API_config_t lib_config;
+    CLOCK_status_t clock_status = CLOCK_SUCCESS;
     // Directly exit of the radio is disabled due to low storage element voltage.
-    if (tkfx_ctx.flags.radio_enabled == 0) goto errors;
+    if (tkfx_ctx.flags.radio_enabled == 0) {
+        TRACE_add(TRACE_EVENT_RADIO, (application_message -> ul_payload_size_bytes), TKFX_TRACE_RADIO_DISABLED);
+        goto errors;
+    }
+    // Radio requires high performance clock.
+    clock_status = CLOCK_set_profile(CLOCK_PROFILE_HIGH_PERFORMANCE);
+    CLOCK_stack_error(ERROR_BASE_CLOCK);
     // Disable motion interrupts.
     SENSORS_HW_disable_accelerometer_interrupt();
     // Library configuration.
@@ -335,6 +509,7 @@ static void _TKFX_send_sigfox_message(SIGFOX_EP_API_application_message_t* appli
         sigfox_ep_api_status = SIGFOX_EP_API_send_application_message(application_message);
         SIGFOX_EP_API_stack_error();
     }
+    TRACE_add(TRACE_EVENT_RADIO, (application_message -> ul_payload_size_bytes), (uint16_t) sigfox_ep_api_status);
     // Close library.
     sigfox_ep_api_status = SIGFOX_EP_API_close();
     SIGFOX_EP_API_stack_error();
@@ -348,6 +523,62 @@ errors:
 }
 #endif
 
+#if (!(defined TKFX_MODE_CLI) && (defined TKFX_DIAGNOSTICS_UPLINK))
+/*******************************************************************/
+static void _TKFX_build_diagnostics_frame(void) {
+    // Local variables.
+    ACTIVITY_statistics_t activity_statistics;
+    uint8_t histogram[ACTIVITY_HISTOGRAM_BINS_NUMBER];
+    uint32_t value = 0;
+    uint8_t idx = 0;
+    // Read statistics.
+    ACTIVITY_get_statistics(&activity_statistics);
+    // Awake time.
+    value = (activity_statistics.awake_time_ms / 1000);
+    tkfx_ctx.sigfox_fields.diagnostics.awake_time_seconds = (value > 0xFFFF) ? 0xFFFF : value;
+    // Wake duration distribution (any non-empty bin is reported).
+    for (idx = 0; idx < ACTIVITY_HISTOGRAM_BINS_NUMBER; idx++) {
+        histogram[idx] = 0;
+        if ((activity_statistics.wake_count != 0) && (activity_statistics.wake_histogram[idx] != 0)) {
+            value = ((activity_statistics.wake_histogram[idx] * TKFX_DIAGNOSTICS_HISTOGRAM_FULL_SCALE) / activity_statistics.wake_count);
+            histogram[idx] = (value == 0) ? 1 : ((uint8_t) value);
+        }
+    }
+    tkfx_ctx.sigfox_fields.diagnostics.wake_histogram_0 = histogram[0];
+    tkfx_ctx.sigfox_fields.diagnostics.wake_histogram_1 = histogram[1];
+    tkfx_ctx.sigfox_fields.diagnostics.wake_histogram_2 = histogram[2];
+    tkfx_ctx.sigfox_fields.diagnostics.wake_histogram_3 = histogram[3];
+    tkfx_ctx.sigfox_fields.diagnostics.wake_histogram_4 = histogram[4];
+    tkfx_ctx.sigfox_fields.diagnostics.wake_histogram_5 = histogram[5];
+    tkfx_ctx.sigfox_fields.diagnostics.wake_histogram_6 = histogram[6];
+    tkfx_ctx.sigfox_fields.diagnostics.wake_histogram_7 = histogram[7];
+    FRAME_pack(tkfx_ctx.sigfox_frame, TKFX_SIGFOX_DIAGNOSTICS_LAYOUT, sizeof(TKFX_SIGFOX_DIAGNOSTICS_LAYOUT), (const uint32_t*) &(tkfx_ctx.sigfox_fields.diagnostics));
+}
+#endif
+
+#if (!(defined TKFX_MODE_CLI) && (defined TKFX_GEOLOC_COMPACT))
+/*******************************************************************/
+static void _TKFX_build_geoloc_compact_frame(uint32_t fix_duration_seconds) {
+    // Local variables.
+    uint32_t units = 0;
+    uint8_t duration_class = 0;
+    // Latitude from south pole.
+    units = TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(tkfx_ctx.geoloc_position.lat_degrees, tkfx_ctx.geoloc_position.lat_minutes, tkfx_ctx.geoloc_position.lat_seconds);
+    units = (tkfx_ctx.geoloc_position.lat_north_flag != 0) ? ((TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_FULL_SCALE >> 1) + units) : ((TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_FULL_SCALE >> 1) - units);
+    tkfx_ctx.sigfox_fields.geoloc_compact.latitude_code = FRAME_quantize(units, TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_FULL_SCALE, TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_SIZE_BITS);
+    // Longitude from antimeridian, wrapped so that 180 degrees east and west both give code 0.
+    units = TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(tkfx_ctx.geoloc_position.long_degrees, tkfx_ctx.geoloc_position.long_minutes, tkfx_ctx.geoloc_position.long_seconds);
+    units = (tkfx_ctx.geoloc_position.long_east_flag != 0) ? ((TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_FULL_SCALE >> 1) + units) : ((TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_FULL_SCALE >> 1) - units);
+    tkfx_ctx.sigfox_fields.geoloc_compact.longitude_code = FRAME_quantize_wrap(units, TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_FULL_SCALE, TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_SIZE_BITS);
+    // Fix duration class (number of significant bits).
+    while ((duration_class < TKFX_GEOLOC_COMPACT_DURATION_CLASS_MAX) && ((fix_duration_seconds >> duration_class) != 0)) {
+        duration_class++;
+    }
+    tkfx_ctx.sigfox_fields.geoloc_compact.gps_fix_duration_class = duration_class;
+    FRAME_pack(tkfx_ctx.sigfox_frame, TKFX_SIGFOX_GEOLOC_COMPACT_LAYOUT, sizeof(TKFX_SIGFOX_GEOLOC_COMPACT_LAYOUT), (const uint32_t*) &(tkfx_ctx.sigfox_fields.geoloc_compact));
+}
+#endif
+
 #ifndef TKFX_MODE_CLI
 /*******************************************************************/
 int main(void) {
@@ -356,6 +587,7 @@ int main(void) {
     _TKFX_init_hw();
     // Local variables.
     RCC_status_t rcc_status = RCC_SUCCESS;
+    CLOCK_status_t clock_status = CLOCK_SUCCESS;
     POWER_status_t power_status = POWER_SUCCESS;
     ANALOG_status_t analog_status = ANALOG_SUCCESS;
     MATH_status_t math_status = MATH_SUCCESS;
@@ -363,14 +595,16 @@ int main(void) {
     MMA865XFC_status_t mma865xfc_status = MMA865XFC_SUCCESS;
     GPS_status_t gps_status = GPS_SUCCESS;
     GPS_acquisition_status_t gps_acquisition_status = GPS_ACQUISITION_SUCCESS;
+#ifdef TKFX_MONITORING_STACK_USAGE
+    RAM_statistics_t ram_statistics;
+#endif
     uint32_t geoloc_fix_duration_seconds = 0;
     SIGFOX_EP_API_application_message_t application_message;
-    ERROR_code_t error_code = 0;
-    uint8_t idx = 0;
     int32_t generic_s32_1 = 0;
     int32_t generic_s32_2 = 0;
     uint8_t generic_u8;
     uint32_t generic_u32 = 0;
+    TKFX_state_t previous_state = TKFX_STATE_LAST;
     // Application message default parameters.
     application_message.common_parameters.number_of_frames = 3;
     application_message.common_parameters.ul_bit_rate = SIGFOX_UL_BIT_RATE_100BPS;
@@ -382,20 +616,34 @@ int main(void) {
     application_message.ul_payload_size_bytes = 0;
     // Main loop.
     while (1) {
+        // Update time in state.
+        ACTIVITY_set_state(tkfx_ctx.state, TIMESTAMP_get_milliseconds());
+        MARKER_STATE(tkfx_ctx.state);
+        if (tkfx_ctx.state != previous_state) {
+            TRACE_add(TRACE_EVENT_STATE, (uint8_t) tkfx_ctx.state, 0);
+            previous_state = tkfx_ctx.state;
+        }
+        // Apply state clock profile.
+        if (tkfx_ctx.state < TKFX_STATE_LAST) {
+            clock_status = CLOCK_set_profile(TKFX_STATE_CLOCK_PROFILE[tkfx_ctx.state]);
+            CLOCK_stack_error(ERROR_BASE_CLOCK);
+        }
         // Perform state machine.
+        PROFILER_START(PROFILER_PROBE_STATE_MACHINE);
         switch (tkfx_ctx.state) {
         case TKFX_STATE_STARTUP:
             IWDG_reload();
             // Fill reset reason and software version.
-            tkfx_ctx.sigfox_startup_data.reset_reason = ((RCC->CSR) >> 24) & 0xFF;
-            tkfx_ctx.sigfox_startup_data.major_version = GIT_MAJOR_VERSION;
-            tkfx_ctx.sigfox_startup_data.minor_version = GIT_MINOR_VERSION;
-            tkfx_ctx.sigfox_startup_data.commit_index = GIT_COMMIT_INDEX;
-            tkfx_ctx.sigfox_startup_data.commit_id = GIT_COMMIT_ID;
-            tkfx_ctx.sigfox_startup_data.dirty_flag = GIT_DIRTY_FLAG;
+            tkfx_ctx.sigfox_fields.startup.reset_reason = ((RCC->CSR) >> 24) & 0xFF;
+            tkfx_ctx.sigfox_fields.startup.major_version = GIT_MAJOR_VERSION;
+            tkfx_ctx.sigfox_fields.startup.minor_version = GIT_MINOR_VERSION;
+            tkfx_ctx.sigfox_fields.startup.commit_index = GIT_COMMIT_INDEX;
+            tkfx_ctx.sigfox_fields.startup.commit_id = GIT_COMMIT_ID;
+            tkfx_ctx.sigfox_fields.startup.dirty_flag = GIT_DIRTY_FLAG;
+            FRAME_pack(tkfx_ctx.sigfox_frame, TKFX_SIGFOX_STARTUP_LAYOUT, sizeof(TKFX_SIGFOX_STARTUP_LAYOUT), (const uint32_t*) &(tkfx_ctx.sigfox_fields.startup));
             // Send SW version frame.
             application_message.common_parameters.ul_bit_rate = SIGFOX_UL_BIT_RATE_100BPS;
-            application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_startup_data.frame);
+            application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_frame);
             application_message.ul_payload_size_bytes = TKFX_SIGFOX_STARTUP_DATA_SIZE;
             _TKFX_send_sigfox_message(&application_message);
             // Compute next state.
@@ -403,9 +651,8 @@ int main(void) {
             break;
         case TKFX_STATE_WAKEUP:
             IWDG_reload();
-            // Calibrate clocks.
-            rcc_status = RCC_calibrate_internal_clocks(NVIC_PRIORITY_CLOCK_CALIBRATION);
-            RCC_stack_error(ERROR_BASE_RCC);
+            // Calibrate clocks if needed.
+            _TKFX_update_clock_calibration();
             // Reset GPS status for mode update.
             gps_acquisition_status = GPS_ACQUISITION_SUCCESS;
             // Compute next state.
@@ -416,13 +663,17 @@ int main(void) {
             // Get temperature from SHT30.
             power_status = POWER_enable(POWER_DOMAIN_SENSORS, LPTIM_DELAY_MODE_STOP);
             POWER_stack_error(ERROR_BASE_POWER);
-            sht3x_status = SHT3X_get_temperature_humidity(I2C_ADDRESS_SHT30, &generic_s32_1, &generic_s32_2);
+            sht3x_status = SHT3X_MEASUREMENT_single_shot(I2C_ADDRESS_SHT30, TKFX_SHT3X_REPEATABILITY, TKFX_SHT3X_CLOCK_STRETCHING, &generic_s32_1, &generic_s32_2);
             SHT3X_stack_error(ERROR_BASE_SHT30);
             power_status = POWER_disable(POWER_DOMAIN_SENSORS);
             POWER_stack_error(ERROR_BASE_POWER);
             // Reset data.
             tkfx_ctx.tamb_degrees = TKFX_ERROR_VALUE_TEMPERATURE;
             tkfx_ctx.hamb_percent = TKFX_ERROR_VALUE_HUMIDITY;
+            // Update temperature used for clocks calibration.
+            tkfx_ctx.tamb_last_valid = (sht3x_status == SHT3X_SUCCESS) ? 1 : 0;
+            tkfx_ctx.tamb_last_degrees = generic_s32_1;
+            _TKFX_update_clock_calibration();
             if (sht3x_status == SHT3X_SUCCESS) {
                 // Convert temperature.
                 math_status = MATH_integer_to_signed_magnitude(generic_s32_1, (MATH_U8_SIZE_BITS - 1), &generic_u32);
@@ -475,14 +726,19 @@ int main(void) {
             RCC_stack_error(ERROR_BASE_RCC);
             tkfx_ctx.status.lse_status = (generic_u8 == 0) ? 0b0 : 0b1;
             // Build Sigfox frame.
-            tkfx_ctx.sigfox_monitoring_data.tamb_degrees = tkfx_ctx.tamb_degrees;
-            tkfx_ctx.sigfox_monitoring_data.hamb_degrees = tkfx_ctx.hamb_percent;
-            tkfx_ctx.sigfox_monitoring_data.vsrc_mv = tkfx_ctx.vsrc_mv;
-            tkfx_ctx.sigfox_monitoring_data.vstr_mv = tkfx_ctx.vstr_mv;
-            tkfx_ctx.sigfox_monitoring_data.status = tkfx_ctx.status.all;
+            tkfx_ctx.sigfox_fields.monitoring.tamb_degrees = tkfx_ctx.tamb_degrees;
+            tkfx_ctx.sigfox_fields.monitoring.hamb_degrees = tkfx_ctx.hamb_percent;
+            tkfx_ctx.sigfox_fields.monitoring.vsrc_mv = tkfx_ctx.vsrc_mv;
+            tkfx_ctx.sigfox_fields.monitoring.vstr_mv = tkfx_ctx.vstr_mv;
+            tkfx_ctx.sigfox_fields.monitoring.status = tkfx_ctx.status.all;
+#ifdef TKFX_MONITORING_STACK_USAGE
+            RAM_get_statistics(&ram_statistics);
+            tkfx_ctx.sigfox_fields.monitoring.stack_high_water_mark_bytes = (ram_statistics.stack_overflow_flag == 0) ? ram_statistics.stack_high_water_mark_bytes : 0xFFFF;
+#endif
+            FRAME_pack(tkfx_ctx.sigfox_frame, TKFX_SIGFOX_MONITORING_LAYOUT, sizeof(TKFX_SIGFOX_MONITORING_LAYOUT), (const uint32_t*) &(tkfx_ctx.sigfox_fields.monitoring));
             // Send uplink monitoring frame.
             application_message.common_parameters.ul_bit_rate = (tkfx_ctx.status.alarm_flag == 0) ? SIGFOX_UL_BIT_RATE_600BPS : SIGFOX_UL_BIT_RATE_100BPS;
-            application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_monitoring_data.frame);
+            application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_frame);
             application_message.ul_payload_size_bytes = TKFX_SIGFOX_MONITORING_DATA_SIZE;
             _TKFX_send_sigfox_message(&application_message);
             // Reset flag and timer.
@@ -499,23 +755,35 @@ int main(void) {
             if (RTC_get_uptime_seconds() >= tkfx_ctx.error_stack_next_time_seconds) {
                 // Import Sigfox library error stack.
                 ERROR_import_sigfox_stack();
-                // Check stack.
-                if (ERROR_stack_is_empty() == 0) {
-                    // Read error stack.
-                    for (idx = 0; idx < (TKFX_SIGFOX_ERROR_STACK_DATA_SIZE >> 1); idx++) {
-                        error_code = ERROR_stack_read();
-                        tkfx_ctx.sigfox_error_stack_data[(idx << 1) + 0] = (uint8_t) ((error_code >> 8) & 0x00FF);
-                        tkfx_ctx.sigfox_error_stack_data[(idx << 1) + 1] = (uint8_t) ((error_code >> 0) & 0x00FF);
-                    }
+                FAULT_collect(RTC_get_uptime_seconds());
+                // Check aggregated errors.
+                if (FAULT_get_entries_number() != 0) {
+                    // Encode deduplicated codes and occurrence counts.
+                    FAULT_encode(tkfx_ctx.sigfox_frame, TKFX_SIGFOX_ERROR_STACK_DATA_SIZE);
                     // Update next time.
                     tkfx_ctx.error_stack_next_time_seconds = RTC_get_uptime_seconds() + TKFX_ERROR_STACK_PERIOD_SECONDS;
                     // Send error stack frame.
                     application_message.common_parameters.ul_bit_rate = SIGFOX_UL_BIT_RATE_100BPS;
-                    application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_error_stack_data);
+                    application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_frame);
                     application_message.ul_payload_size_bytes = TKFX_SIGFOX_ERROR_STACK_DATA_SIZE;
                     _TKFX_send_sigfox_message(&application_message);
                 }
             }
+#ifdef TKFX_DIAGNOSTICS_UPLINK
+            // Daily activity diagnostics.
+            if (RTC_get_uptime_seconds() >= tkfx_ctx.diagnostics_next_time_seconds) {
+                // Update next time.
+                tkfx_ctx.diagnostics_next_time_seconds = RTC_get_uptime_seconds() + TKFX_DIAGNOSTICS_PERIOD_SECONDS;
+                // Send diagnostics frame.
+                _TKFX_build_diagnostics_frame();
+                application_message.common_parameters.ul_bit_rate = SIGFOX_UL_BIT_RATE_100BPS;
+                application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_frame);
+                application_message.ul_payload_size_bytes = TKFX_SIGFOX_DIAGNOSTICS_DATA_SIZE;
+                _TKFX_send_sigfox_message(&application_message);
+                // Start a new period.
+                ACTIVITY_reset();
+            }
+#endif
             // Compute next state.
             tkfx_ctx.state = (tkfx_ctx.flags.geoloc_request != 0) ? TKFX_STATE_GEOLOC : TKFX_STATE_MODE_UPDATE;
             break;
@@ -548,6 +816,7 @@ int main(void) {
             else {
                 gps_acquisition_status = GPS_ACQUISITION_ERROR_VSTR_THRESHOLD;
             }
+            TRACE_add(TRACE_EVENT_GPS, (uint8_t) gps_acquisition_status, (uint16_t) geoloc_fix_duration_seconds);
             // Compute bit rate according to tracker motion state.
 #ifdef TKFX_MODE_HIKING
             application_message.common_parameters.ul_bit_rate = SIGFOX_UL_BIT_RATE_100BPS;
@@ -556,25 +825,34 @@ int main(void) {
 #endif
             // Build Sigfox frame.
             if (gps_acquisition_status == GPS_ACQUISITION_SUCCESS) {
-                tkfx_ctx.sigfox_geoloc_data.latitude_degrees = tkfx_ctx.geoloc_position.lat_degrees;
-                tkfx_ctx.sigfox_geoloc_data.latitude_minutes = tkfx_ctx.geoloc_position.lat_minutes;
-                tkfx_ctx.sigfox_geoloc_data.latitude_seconds = tkfx_ctx.geoloc_position.lat_seconds;
-                tkfx_ctx.sigfox_geoloc_data.latitude_north_flag = tkfx_ctx.geoloc_position.lat_north_flag;
-                tkfx_ctx.sigfox_geoloc_data.longitude_degrees = tkfx_ctx.geoloc_position.long_degrees;
-                tkfx_ctx.sigfox_geoloc_data.longitude_minutes = tkfx_ctx.geoloc_position.long_minutes;
-                tkfx_ctx.sigfox_geoloc_data.longitude_seconds = tkfx_ctx.geoloc_position.long_seconds;
-                tkfx_ctx.sigfox_geoloc_data.longitude_east_flag = tkfx_ctx.geoloc_position.long_east_flag;
-                tkfx_ctx.sigfox_geoloc_data.altitude_meters = tkfx_ctx.geoloc_position.altitude;
-                tkfx_ctx.sigfox_geoloc_data.gps_fix_duration_seconds = geoloc_fix_duration_seconds;
+#ifdef TKFX_GEOLOC_COMPACT
+                _TKFX_build_geoloc_compact_frame(geoloc_fix_duration_seconds);
                 // Update message parameters.
-                application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_geoloc_data.frame);
+                application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_frame);
+                application_message.ul_payload_size_bytes = TKFX_SIGFOX_GEOLOC_COMPACT_DATA_SIZE;
+#else
+                tkfx_ctx.sigfox_fields.geoloc.latitude_degrees = tkfx_ctx.geoloc_position.lat_degrees;
+                tkfx_ctx.sigfox_fields.geoloc.latitude_minutes = tkfx_ctx.geoloc_position.lat_minutes;
+                tkfx_ctx.sigfox_fields.geoloc.latitude_seconds = tkfx_ctx.geoloc_position.lat_seconds;
+                tkfx_ctx.sigfox_fields.geoloc.latitude_north_flag = tkfx_ctx.geoloc_position.lat_north_flag;
+                tkfx_ctx.sigfox_fields.geoloc.longitude_degrees = tkfx_ctx.geoloc_position.long_degrees;
+                tkfx_ctx.sigfox_fields.geoloc.longitude_minutes = tkfx_ctx.geoloc_position.long_minutes;
+                tkfx_ctx.sigfox_fields.geoloc.longitude_seconds = tkfx_ctx.geoloc_position.long_seconds;
+                tkfx_ctx.sigfox_fields.geoloc.longitude_east_flag = tkfx_ctx.geoloc_position.long_east_flag;
+                tkfx_ctx.sigfox_fields.geoloc.altitude_meters = tkfx_ctx.geoloc_position.altitude;
+                tkfx_ctx.sigfox_fields.geoloc.gps_fix_duration_seconds = geoloc_fix_duration_seconds;
+                FRAME_pack(tkfx_ctx.sigfox_frame, TKFX_SIGFOX_GEOLOC_LAYOUT, sizeof(TKFX_SIGFOX_GEOLOC_LAYOUT), (const uint32_t*) &(tkfx_ctx.sigfox_fields.geoloc));
+                // Update message parameters.
+                application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_frame);
                 application_message.ul_payload_size_bytes = TKFX_SIGFOX_GEOLOC_DATA_SIZE;
+#endif
             }
             else {
-                tkfx_ctx.sigfox_geoloc_timeout_data.gps_acquisition_status = gps_acquisition_status;
-                tkfx_ctx.sigfox_geoloc_timeout_data.gps_acquisition_duration_seconds = geoloc_fix_duration_seconds;
+                tkfx_ctx.sigfox_fields.geoloc_timeout.gps_acquisition_status = gps_acquisition_status;
+                tkfx_ctx.sigfox_fields.geoloc_timeout.gps_acquisition_duration_seconds = geoloc_fix_duration_seconds;
+                FRAME_pack(tkfx_ctx.sigfox_frame, TKFX_SIGFOX_GEOLOC_TIMEOUT_LAYOUT, sizeof(TKFX_SIGFOX_GEOLOC_TIMEOUT_LAYOUT), (const uint32_t*) &(tkfx_ctx.sigfox_fields.geoloc_timeout));
                 // Update message parameters.
-                application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_geoloc_timeout_data.frame);
+                application_message.ul_payload = (sfx_u8*) (tkfx_ctx.sigfox_frame);
                 application_message.ul_payload_size_bytes = TKFX_SIGFOX_GEOLOC_TIMEOUT_DATA_SIZE;
             }
             // Send uplink geolocation frame.
@@ -602,7 +880,7 @@ int main(void) {
                 // Active mode.
                 power_status = POWER_enable(POWER_DOMAIN_SENSORS, LPTIM_DELAY_MODE_STOP);
                 POWER_stack_error(ERROR_BASE_POWER);
-                mma865xfc_status = MMA865XFC_write_configuration(I2C_ADDRESS_MMA8653FC, &(MMA865XFC_ACTIVE_CONFIGURATION[0]), MMA865XFC_ACTIVE_CONFIGURATION_SIZE);
+                mma865xfc_status = MMA865XFC_CONFIGURATION_write(I2C_ADDRESS_MMA8653FC, TKFX_CONFIG.accelerometer_configuration, MMA865XFC_ACTIVE_CONFIGURATION_SIZE);
                 MMA865XFC_stack_error(ERROR_BASE_MMA8653FC);
                 power_status = POWER_disable(POWER_DOMAIN_SENSORS);
                 POWER_stack_error(ERROR_BASE_POWER);
@@ -615,7 +893,7 @@ int main(void) {
                 // Sleep mode.
                 power_status = POWER_enable(POWER_DOMAIN_SENSORS, LPTIM_DELAY_MODE_STOP);
                 POWER_stack_error(ERROR_BASE_POWER);
-                mma865xfc_status = MMA865XFC_write_configuration(I2C_ADDRESS_MMA8653FC, &(MMA865XFC_SLEEP_CONFIGURATION[0]), MMA865XFC_SLEEP_CONFIGURATION_SIZE);
+                mma865xfc_status = MMA865XFC_CONFIGURATION_write(I2C_ADDRESS_MMA8653FC, &(MMA865XFC_SLEEP_CONFIGURATION[0]), MMA865XFC_SLEEP_CONFIGURATION_SIZE);
                 MMA865XFC_stack_error(ERROR_BASE_MMA8653FC);
                 power_status = POWER_disable(POWER_DOMAIN_SENSORS);
                 POWER_stack_error(ERROR_BASE_POWER);
@@ -643,15 +921,21 @@ int main(void) {
             IWDG_reload();
             // Clear POR flag.
             tkfx_ctx.flags.por = 0;
-            // Reset IRQ count.
-            tkfx_ctx.start_detection_irq_count = 0;
+            // Aggregate errors of the wake cycle before the stack fills.
+            FAULT_collect(RTC_get_uptime_seconds());
+            // Reset start detector.
+            MOTION_reset();
             // Enter sleep mode.
             tkfx_ctx.state = TKFX_STATE_SLEEP;
             break;
         case TKFX_STATE_SLEEP:
             // Enter stop mode.
             IWDG_reload();
+            ACTIVITY_stop(TIMESTAMP_get_milliseconds());
+            TIMESTAMP_enter_low_power();
             PWR_enter_stop_mode();
+            TIMESTAMP_exit_low_power();
+            ACTIVITY_wake_up(TIMESTAMP_get_milliseconds());
             IWDG_reload();
             // Periodic monitoring.
             if (RTC_get_uptime_seconds() >= tkfx_ctx.monitoring_next_time_seconds) {
@@ -680,7 +964,7 @@ int main(void) {
                 }
             }
             // Start detection.
-            if ((tkfx_ctx.status.moving_flag == 0) && (tkfx_ctx.start_detection_irq_count > TKFX_CONFIG.start_detection_threshold_irq) && (tkfx_ctx.mode == TKFX_MODE_ACTIVE)) {
+            if ((tkfx_ctx.status.moving_flag == 0) && (MOTION_is_start_detected(TIMESTAMP_get_milliseconds()) != 0) && (tkfx_ctx.mode == TKFX_MODE_ACTIVE)) {
                 // Update requests.
                 tkfx_ctx.flags.monitoring_request = 1;
                 // Update status.
@@ -714,6 +998,7 @@ int main(void) {
             tkfx_ctx.state = TKFX_STATE_OFF;
             break;
         }
+        PROFILER_STOP(PROFILER_PROBE_STATE_MACHINE);
     }
     return 0;
 }
@@ -731,7 +1016,7 @@ int main(void) {
     // Configure accelerometer.
     power_status = POWER_enable(POWER_DOMAIN_SENSORS, LPTIM_DELAY_MODE_STOP);
     POWER_stack_error(ERROR_BASE_POWER);
-    mma865xfc_status = MMA865XFC_write_configuration(I2C_ADDRESS_MMA8653FC, &(MMA865XFC_ACTIVE_CONFIGURATION[0]), MMA865XFC_ACTIVE_CONFIGURATION_SIZE);
+    mma865xfc_status = MMA865XFC_CONFIGURATION_write(I2C_ADDRESS_MMA8653FC, &(MMA865XFC_ACTIVE_CONFIGURATION[0]), MMA865XFC_ACTIVE_CONFIGURATION_SIZE);
     MMA865XFC_stack_error(ERROR_BASE_MMA8653FC);
     power_status = POWER_disable(POWER_DOMAIN_SENSORS);
     POWER_stack_error(ERROR_BASE_POWER);
@@ -742,7 +1027,11 @@ int main(void) {
     while (1) {
         // Enter sleep mode.
         IWDG_reload();
+        ACTIVITY_stop(TIMESTAMP_get_milliseconds());
+        TIMESTAMP_enter_low_power();
         PWR_enter_sleep_mode();
+        TIMESTAMP_exit_low_power();
+        ACTIVITY_wake_up(TIMESTAMP_get_milliseconds());
         IWDG_reload();
         // Process command line interface.
         cli_status = CLI_process();
@@ -9,15 +9,87 @@
 #define __MMA865XFC_CONFIGURATION_REG_H__
 
 #include "mma865xfc.h"
+#include "types.h"
 
 /*** MMA865XFC CONFIGURATION  macros ***/
 
-#define MMA865XFC_ACTIVE_CONFIGURATION_SIZE     10
+#define MMA865XFC_ACTIVE_CONFIGURATION_SIZE     11
 #define MMA865XFC_SLEEP_CONFIGURATION_SIZE      3
 
+// Output data rates (CTRL_REG1 DR field).
+#define MMA865XFC_CONFIGURATION_DR_800HZ        0b000
+#define MMA865XFC_CONFIGURATION_DR_400HZ        0b001
+#define MMA865XFC_CONFIGURATION_DR_200HZ        0b010
+#define MMA865XFC_CONFIGURATION_DR_100HZ        0b011
+#define MMA865XFC_CONFIGURATION_DR_50HZ         0b100
+#define MMA865XFC_CONFIGURATION_DR_12HZ5        0b101
+#define MMA865XFC_CONFIGURATION_DR_6HZ25        0b110
+#define MMA865XFC_CONFIGURATION_DR_1HZ56        0b111
+// Auto-sleep output data rates (CTRL_REG1 ASLP_RATE field).
+#define MMA865XFC_CONFIGURATION_ASLP_RATE_50HZ  0b00
+#define MMA865XFC_CONFIGURATION_ASLP_RATE_12HZ5 0b01
+#define MMA865XFC_CONFIGURATION_ASLP_RATE_6HZ25 0b10
+#define MMA865XFC_CONFIGURATION_ASLP_RATE_1HZ56 0b11
+// Oversampling modes (CTRL_REG2 MODS and SMODS fields).
+#define MMA865XFC_CONFIGURATION_MODS_NORMAL     0b00
+#define MMA865XFC_CONFIGURATION_MODS_LNLP       0b01
+#define MMA865XFC_CONFIGURATION_MODS_HR         0b10
+#define MMA865XFC_CONFIGURATION_MODS_LP         0b11
+// Auto-sleep counter step (320ms for all wake data rates except 1.56Hz).
+#define MMA865XFC_CONFIGURATION_ASLP_COUNT_STEP_MS(dr)  (((dr) == MMA865XFC_CONFIGURATION_DR_1HZ56) ? 640 : 320)
+
+// Output data rate of each DR code in mHz.
+#define MMA865XFC_CONFIGURATION_DR_ODR_MHZ(dr)  (((dr) < MMA865XFC_CONFIGURATION_DR_12HZ5) ? (800000 >> (dr)) : (((dr) == MMA865XFC_CONFIGURATION_DR_12HZ5) ? 12500 : (((dr) == MMA865XFC_CONFIGURATION_DR_6HZ25) ? 6250 : 1563)))
+
+// Register values generation.
+#define MMA865XFC_CONFIGURATION_CTRL_REG1(aslp_rate, dr, active)    ((uint8_t) (((aslp_rate) << 6) | ((dr) << 3) | (active)))
+#define MMA865XFC_CONFIGURATION_CTRL_REG2(rst, smods, slpe, mods)   ((uint8_t) (((rst) << 6) | ((smods) << 3) | ((slpe) << 2) | (mods)))
+#define MMA865XFC_CONFIGURATION_ASLP_COUNT(delay_ms, dr)            ((uint8_t) ((((delay_ms) / MMA865XFC_CONFIGURATION_ASLP_COUNT_STEP_MS(dr)) > 255) ? 255 : ((delay_ms) / MMA865XFC_CONFIGURATION_ASLP_COUNT_STEP_MS(dr))))
+
+// Active configuration table initializer, for a const table of MMA865XFC_ACTIVE_CONFIGURATION_SIZE settings.
+// Wake data rate and oversampling when moving, sleep data rate and oversampling when inactive, auto-sleep enable and inactivity delay.
+#define MMA865XFC_CONFIGURATION_ACTIVE(dr, mods, aslp_rate, smods, slpe, aslp_delay_ms) { \
+    /* Settings are sorted by address (after standby request) to allow auto-increment transfers. */ \
+    {MMA865XFC_REGISTER_CTRL_REG1, 0x00}, /* ACTIVE='0' (standby mode required to program registers). */ \
+    {MMA865XFC_REGISTER_XYZ_DATA_CFG, 0x00}, /* Full scale = +/-2g. */ \
+    {MMA865XFC_REGISTER_FF_MT_CFG, 0x78}, /* OAE='1' (motion detection). ELE='0' (latch disabled, bit automatically cleared). XEFE=YEFE=ZEFE='1' (any direction enabled). */ \
+    {MMA865XFC_REGISTER_FF_MT_THS, 0x91}, /* DBCNTM='1' and threshold value (1.071g). */ \
+    {MMA865XFC_REGISTER_FF_MT_COUNT, 0x00}, /* Debouncing counter not used. */ \
+    {MMA865XFC_REGISTER_ASLP_COUNT, MMA865XFC_CONFIGURATION_ASLP_COUNT(aslp_delay_ms, dr)}, /* Inactivity delay before switching to sleep data rate. */ \
+    {MMA865XFC_REGISTER_CTRL_REG2, MMA865XFC_CONFIGURATION_CTRL_REG2(0, smods, slpe, mods)}, /* (S)MODS and SLPE (auto sleep enable). */ \
+    {MMA865XFC_REGISTER_CTRL_REG3, 0x0A}, /* WAKE_FF_MT='1' (motion interrupt wakes the sensor) and IPOL='1' (interrupt pin active high). */ \
+    {MMA865XFC_REGISTER_CTRL_REG4, 0x04}, /* INT_EN_FF_MT='1' (motion interrupt enabled). */ \
+    {MMA865XFC_REGISTER_CTRL_REG5, 0x04}, /* INT_CFG_FF_MT='1' (motion interrupt on INT1 pin). */ \
+    {MMA865XFC_REGISTER_CTRL_REG1, MMA865XFC_CONFIGURATION_CTRL_REG1(aslp_rate, dr, 1)} /* ASLP_RATE, DR and ACTIVE='1'. */ \
+}
+
 /*** MMA865XFC CONFIGURATION global variables ***/
 
+// Default active configuration (1.56Hz low power without auto-sleep).
 extern const MMA865XFC_register_setting_t MMA865XFC_ACTIVE_CONFIGURATION[MMA865XFC_ACTIVE_CONFIGURATION_SIZE];
 extern const MMA865XFC_register_setting_t MMA865XFC_SLEEP_CONFIGURATION[MMA865XFC_SLEEP_CONFIGURATION_SIZE];
 
+/*** MMA865XFC CONFIGURATION functions ***/
+
+/*!******************************************************************
+ * \fn MMA865XFC_status_t MMA865XFC_CONFIGURATION_write(uint8_t i2c_address, const MMA865XFC_register_setting_t* configuration, uint8_t configuration_size)
+ * \brief Write a configuration table to the accelerometer.
+ * \brief Registers already holding the requested value are skipped and consecutive registers are written in a single auto-increment transfer.
+ * \param[in]   i2c_address: Accelerometer I2C address.
+ * \param[in]   configuration: Pointer to the registers settings table.
+ * \param[in]   configuration_size: Number of settings in the table.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+MMA865XFC_status_t MMA865XFC_CONFIGURATION_write(uint8_t i2c_address, const MMA865XFC_register_setting_t* configuration, uint8_t configuration_size);
+
+/*!******************************************************************
+ * \fn void MMA865XFC_CONFIGURATION_invalidate(void)
+ * \brief Invalidate registers shadow (to be called when the accelerometer is reset or powered down).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void MMA865XFC_CONFIGURATION_invalidate(void);
+
 #endif /* __MMA865XFC_CONFIGURATION_REG_H__ */
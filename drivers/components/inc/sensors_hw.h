@@ -16,7 +16,7 @@
 
 /*!******************************************************************
  * \fn ERROR_t SENSORS_HW_init(void)
- * \brief Init common sensors hardware interface.
+ * \brief Init common sensors hardware interface (the I2C bus is initialized by the first caller only).
  * \param[in]   i2c_error_base: Specific I2C error base of the sensor.
  * \param[out]  none
  * \retval      Function execution status.
@@ -25,7 +25,7 @@ ERROR_code_t SENSORS_HW_init(ERROR_code_t i2c_error_base);
 
 /*!******************************************************************
  * \fn ERROR_t SENSORS_HW_de_init(void)
- * \brief Release common sensors hardware interface.
+ * \brief Release common sensors hardware interface (the I2C bus is released by the last caller only).
  * \param[in]   i2c_error_base: Specific I2C error base of the sensor.
  * \param[out]  none
  * \retval      Function execution status.
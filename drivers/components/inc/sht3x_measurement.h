@@ -0,0 +1,112 @@
+/*
+ * sht3x_measurement.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SHT3X_MEASUREMENT_H__
+#define __SHT3X_MEASUREMENT_H__
+
+#include "sht3x.h"
+#include "types.h"
+
+/*** SHT3X MEASUREMENT macros ***/
+
+// Measurement errors, appended to the driver errors range (below SHT3X_ERROR_BASE_I2C).
+#define SHT3X_ERROR_REPEATABILITY   ((SHT3X_status_t) (SHT3X_ERROR_CRC + 1))
+#define SHT3X_ERROR_RATE            ((SHT3X_status_t) (SHT3X_ERROR_CRC + 2))
+
+/*** SHT3X MEASUREMENT structures ***/
+
+/*!******************************************************************
+ * \enum SHT3X_MEASUREMENT_repeatability_t
+ * \brief SHT3x measurement repeatability.
+ *******************************************************************/
+typedef enum {
+    SHT3X_MEASUREMENT_REPEATABILITY_LOW = 0,
+    SHT3X_MEASUREMENT_REPEATABILITY_MEDIUM,
+    SHT3X_MEASUREMENT_REPEATABILITY_HIGH,
+    SHT3X_MEASUREMENT_REPEATABILITY_LAST
+} SHT3X_MEASUREMENT_repeatability_t;
+
+/*!******************************************************************
+ * \enum SHT3X_MEASUREMENT_rate_t
+ * \brief SHT3x periodic mode measurement rates.
+ *******************************************************************/
+typedef enum {
+    SHT3X_MEASUREMENT_RATE_0_5_MPS = 0,
+    SHT3X_MEASUREMENT_RATE_1_MPS,
+    SHT3X_MEASUREMENT_RATE_2_MPS,
+    SHT3X_MEASUREMENT_RATE_4_MPS,
+    SHT3X_MEASUREMENT_RATE_10_MPS,
+    SHT3X_MEASUREMENT_RATE_LAST
+} SHT3X_MEASUREMENT_rate_t;
+
+/*** SHT3X MEASUREMENT functions ***/
+
+/*!******************************************************************
+ * \fn void SHT3X_HW_set_command(uint16_t command, uint8_t stop_flag, uint32_t delay_ms)
+ * \brief Redirect the measurement transaction of the next SHT3X_get_temperature_humidity() calls (implemented in sht3x_hw.c).
+ * \details The driver command write and conversion delay are replaced, so that the driver CRC check and conversion are reused for all measurement modes.
+ * \param[in]   command: Command sent instead of the driver one.
+ * \param[in]   stop_flag: Generate stop condition after the command if non zero (repeated start otherwise).
+ * \param[in]   delay_ms: Delay between the command and the read (0 to skip the delay).
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SHT3X_HW_set_command(uint16_t command, uint8_t stop_flag, uint32_t delay_ms);
+
+/*!******************************************************************
+ * \fn void SHT3X_HW_clear_command(void)
+ * \brief Restore the driver measurement transaction.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SHT3X_HW_clear_command(void);
+
+/*!******************************************************************
+ * \fn SHT3X_status_t SHT3X_MEASUREMENT_single_shot(uint8_t i2c_address, SHT3X_MEASUREMENT_repeatability_t repeatability, uint8_t clock_stretching_enable, int32_t* temperature_degrees, int32_t* humidity_percent)
+ * \brief Perform a single shot temperature and humidity measurement.
+ * \brief With clock stretching, the sensor holds the bus until the conversion is done so that no blind delay is required.
+ * \param[in]   i2c_address: Sensor I2C address.
+ * \param[in]   repeatability: Measurement repeatability.
+ * \param[in]   clock_stretching_enable: Use clock stretching read if non zero, wait for the maximum conversion time otherwise.
+ * \param[out]  temperature_degrees: Pointer to integer that will contain the temperature in degrees.
+ * \param[out]  humidity_percent: Pointer to integer that will contain the relative humidity in percent.
+ * \retval      Function execution status.
+ *******************************************************************/
+SHT3X_status_t SHT3X_MEASUREMENT_single_shot(uint8_t i2c_address, SHT3X_MEASUREMENT_repeatability_t repeatability, uint8_t clock_stretching_enable, int32_t* temperature_degrees, int32_t* humidity_percent);
+
+/*!******************************************************************
+ * \fn SHT3X_status_t SHT3X_MEASUREMENT_start_periodic(uint8_t i2c_address, SHT3X_MEASUREMENT_repeatability_t repeatability, SHT3X_MEASUREMENT_rate_t rate)
+ * \brief Start periodic measurements with heater disabled (sensors power domain must stay enabled).
+ * \param[in]   i2c_address: Sensor I2C address.
+ * \param[in]   repeatability: Measurement repeatability.
+ * \param[in]   rate: Number of measurements per second.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SHT3X_status_t SHT3X_MEASUREMENT_start_periodic(uint8_t i2c_address, SHT3X_MEASUREMENT_repeatability_t repeatability, SHT3X_MEASUREMENT_rate_t rate);
+
+/*!******************************************************************
+ * \fn SHT3X_status_t SHT3X_MEASUREMENT_fetch_periodic(uint8_t i2c_address, int32_t* temperature_degrees, int32_t* humidity_percent)
+ * \brief Read the last periodic measurement result.
+ * \param[in]   i2c_address: Sensor I2C address.
+ * \param[out]  temperature_degrees: Pointer to integer that will contain the temperature in degrees.
+ * \param[out]  humidity_percent: Pointer to integer that will contain the relative humidity in percent.
+ * \retval      Function execution status.
+ *******************************************************************/
+SHT3X_status_t SHT3X_MEASUREMENT_fetch_periodic(uint8_t i2c_address, int32_t* temperature_degrees, int32_t* humidity_percent);
+
+/*!******************************************************************
+ * \fn SHT3X_status_t SHT3X_MEASUREMENT_stop_periodic(uint8_t i2c_address)
+ * \brief Stop periodic measurements and go back to single shot mode.
+ * \param[in]   i2c_address: Sensor I2C address.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SHT3X_status_t SHT3X_MEASUREMENT_stop_periodic(uint8_t i2c_address);
+
+#endif /* __SHT3X_MEASUREMENT_H__ */
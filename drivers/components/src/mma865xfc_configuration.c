@@ -8,24 +8,125 @@
 #include "mma865xfc_configuration.h"
 
 #include "mma865xfc.h"
+#include "mma865xfc_hw.h"
+#include "types.h"
+
+/*** MMA865XFC CONFIGURATION local macros ***/
+
+#define MMA865XFC_CONFIGURATION_SHADOW_SIZE             0x32
+#define MMA865XFC_CONFIGURATION_TRANSFER_BUFFER_SIZE    (MMA865XFC_ACTIVE_CONFIGURATION_SIZE + 1)
+
+#define MMA865XFC_CONFIGURATION_CTRL_REG2_RST           (0b1 << 6)
+
+/*** MMA865XFC CONFIGURATION local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint8_t value[MMA865XFC_CONFIGURATION_SHADOW_SIZE];
+    uint8_t valid[(MMA865XFC_CONFIGURATION_SHADOW_SIZE + 7) / 8];
+} MMA865XFC_CONFIGURATION_shadow_t;
 
 /*** MMA865XFC CONFIGURATION global variables ***/
 
-const MMA865XFC_register_setting_t MMA865XFC_ACTIVE_CONFIGURATION[MMA865XFC_ACTIVE_CONFIGURATION_SIZE] = {
-    {MMA865XFC_REGISTER_CTRL_REG1, 0x00}, // ACTIVE='0' (standby mode required to program registers).
-    {MMA865XFC_REGISTER_XYZ_DATA_CFG, 0x00}, // Full scale = +/-2g.
-    {MMA865XFC_REGISTER_CTRL_REG2, 0x1B}, // (S)MODS='11' (low power operation) and SLPE='0' (Auto sleep disabled).
-    {MMA865XFC_REGISTER_CTRL_REG3, 0x0A}, // WAKE_FF_MT='1' (motion interrupt wakes the sensor) and IPOL='1' (interrupt pin active high).
-    {MMA865XFC_REGISTER_FF_MT_CFG, 0x78}, // OAE='1' (motion detection). ELE='0' (latch disabled, bit automatically cleared). XEFE=YEFE=ZEFE='1' (any direction enabled).
-    {MMA865XFC_REGISTER_FF_MT_THS, 0x91}, // DBCNTM='1' and threshold value (1.071g).
-    {MMA865XFC_REGISTER_FF_MT_COUNT, 0x00}, // Debouncing counter not used.
-    {MMA865XFC_REGISTER_CTRL_REG5, 0x04}, // INT_CFG_FF_MT='1' (motion interrupt on INT1 pin).
-    {MMA865XFC_REGISTER_CTRL_REG4, 0x04}, // INT_EN_FF_MT='1' (motion interrupt enabled).
-    {MMA865XFC_REGISTER_CTRL_REG1, 0x39} // DR='111' (1Hz) and ACTIVE='1'.
-};
+const MMA865XFC_register_setting_t MMA865XFC_ACTIVE_CONFIGURATION[MMA865XFC_ACTIVE_CONFIGURATION_SIZE] = MMA865XFC_CONFIGURATION_ACTIVE(MMA865XFC_CONFIGURATION_DR_1HZ56, MMA865XFC_CONFIGURATION_MODS_LP, MMA865XFC_CONFIGURATION_ASLP_RATE_1HZ56, MMA865XFC_CONFIGURATION_MODS_LP, 0, 0);
 
 const MMA865XFC_register_setting_t MMA865XFC_SLEEP_CONFIGURATION[MMA865XFC_SLEEP_CONFIGURATION_SIZE] = {
     {MMA865XFC_REGISTER_CTRL_REG2, 0x5B}, // RESET='1'.
     {MMA865XFC_REGISTER_CTRL_REG2, 0x1B}, // RESET='0', (S)MODS='11' (low power operation) and SLPE='0' (auto sleep disabled).
     {MMA865XFC_REGISTER_CTRL_REG3, 0x02}, // IPOL='1' (interrupt pin active high).
 };
+
+/*** MMA865XFC CONFIGURATION local global variables ***/
+
+static MMA865XFC_CONFIGURATION_shadow_t mma865xfc_configuration_shadow;
+
+/*** MMA865XFC CONFIGURATION local functions ***/
+
+/*******************************************************************/
+static uint8_t _MMA865XFC_CONFIGURATION_is_write_required(const MMA865XFC_register_setting_t* setting) {
+    // Local variables.
+    uint8_t addr = (setting -> addr);
+    // Unknown registers are always written.
+    if (addr >= MMA865XFC_CONFIGURATION_SHADOW_SIZE) return 1;
+    if ((mma865xfc_configuration_shadow.valid[addr >> 3] & (0b1 << (addr & 0x07))) == 0) return 1;
+    return ((mma865xfc_configuration_shadow.value[addr] != (setting -> value)) ? 1 : 0);
+}
+
+/*******************************************************************/
+static void _MMA865XFC_CONFIGURATION_update_shadow(const MMA865XFC_register_setting_t* setting) {
+    // Local variables.
+    uint8_t addr = (setting -> addr);
+    // Software reset clears all registers.
+    if ((addr == MMA865XFC_REGISTER_CTRL_REG2) && (((setting -> value) & MMA865XFC_CONFIGURATION_CTRL_REG2_RST) != 0)) {
+        MMA865XFC_CONFIGURATION_invalidate();
+        return;
+    }
+    if (addr >= MMA865XFC_CONFIGURATION_SHADOW_SIZE) return;
+    mma865xfc_configuration_shadow.value[addr] = (setting -> value);
+    mma865xfc_configuration_shadow.valid[addr >> 3] |= (0b1 << (addr & 0x07));
+}
+
+/*** MMA865XFC CONFIGURATION functions ***/
+
+/*******************************************************************/
+MMA865XFC_status_t MMA865XFC_CONFIGURATION_write(uint8_t i2c_address, const MMA865XFC_register_setting_t* configuration, uint8_t configuration_size) {
+    // Local variables.
+    MMA865XFC_status_t status = MMA865XFC_SUCCESS;
+    uint8_t transfer_buffer[MMA865XFC_CONFIGURATION_TRANSFER_BUFFER_SIZE];
+    uint8_t idx = 0;
+    uint8_t run_start = 0;
+    uint8_t run_end = 0;
+    uint8_t run_last_required = 0;
+    // Check parameters.
+    if (configuration == NULL) {
+        status = MMA865XFC_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    while (idx < configuration_size) {
+        // Skip settings already applied.
+        if (_MMA865XFC_CONFIGURATION_is_write_required(&(configuration[idx])) == 0) {
+            idx++;
+            continue;
+        }
+        // Extend run while registers addresses are consecutive (auto-increment).
+        run_start = idx;
+        run_end = idx;
+        run_last_required = idx;
+        while (((run_end + 1) < configuration_size) && ((run_end - run_start + 2) < MMA865XFC_CONFIGURATION_TRANSFER_BUFFER_SIZE) && (configuration[run_end + 1].addr == (configuration[run_end].addr + 1))) {
+            run_end++;
+            if (_MMA865XFC_CONFIGURATION_is_write_required(&(configuration[run_end])) != 0) {
+                run_last_required = run_end;
+            }
+        }
+        // Do not send trailing settings already applied.
+        run_end = run_last_required;
+        // Build and send transfer.
+        transfer_buffer[0] = configuration[run_start].addr;
+        for (idx = run_start; idx <= run_end; idx++) {
+            transfer_buffer[idx - run_start + 1] = configuration[idx].value;
+        }
+        status = MMA865XFC_HW_i2c_write(i2c_address, transfer_buffer, (uint8_t) (run_end - run_start + 2), 1);
+        if (status != MMA865XFC_SUCCESS) {
+            // Registers state is unknown.
+            MMA865XFC_CONFIGURATION_invalidate();
+            goto errors;
+        }
+        // Update shadow.
+        for (idx = run_start; idx <= run_end; idx++) {
+            _MMA865XFC_CONFIGURATION_update_shadow(&(configuration[idx]));
+        }
+        idx = (run_end + 1);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void MMA865XFC_CONFIGURATION_invalidate(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Reset valid flags.
+    for (idx = 0; idx < sizeof(mma865xfc_configuration_shadow.valid); idx++) {
+        mma865xfc_configuration_shadow.valid[idx] = 0;
+    }
+}
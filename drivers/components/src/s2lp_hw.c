@@ -14,6 +14,7 @@
 #include "gpio.h"
 #include "gpio_mapping.h"
 #include "lptim.h"
+#include "ramfunc.h"
 #include "s2lp.h"
 #include "spi.h"
 #include "types.h"
@@ -64,7 +65,7 @@ errors:
 }
 
 /*******************************************************************/
-S2LP_status_t S2LP_HW_spi_write_read_8(uint8_t* tx_data, uint8_t* rx_data, uint8_t transfer_size) {
+S2LP_status_t RAMFUNC S2LP_HW_spi_write_read_8(uint8_t* tx_data, uint8_t* rx_data, uint8_t transfer_size) {
     // Local variables.
     S2LP_status_t status = S2LP_SUCCESS;
     SPI_status_t spi_status = SPI_SUCCESS;
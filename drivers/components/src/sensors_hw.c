@@ -7,22 +7,180 @@
 
 #include "sensors_hw.h"
 
+#include "dma_reg.h"
 #include "error.h"
 #include "error_base.h"
 #include "exti.h"
 #include "gpio_mapping.h"
 #include "i2c.h"
+#include "i2c_reg.h"
 #include "lptim.h"
+#include "nvic.h"
 #include "nvic_priority.h"
+#include "pwr.h"
+#include "ramfunc.h"
+#include "rcc.h"
+#include "rcc_reg.h"
+#include "tkfx_flags.h"
 #include "types.h"
 
 /*** SENSORS HW local macros ***/
 
-#define SENSORS_I2C_INSTANCE    I2C_INSTANCE_I2C1
+#define SENSORS_I2C_INSTANCE                    I2C_INSTANCE_I2C1
+
+// Fast mode timings for a 16MHz kernel clock (I2C1 is clocked by PCLK1 = SYSCLK = HSI16), standard mode timings of the I2C driver are kept on any other clock.
+#define SENSORS_HW_I2C_TIMINGR_FAST_MODE        0x0010061A
+#define SENSORS_HW_I2C_FAST_MODE_CLOCK_HZ       16000000
+// Bus timeout (SCL low or clock stretching) in 2048 clock cycles steps: (195 + 1) * 128us = 25ms.
+#define SENSORS_HW_I2C_TIMEOUTR                 ((0b1 << 15) | 195)
+
+#define SENSORS_HW_I2C_CR1_PE                   (0b1 << 0)
+#define SENSORS_HW_I2C_CR1_IRQ_MASK             ((0b1 << 4) | (0b1 << 5) | (0b1 << 6) | (0b1 << 7))
+#define SENSORS_HW_I2C_CR1_TXDMAEN              (0b1 << 14)
+#define SENSORS_HW_I2C_CR1_RXDMAEN              (0b1 << 15)
+#define SENSORS_HW_I2C_CR2_RD_WRN               (0b1 << 10)
+#define SENSORS_HW_I2C_CR2_START                (0b1 << 13)
+#define SENSORS_HW_I2C_CR2_AUTOEND              (0b1 << 25)
+#define SENSORS_HW_I2C_ISR_NACKF                (0b1 << 4)
+#define SENSORS_HW_I2C_ISR_STOPF                (0b1 << 5)
+#define SENSORS_HW_I2C_ISR_TC                   (0b1 << 6)
+#define SENSORS_HW_I2C_ISR_ERROR_MASK           ((0b1 << 8) | (0b1 << 9) | (0b1 << 10) | (0b1 << 12))
+#define SENSORS_HW_I2C_ISR_BUSY                 (0b1 << 15)
+#define SENSORS_HW_I2C_ICR_ALL                  0x00003F38
+
+// DMA1 channel 2 (I2C1_TX) and channel 3 (I2C1_RX).
+#define SENSORS_HW_DMA_CSELR_C2S_C3S_MASK       ((0b1111 << 4) | (0b1111 << 8))
+#define SENSORS_HW_DMA_CSELR_C2S_C3S_I2C1       ((0b0110 << 4) | (0b0110 << 8))
+#define SENSORS_HW_DMA_IFCR_CGIF2               (0b1111 << 4)
+#define SENSORS_HW_DMA_IFCR_CGIF3               (0b1111 << 8)
+#define SENSORS_HW_DMA_CCR_EN                   (0b1 << 0)
+#define SENSORS_HW_DMA_CCR_DIR_MEMORY_TO_PERIPH (0b1 << 4)
+#define SENSORS_HW_DMA_CCR_MINC                 (0b1 << 7)
+#define SENSORS_HW_RCC_AHBENR_DMAEN             (0b1 << 0)
+
+/*** SENSORS HW local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    EXTI_gpio_irq_cb_t accelerometer_irq_callback;
+    uint8_t accelerometer_exti_configured;
+    uint8_t i2c_reference_count;
+#ifdef TKFX_SENSORS_I2C_DMA
+    volatile uint8_t i2c_transfer_end_flag;
+#endif
+} SENSORS_HW_context_t;
 
 /*** SENSORS HW local global variables ***/
 
-static EXTI_gpio_irq_cb_t sensors_hw_accelerometer_irq_callback = NULL;
+static SENSORS_HW_context_t sensors_hw_ctx = {
+    .accelerometer_irq_callback = NULL,
+    .accelerometer_exti_configured = 0,
+    .i2c_reference_count = 0,
+#ifdef TKFX_SENSORS_I2C_DMA
+    .i2c_transfer_end_flag = 0
+#endif
+};
+
+/*** SENSORS HW local functions ***/
+
+#ifdef TKFX_SENSORS_I2C_DMA
+/*******************************************************************/
+void RAMFUNC I2C1_IRQHandler(void) {
+    // Mask interrupts until next transfer (TC and STOPF flags are cleared by software).
+    I2C1 -> CR1 &= ~(SENSORS_HW_I2C_CR1_IRQ_MASK);
+    sensors_hw_ctx.i2c_transfer_end_flag = 1;
+}
+#endif
+
+#if ((defined TKFX_SENSORS_I2C_FAST_MODE) || (defined TKFX_SENSORS_I2C_DMA))
+/*******************************************************************/
+static void _SENSORS_HW_configure_i2c(void) {
+#ifdef TKFX_SENSORS_I2C_FAST_MODE
+    // Local variables.
+    uint32_t sysclk_hz = 0;
+#endif
+    // Peripheral must be disabled to update timings.
+    I2C1 -> CR1 &= ~(SENSORS_HW_I2C_CR1_PE);
+#ifdef TKFX_SENSORS_I2C_FAST_MODE
+    if ((RCC_get_frequency_hz(RCC_CLOCK_SYSTEM, &sysclk_hz) == RCC_SUCCESS) && (sysclk_hz == SENSORS_HW_I2C_FAST_MODE_CLOCK_HZ)) {
+        I2C1 -> TIMINGR = SENSORS_HW_I2C_TIMINGR_FAST_MODE;
+    }
+#endif
+#ifdef TKFX_SENSORS_I2C_DMA
+    I2C1 -> TIMEOUTR = SENSORS_HW_I2C_TIMEOUTR;
+    I2C1 -> CR1 |= (SENSORS_HW_I2C_CR1_TXDMAEN | SENSORS_HW_I2C_CR1_RXDMAEN);
+    // Enable DMA clock and map I2C1 requests.
+    RCC -> AHBENR |= SENSORS_HW_RCC_AHBENR_DMAEN;
+    DMA1 -> CSELR &= ~(SENSORS_HW_DMA_CSELR_C2S_C3S_MASK);
+    DMA1 -> CSELR |= SENSORS_HW_DMA_CSELR_C2S_C3S_I2C1;
+    DMA1 -> CPAR2 = ((uint32_t) &(I2C1 -> TXDR));
+    DMA1 -> CPAR3 = ((uint32_t) &(I2C1 -> RXDR));
+    NVIC_enable_interrupt(NVIC_INTERRUPT_I2C1, NVIC_PRIORITY_SENSORS_I2C);
+#endif
+    I2C1 -> CR1 |= SENSORS_HW_I2C_CR1_PE;
+}
+#endif
+
+#ifdef TKFX_SENSORS_I2C_DMA
+/*******************************************************************/
+static I2C_status_t _SENSORS_HW_dma_transfer(uint8_t i2c_address, uint8_t* data, uint8_t data_size_bytes, uint8_t read_flag, uint8_t stop_flag) {
+    // Local variables.
+    I2C_status_t status = I2C_SUCCESS;
+    uint32_t isr = 0;
+    uint32_t primask = 0;
+    // Check parameters.
+    if (data == NULL) {
+        status = I2C_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Check bus (except for repeated start).
+    if (((I2C1 -> ISR) & (SENSORS_HW_I2C_ISR_BUSY | SENSORS_HW_I2C_ISR_TC)) == SENSORS_HW_I2C_ISR_BUSY) {
+        status = I2C_ERROR_BUSY;
+        goto errors;
+    }
+    // Configure DMA channel.
+    if (read_flag != 0) {
+        DMA1 -> CCR3 = 0;
+        DMA1 -> IFCR = SENSORS_HW_DMA_IFCR_CGIF3;
+        DMA1 -> CMAR3 = ((uint32_t) data);
+        DMA1 -> CNDTR3 = data_size_bytes;
+        DMA1 -> CCR3 = (SENSORS_HW_DMA_CCR_MINC | SENSORS_HW_DMA_CCR_EN);
+    }
+    else {
+        DMA1 -> CCR2 = 0;
+        DMA1 -> IFCR = SENSORS_HW_DMA_IFCR_CGIF2;
+        DMA1 -> CMAR2 = ((uint32_t) data);
+        DMA1 -> CNDTR2 = data_size_bytes;
+        DMA1 -> CCR2 = (SENSORS_HW_DMA_CCR_MINC | SENSORS_HW_DMA_CCR_DIR_MEMORY_TO_PERIPH | SENSORS_HW_DMA_CCR_EN);
+    }
+    // Clear flags and enable transfer end interrupts.
+    I2C1 -> ICR = SENSORS_HW_I2C_ICR_ALL;
+    sensors_hw_ctx.i2c_transfer_end_flag = 0;
+    I2C1 -> CR1 |= SENSORS_HW_I2C_CR1_IRQ_MASK;
+    // Start transfer.
+    I2C1 -> CR2 = ((((uint32_t) i2c_address) << 1) | (((uint32_t) data_size_bytes) << 16) | ((read_flag != 0) ? SENSORS_HW_I2C_CR2_RD_WRN : 0) | ((stop_flag != 0) ? SENSORS_HW_I2C_CR2_AUTOEND : 0) | SENSORS_HW_I2C_CR2_START);
+    // Sleep until transfer complete, stop, NACK or error.
+    // The flag is checked with interrupts masked: an interrupt occurring after the check stays pending and wakes the WFI up.
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) : : "memory");
+    while (sensors_hw_ctx.i2c_transfer_end_flag == 0) {
+        PWR_enter_sleep_mode();
+        // Let the pending interrupt be serviced.
+        __asm volatile ("cpsie i\n cpsid i" : : : "memory");
+    }
+    __asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+    isr = (I2C1 -> ISR);
+    if ((isr & (SENSORS_HW_I2C_ISR_NACKF | SENSORS_HW_I2C_ISR_ERROR_MASK)) != 0) {
+        status = I2C_ERROR_TRANSFER_COMPLETE;
+    }
+    // Disable DMA channels.
+    DMA1 -> CCR2 = 0;
+    DMA1 -> CCR3 = 0;
+    // Clear flags.
+    I2C1 -> ICR = SENSORS_HW_I2C_ICR_ALL;
+errors:
+    return status;
+}
+#endif
 
 /*** SENSORS HW functions ***/
 
@@ -31,11 +189,20 @@ ERROR_code_t SENSORS_HW_init(ERROR_code_t i2c_error_base) {
     // Local variables.
     ERROR_code_t status = SUCCESS;
     I2C_status_t i2c_status = I2C_SUCCESS;
-    // Init I2C.
-    i2c_status = I2C_init(SENSORS_I2C_INSTANCE, &GPIO_SENSORS_I2C);
-    I2C_exit_error(i2c_error_base);
-    // Configure accelerometer interrupt pin.
-    EXTI_configure_gpio(&GPIO_ACCELERO_IRQ, GPIO_PULL_NONE, EXTI_TRIGGER_RISING_EDGE, sensors_hw_accelerometer_irq_callback, NVIC_PRIORITY_ACCELEROMETER);
+    // Init I2C only for the first sensor of the power domain session.
+    if (sensors_hw_ctx.i2c_reference_count == 0) {
+        i2c_status = I2C_init(SENSORS_I2C_INSTANCE, &GPIO_SENSORS_I2C);
+        I2C_exit_error(i2c_error_base);
+#if ((defined TKFX_SENSORS_I2C_FAST_MODE) || (defined TKFX_SENSORS_I2C_DMA))
+        _SENSORS_HW_configure_i2c();
+#endif
+    }
+    sensors_hw_ctx.i2c_reference_count++;
+    // Configure accelerometer interrupt pin once.
+    if (sensors_hw_ctx.accelerometer_exti_configured == 0) {
+        EXTI_configure_gpio(&GPIO_ACCELERO_IRQ, GPIO_PULL_NONE, EXTI_TRIGGER_RISING_EDGE, sensors_hw_ctx.accelerometer_irq_callback, NVIC_PRIORITY_ACCELEROMETER);
+        sensors_hw_ctx.accelerometer_exti_configured = 1;
+    }
 errors:
     return status;
 }
@@ -45,11 +212,18 @@ ERROR_code_t SENSORS_HW_de_init(ERROR_code_t i2c_error_base) {
     // Local variables.
     ERROR_code_t status = SUCCESS;
     I2C_status_t i2c_status = I2C_SUCCESS;
-    // Init I2C.
-    i2c_status = I2C_de_init(SENSORS_I2C_INSTANCE, &GPIO_SENSORS_I2C);
-    I2C_exit_error(i2c_error_base);
-    // Release accelerometer interrupt pin.
-    EXTI_release_gpio(&GPIO_ACCELERO_IRQ, GPIO_MODE_INPUT);
+    // Check bus state.
+    if (sensors_hw_ctx.i2c_reference_count == 0) goto errors;
+    sensors_hw_ctx.i2c_reference_count--;
+    // Release I2C when the last sensor of the power domain session is released.
+    if (sensors_hw_ctx.i2c_reference_count == 0) {
+#ifdef TKFX_SENSORS_I2C_DMA
+        NVIC_disable_interrupt(NVIC_INTERRUPT_I2C1);
+#endif
+        i2c_status = I2C_de_init(SENSORS_I2C_INSTANCE, &GPIO_SENSORS_I2C);
+        I2C_exit_error(i2c_error_base);
+    }
+    // Note: accelerometer interrupt pin configuration is kept since the pin is an input in both cases.
 errors:
     return status;
 }
@@ -60,7 +234,11 @@ ERROR_code_t SENSORS_HW_i2c_write(ERROR_code_t i2c_error_base, uint8_t i2c_addre
     ERROR_code_t status = SUCCESS;
     I2C_status_t i2c_status = I2C_SUCCESS;
     // I2C transfer.
+#ifdef TKFX_SENSORS_I2C_DMA
+    i2c_status = _SENSORS_HW_dma_transfer(i2c_address, data, data_size_bytes, 0, stop_flag);
+#else
     i2c_status = I2C_write(SENSORS_I2C_INSTANCE, i2c_address, data, data_size_bytes, stop_flag);
+#endif
     I2C_exit_error(i2c_error_base);
 errors:
     return status;
@@ -72,7 +250,11 @@ ERROR_code_t SENSORS_HW_i2c_read(ERROR_code_t i2c_error_base, uint8_t i2c_addres
     ERROR_code_t status = SUCCESS;
     I2C_status_t i2c_status = I2C_SUCCESS;
     // I2C transfer.
+#ifdef TKFX_SENSORS_I2C_DMA
+    i2c_status = _SENSORS_HW_dma_transfer(i2c_address, data, data_size_bytes, 1, 1);
+#else
     i2c_status = I2C_read(SENSORS_I2C_INSTANCE, i2c_address, data, data_size_bytes);
+#endif
     I2C_exit_error(i2c_error_base);
 errors:
     return status;
@@ -93,7 +275,9 @@ errors:
 /*******************************************************************/
 void SENSORS_HW_set_accelerometer_irq_callback(EXTI_gpio_irq_cb_t accelerometer_irq_callback) {
     // Update local pointer.
-    sensors_hw_accelerometer_irq_callback = accelerometer_irq_callback;
+    sensors_hw_ctx.accelerometer_irq_callback = accelerometer_irq_callback;
+    // Force EXTI configuration update on next init.
+    sensors_hw_ctx.accelerometer_exti_configured = 0;
 }
 
 /*******************************************************************/
@@ -8,11 +8,51 @@
 #include "sht3x_hw.h"
 
 #include "sensors_hw.h"
+#include "sht3x_measurement.h"
+#include "types.h"
 
 #ifndef SHT3X_DRIVER_DISABLE
 
+/*** SHT3X HW local macros ***/
+
+#define SHT3X_HW_COMMAND_SIZE_BYTES     2
+
+/*** SHT3X HW local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint8_t enable;
+    uint8_t command[SHT3X_HW_COMMAND_SIZE_BYTES];
+    uint8_t stop_flag;
+    uint32_t delay_ms;
+} SHT3X_HW_context_t;
+
+/*** SHT3X HW local global variables ***/
+
+static SHT3X_HW_context_t sht3x_hw_ctx = {
+    .enable = 0,
+    .command = { 0x00, 0x00 },
+    .stop_flag = 1,
+    .delay_ms = 0
+};
+
 /*** SHT3X HW functions ***/
 
+/*******************************************************************/
+void SHT3X_HW_set_command(uint16_t command, uint8_t stop_flag, uint32_t delay_ms) {
+    // Big endian command.
+    sht3x_hw_ctx.command[0] = (uint8_t) ((command >> 8) & 0xFF);
+    sht3x_hw_ctx.command[1] = (uint8_t) ((command >> 0) & 0xFF);
+    sht3x_hw_ctx.stop_flag = stop_flag;
+    sht3x_hw_ctx.delay_ms = delay_ms;
+    sht3x_hw_ctx.enable = 1;
+}
+
+/*******************************************************************/
+void SHT3X_HW_clear_command(void) {
+    sht3x_hw_ctx.enable = 0;
+}
+
 /*******************************************************************/
 SHT3X_status_t SHT3X_HW_init(void) {
     return ((SHT3X_status_t) SENSORS_HW_init(SHT3X_ERROR_BASE_I2C));
@@ -25,6 +65,10 @@ SHT3X_status_t SHT3X_HW_de_init(void) {
 
 /*******************************************************************/
 SHT3X_status_t SHT3X_HW_i2c_write(uint8_t i2c_address, uint8_t* data, uint8_t data_size_bytes, uint8_t stop_flag) {
+    // Replace the driver measurement command if required.
+    if ((sht3x_hw_ctx.enable != 0) && (data_size_bytes == SHT3X_HW_COMMAND_SIZE_BYTES)) {
+        return ((SHT3X_status_t) SENSORS_HW_i2c_write(SHT3X_ERROR_BASE_I2C, i2c_address, sht3x_hw_ctx.command, SHT3X_HW_COMMAND_SIZE_BYTES, sht3x_hw_ctx.stop_flag));
+    }
     return ((SHT3X_status_t) SENSORS_HW_i2c_write(SHT3X_ERROR_BASE_I2C, i2c_address, data, data_size_bytes, stop_flag));
 }
 
@@ -35,6 +79,11 @@ SHT3X_status_t SHT3X_HW_i2c_read(uint8_t i2c_address, uint8_t* data, uint8_t dat
 
 /*******************************************************************/
 SHT3X_status_t SHT3X_HW_delay_milliseconds(uint32_t delay_ms) {
+    // Replace the driver conversion delay if required.
+    if (sht3x_hw_ctx.enable != 0) {
+        if (sht3x_hw_ctx.delay_ms == 0) return SHT3X_SUCCESS;
+        delay_ms = sht3x_hw_ctx.delay_ms;
+    }
     return ((SHT3X_status_t) SENSORS_HW_delay_milliseconds(SHT3X_ERROR_BASE_DELAY, delay_ms));
 }
 
@@ -0,0 +1,133 @@
+/*
+ * sht3x_measurement.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "sht3x_measurement.h"
+
+#include "sht3x.h"
+#include "sht3x_hw.h"
+#include "types.h"
+
+/*** SHT3X MEASUREMENT local macros ***/
+
+#define SHT3X_MEASUREMENT_COMMAND_FETCH_DATA        0xE000
+#define SHT3X_MEASUREMENT_COMMAND_BREAK             0x3093
+#define SHT3X_MEASUREMENT_COMMAND_HEATER_DISABLE    0x3066
+
+#define SHT3X_MEASUREMENT_BREAK_DELAY_MS            1
+
+/*** SHT3X MEASUREMENT local global variables ***/
+
+// Single shot commands indexed by repeatability (clock stretching disabled, then enabled).
+static const uint16_t SHT3X_MEASUREMENT_COMMAND_SINGLE_SHOT[2][SHT3X_MEASUREMENT_REPEATABILITY_LAST] = {
+    { 0x2416, 0x240B, 0x2400 },
+    { 0x2C10, 0x2C0D, 0x2C06 }
+};
+// Maximum conversion time indexed by repeatability (datasheet).
+static const uint8_t SHT3X_MEASUREMENT_DURATION_MS[SHT3X_MEASUREMENT_REPEATABILITY_LAST] = { 5, 7, 16 };
+// Periodic commands indexed by rate and repeatability.
+static const uint16_t SHT3X_MEASUREMENT_COMMAND_PERIODIC[SHT3X_MEASUREMENT_RATE_LAST][SHT3X_MEASUREMENT_REPEATABILITY_LAST] = {
+    { 0x202F, 0x2024, 0x2032 },
+    { 0x212D, 0x2126, 0x2130 },
+    { 0x222B, 0x2220, 0x2236 },
+    { 0x2329, 0x2322, 0x2334 },
+    { 0x272A, 0x2721, 0x2737 }
+};
+
+/*** SHT3X MEASUREMENT local functions ***/
+
+/*******************************************************************/
+static SHT3X_status_t _SHT3X_MEASUREMENT_send_command(uint8_t i2c_address, uint16_t command, uint8_t stop_flag) {
+    // Local variables.
+    uint8_t command_bytes[2];
+    // Big endian command.
+    command_bytes[0] = (uint8_t) ((command >> 8) & 0xFF);
+    command_bytes[1] = (uint8_t) ((command >> 0) & 0xFF);
+    return SHT3X_HW_i2c_write(i2c_address, command_bytes, 2, stop_flag);
+}
+
+/*******************************************************************/
+static SHT3X_status_t _SHT3X_MEASUREMENT_read(uint8_t i2c_address, uint16_t command, uint8_t stop_flag, uint32_t delay_ms, int32_t* temperature_degrees, int32_t* humidity_percent) {
+    // Local variables.
+    SHT3X_status_t status = SHT3X_SUCCESS;
+    // Redirect the driver transaction, CRC check and conversion are performed by the driver.
+    SHT3X_HW_set_command(command, stop_flag, delay_ms);
+    status = SHT3X_get_temperature_humidity(i2c_address, temperature_degrees, humidity_percent);
+    SHT3X_HW_clear_command();
+    return status;
+}
+
+/*** SHT3X MEASUREMENT functions ***/
+
+/*******************************************************************/
+SHT3X_status_t SHT3X_MEASUREMENT_single_shot(uint8_t i2c_address, SHT3X_MEASUREMENT_repeatability_t repeatability, uint8_t clock_stretching_enable, int32_t* temperature_degrees, int32_t* humidity_percent) {
+    // Local variables.
+    SHT3X_status_t status = SHT3X_SUCCESS;
+    uint8_t stretching_idx = (clock_stretching_enable != 0) ? 1 : 0;
+    // Check parameters.
+    if ((temperature_degrees == NULL) || (humidity_percent == NULL)) {
+        status = SHT3X_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (repeatability >= SHT3X_MEASUREMENT_REPEATABILITY_LAST) {
+        status = SHT3X_ERROR_REPEATABILITY;
+        goto errors;
+    }
+    // Without clock stretching, wait for the maximum conversion time.
+    // Otherwise the sensor stretches SCL during the read until the conversion is complete.
+    status = _SHT3X_MEASUREMENT_read(i2c_address, SHT3X_MEASUREMENT_COMMAND_SINGLE_SHOT[stretching_idx][repeatability], 1, ((clock_stretching_enable == 0) ? SHT3X_MEASUREMENT_DURATION_MS[repeatability] : 0), temperature_degrees, humidity_percent);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SHT3X_status_t SHT3X_MEASUREMENT_start_periodic(uint8_t i2c_address, SHT3X_MEASUREMENT_repeatability_t repeatability, SHT3X_MEASUREMENT_rate_t rate) {
+    // Local variables.
+    SHT3X_status_t status = SHT3X_SUCCESS;
+    // Check parameters.
+    if (repeatability >= SHT3X_MEASUREMENT_REPEATABILITY_LAST) {
+        status = SHT3X_ERROR_REPEATABILITY;
+        goto errors;
+    }
+    if (rate >= SHT3X_MEASUREMENT_RATE_LAST) {
+        status = SHT3X_ERROR_RATE;
+        goto errors;
+    }
+    // Make sure heater is off.
+    status = _SHT3X_MEASUREMENT_send_command(i2c_address, SHT3X_MEASUREMENT_COMMAND_HEATER_DISABLE, 1);
+    if (status != SHT3X_SUCCESS) goto errors;
+    // Start periodic mode.
+    status = _SHT3X_MEASUREMENT_send_command(i2c_address, SHT3X_MEASUREMENT_COMMAND_PERIODIC[rate][repeatability], 1);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SHT3X_status_t SHT3X_MEASUREMENT_fetch_periodic(uint8_t i2c_address, int32_t* temperature_degrees, int32_t* humidity_percent) {
+    // Local variables.
+    SHT3X_status_t status = SHT3X_SUCCESS;
+    // Check parameters.
+    if ((temperature_degrees == NULL) || (humidity_percent == NULL)) {
+        status = SHT3X_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Fetch last result with a repeated start (NACK if no new data is available).
+    status = _SHT3X_MEASUREMENT_read(i2c_address, SHT3X_MEASUREMENT_COMMAND_FETCH_DATA, 0, 0, temperature_degrees, humidity_percent);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SHT3X_status_t SHT3X_MEASUREMENT_stop_periodic(uint8_t i2c_address) {
+    // Local variables.
+    SHT3X_status_t status = SHT3X_SUCCESS;
+    // Send break command.
+    status = _SHT3X_MEASUREMENT_send_command(i2c_address, SHT3X_MEASUREMENT_COMMAND_BREAK, 1);
+    if (status != SHT3X_SUCCESS) goto errors;
+    status = SHT3X_HW_delay_milliseconds(SHT3X_MEASUREMENT_BREAK_DELAY_MS);
+errors:
+    return status;
+}
@@ -22,11 +22,15 @@ typedef enum {
     NVIC_PRIORITY_GPS_UART = 0,
     // Accelerometer.
     NVIC_PRIORITY_ACCELEROMETER = 0,
+    // Sensors bus.
+    NVIC_PRIORITY_SENSORS_I2C = 1,
     // Sigfox.
     NVIC_PRIORITY_SIGFOX_RADIO_IRQ_GPIO = 0,
     NVIC_PRIORITY_SIGFOX_TIMER = 1,
     // AT interface.
-    NVIC_PRIORITY_CLI = 3
+    NVIC_PRIORITY_CLI = 3,
+    // Profiler time base.
+    NVIC_PRIORITY_PROFILER = 3
 } NVIC_priority_list_t;
 
 #endif /* __NVIC_PRIORITY_H__ */
@@ -18,6 +18,7 @@ typedef enum {
     NVM_ADDRESS_SIGFOX_EP_ID = 0,
     NVM_ADDRESS_SIGFOX_EP_KEY = (NVM_ADDRESS_SIGFOX_EP_ID + SIGFOX_EP_ID_SIZE_BYTES),
     NVM_ADDRESS_SIGFOX_EP_LIB_DATA = (NVM_ADDRESS_SIGFOX_EP_KEY + SIGFOX_EP_KEY_SIZE_BYTES),
+    NVM_ADDRESS_CLI_MACRO = (NVM_ADDRESS_SIGFOX_EP_LIB_DATA + SIGFOX_NVM_DATA_SIZE_BYTES),
 } NVM_address_mapping_t;
 
 #endif /* __NVM_ADDRESS_H__ */
@@ -10,7 +10,8 @@
 
 /*** STM32L0XX DRIVERS compilation flags ***/
 
-#define STM32L0XX_DRIVERS_DMA_CHANNEL_MASK              0x00
+// DMA1 channels 2 and 3 are directly driven by the sensors bus (sensors_hw.c), channel 4 (terminal_hw.c) goes through the DMA driver.
+#define STM32L0XX_DRIVERS_DMA_CHANNEL_MASK              0x08
 
 #ifdef HW1_0
 #define STM32L0XX_DRIVERS_EXTI_GPIO_MASK                0x1002
@@ -0,0 +1,42 @@
+/*
+ * terminal_hw_config.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TERMINAL_HW_CONFIG_H__
+#define __TERMINAL_HW_CONFIG_H__
+
+#include "types.h"
+
+/*** TERMINAL HW CONFIG macros ***/
+
+#define TERMINAL_HW_BAUD_RATE_DEFAULT       9600
+#define TERMINAL_HW_BAUD_RATE_MIN           9600
+#define TERMINAL_HW_BAUD_RATE_MAX           460800
+
+// Size of each of the two DMA transmission buffers.
+#define TERMINAL_HW_TX_BUFFER_SIZE          128
+
+/*** TERMINAL HW CONFIG functions ***/
+
+/*!******************************************************************
+ * \fn void TERMINAL_HW_set_baud_rate(uint32_t baud_rate)
+ * \brief Set terminal baud rate (applied at next terminal initialization).
+ * \param[in]   baud_rate: Baud rate, between TERMINAL_HW_BAUD_RATE_MIN and TERMINAL_HW_BAUD_RATE_MAX.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TERMINAL_HW_set_baud_rate(uint32_t baud_rate);
+
+/*!******************************************************************
+ * \fn uint32_t TERMINAL_HW_get_baud_rate(void)
+ * \brief Get terminal baud rate.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Current baud rate.
+ *******************************************************************/
+uint32_t TERMINAL_HW_get_baud_rate(void);
+
+#endif /* __TERMINAL_HW_CONFIG_H__ */
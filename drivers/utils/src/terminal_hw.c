@@ -10,33 +10,150 @@
 #ifndef EMBEDDED_UTILS_DISABLE_FLAGS_FILE
 #include "embedded_utils_flags.h"
 #endif
+#include "dma.h"
 #include "error.h"
+#include "error_base.h"
 #include "gpio_mapping.h"
 #include "nvic_priority.h"
+#include "terminal_hw_config.h"
+#include "timestamp.h"
 #include "types.h"
 #include "usart.h"
+#include "usart_reg.h"
 
 #if (!(defined EMBEDDED_UTILS_TERMINAL_DRIVER_DISABLE) && (EMBEDDED_UTILS_TERMINAL_INSTANCES_NUMBER > 0))
 
+/*** TERMINAL HW local macros ***/
+
 #define TERMINAL_HW_USART_INSTANCE      USART_INSTANCE_USART2
-#define TERMINAL_HW_USART_BAUD_RATE     9600
+
+// USART2_TX is mapped on DMA1 channel 4 (request 4), the channel interrupt is handled by the DMA driver.
+#define TERMINAL_HW_DMA_CHANNEL         DMA_CHANNEL_4
+#define TERMINAL_HW_DMA_REQUEST         4
+#define TERMINAL_HW_USART_CR3_DMAT      (0b1 << 7)
+#define TERMINAL_HW_USART_ISR_TC        (0b1 << 6)
+
+#define TERMINAL_HW_TX_BUFFERS_NUMBER   2
+// Both buffers take 267ms at the minimum baud rate.
+#define TERMINAL_HW_TIMEOUT_MS          1000
+
+/*** TERMINAL HW local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t baud_rate;
+    uint8_t tx_buffer[TERMINAL_HW_TX_BUFFERS_NUMBER][TERMINAL_HW_TX_BUFFER_SIZE];
+    volatile uint16_t tx_size[TERMINAL_HW_TX_BUFFERS_NUMBER];
+    volatile uint8_t tx_fill_index;
+    volatile uint8_t tx_dma_running;
+} TERMINAL_HW_context_t;
+
+/*** TERMINAL HW local global variables ***/
+
+static TERMINAL_HW_context_t terminal_hw_ctx = {
+    .baud_rate = TERMINAL_HW_BAUD_RATE_DEFAULT
+};
+
+/*** TERMINAL HW local functions ***/
+
+/*******************************************************************/
+static void _TERMINAL_HW_start_dma(void) {
+    // Local variables.
+    uint8_t buffer_index = terminal_hw_ctx.tx_fill_index;
+    // Must be called with interrupts masked: send the filled buffer if the DMA is idle.
+    if ((terminal_hw_ctx.tx_dma_running != 0) || (terminal_hw_ctx.tx_size[buffer_index] == 0)) goto end;
+    DMA_set_memory_address(TERMINAL_HW_DMA_CHANNEL, (uint32_t) &(terminal_hw_ctx.tx_buffer[buffer_index][0]), terminal_hw_ctx.tx_size[buffer_index]);
+    DMA_start(TERMINAL_HW_DMA_CHANNEL);
+    terminal_hw_ctx.tx_dma_running = 1;
+    // Swap buffers.
+    buffer_index ^= 1;
+    terminal_hw_ctx.tx_size[buffer_index] = 0;
+    terminal_hw_ctx.tx_fill_index = buffer_index;
+end:
+    return;
+}
+
+/*******************************************************************/
+static void _TERMINAL_HW_dma_transfer_complete_callback(void) {
+    // Called under DMA interrupt.
+    DMA_stop(TERMINAL_HW_DMA_CHANNEL);
+    terminal_hw_ctx.tx_dma_running = 0;
+    // Chain the buffer filled in the meantime.
+    _TERMINAL_HW_start_dma();
+}
+
+/*******************************************************************/
+static TERMINAL_status_t _TERMINAL_HW_flush(void) {
+    // Local variables.
+    TERMINAL_status_t status = TERMINAL_SUCCESS;
+    uint32_t start_ms = TIMESTAMP_get_milliseconds();
+    // Wait for both buffers to be sent.
+    while ((terminal_hw_ctx.tx_dma_running != 0) || (terminal_hw_ctx.tx_size[terminal_hw_ctx.tx_fill_index] != 0)) {
+        if ((TIMESTAMP_get_milliseconds() - start_ms) > TERMINAL_HW_TIMEOUT_MS) {
+            status = (TERMINAL_ERROR_BASE_HW_INTERFACE + USART_ERROR_TX_TIMEOUT);
+            goto errors;
+        }
+    }
+    // Wait for the last byte to leave the shift register.
+    while (((USART2 -> ISR) & TERMINAL_HW_USART_ISR_TC) == 0) {
+        if ((TIMESTAMP_get_milliseconds() - start_ms) > TERMINAL_HW_TIMEOUT_MS) {
+            status = (TERMINAL_ERROR_BASE_HW_INTERFACE + USART_ERROR_TX_TIMEOUT);
+            goto errors;
+        }
+    }
+errors:
+    return status;
+}
 
 /*** TERMINAL HW functions ***/
 
+/*******************************************************************/
+void TERMINAL_HW_set_baud_rate(uint32_t baud_rate) {
+    terminal_hw_ctx.baud_rate = baud_rate;
+}
+
+/*******************************************************************/
+uint32_t TERMINAL_HW_get_baud_rate(void) {
+    return (terminal_hw_ctx.baud_rate);
+}
+
 /*******************************************************************/
 TERMINAL_status_t TERMINAL_HW_init(uint8_t instance, TERMINAL_rx_irq_cb_t rx_irq_callback) {
     // Local variables.
     TERMINAL_status_t status = TERMINAL_SUCCESS;
     USART_status_t usart_status = USART_SUCCESS;
+    DMA_status_t dma_status = DMA_SUCCESS;
     USART_configuration_t usart_config;
+    DMA_configuration_t dma_config;
     // Unused parameter.
     UNUSED(instance);
+    // Init context.
+    terminal_hw_ctx.tx_size[0] = 0;
+    terminal_hw_ctx.tx_size[1] = 0;
+    terminal_hw_ctx.tx_fill_index = 0;
+    terminal_hw_ctx.tx_dma_running = 0;
     // Init USART.
-    usart_config.baud_rate = TERMINAL_HW_USART_BAUD_RATE;
+    usart_config.baud_rate = terminal_hw_ctx.baud_rate;
     usart_config.nvic_priority = NVIC_PRIORITY_CLI;
     usart_config.rxne_callback = rx_irq_callback;
     usart_status = USART_init(TERMINAL_HW_USART_INSTANCE, &GPIO_AT_USART, &usart_config);
     USART_exit_error(TERMINAL_ERROR_BASE_HW_INTERFACE);
+    // Init transmission DMA channel (memory to peripheral, memory increment, transfer complete interrupt).
+    dma_config.direction = DMA_DIRECTION_MEMORY_TO_PERIPHERAL;
+    dma_config.memory_address = (uint32_t) &(terminal_hw_ctx.tx_buffer[0][0]);
+    dma_config.memory_data_size = DMA_DATA_SIZE_8_BITS;
+    dma_config.memory_address_increment = 1;
+    dma_config.peripheral_address = (uint32_t) &(USART2 -> TDR);
+    dma_config.peripheral_data_size = DMA_DATA_SIZE_8_BITS;
+    dma_config.peripheral_address_increment = 0;
+    dma_config.number_of_data = 0;
+    dma_config.priority = DMA_PRIORITY_LOW;
+    dma_config.request_number = TERMINAL_HW_DMA_REQUEST;
+    dma_config.tc_irq_callback = &_TERMINAL_HW_dma_transfer_complete_callback;
+    dma_config.nvic_priority = NVIC_PRIORITY_CLI;
+    dma_status = DMA_init(TERMINAL_HW_DMA_CHANNEL, &dma_config);
+    DMA_stack_exit_error(ERROR_BASE_DMA_TERMINAL, (TERMINAL_status_t) TERMINAL_ERROR_BASE_HW_INTERFACE);
+    USART2 -> CR3 |= TERMINAL_HW_USART_CR3_DMAT;
     // Start reception.
     usart_status = USART_enable_rx(TERMINAL_HW_USART_INSTANCE);
     USART_exit_error(TERMINAL_ERROR_BASE_HW_INTERFACE);
@@ -49,8 +166,16 @@ TERMINAL_status_t TERMINAL_HW_de_init(uint8_t instance) {
     // Local variables.
     TERMINAL_status_t status = TERMINAL_SUCCESS;
     USART_status_t usart_status = USART_SUCCESS;
+    DMA_status_t dma_status = DMA_SUCCESS;
     // Unused parameter.
     UNUSED(instance);
+    // Send pending data.
+    status = _TERMINAL_HW_flush();
+    // Release DMA channel.
+    USART2 -> CR3 &= ~(TERMINAL_HW_USART_CR3_DMAT);
+    dma_status = DMA_de_init(TERMINAL_HW_DMA_CHANNEL);
+    DMA_stack_error(ERROR_BASE_DMA_TERMINAL);
+    terminal_hw_ctx.tx_dma_running = 0;
     // Release USART.
     usart_status = USART_de_init(TERMINAL_HW_USART_INSTANCE, &GPIO_AT_USART);
     USART_exit_error(TERMINAL_ERROR_BASE_HW_INTERFACE);
@@ -62,12 +187,40 @@ errors:
 TERMINAL_status_t TERMINAL_HW_write(uint8_t instance, uint8_t* data, uint32_t data_size_bytes) {
     // Local variables.
     TERMINAL_status_t status = TERMINAL_SUCCESS;
-    USART_status_t usart_status = USART_SUCCESS;
+    uint32_t primask = 0;
+    uint32_t start_ms = 0;
+    uint8_t buffer_index = 0;
+    uint16_t chunk_size = 0;
+    uint16_t idx = 0;
     // Unused parameter.
     UNUSED(instance);
-    // Write data over USART.
-    usart_status = USART_write(TERMINAL_HW_USART_INSTANCE, data, data_size_bytes);
-    USART_exit_error(TERMINAL_ERROR_BASE_HW_INTERFACE);
+    // Copy data into the filling buffer, the DMA sends the other one.
+    while (data_size_bytes > 0) {
+        // Enter critical section.
+        __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) : : "memory");
+        buffer_index = terminal_hw_ctx.tx_fill_index;
+        chunk_size = (uint16_t) (TERMINAL_HW_TX_BUFFER_SIZE - terminal_hw_ctx.tx_size[buffer_index]);
+        if (chunk_size > data_size_bytes) {
+            chunk_size = (uint16_t) data_size_bytes;
+        }
+        for (idx = 0; idx < chunk_size; idx++) {
+            terminal_hw_ctx.tx_buffer[buffer_index][terminal_hw_ctx.tx_size[buffer_index] + idx] = data[idx];
+        }
+        terminal_hw_ctx.tx_size[buffer_index] += chunk_size;
+        _TERMINAL_HW_start_dma();
+        // Exit critical section.
+        __asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+        data += chunk_size;
+        data_size_bytes -= chunk_size;
+        // Both buffers are full: wait for the current transfer to complete.
+        start_ms = TIMESTAMP_get_milliseconds();
+        while ((data_size_bytes > 0) && (terminal_hw_ctx.tx_size[terminal_hw_ctx.tx_fill_index] >= TERMINAL_HW_TX_BUFFER_SIZE)) {
+            if ((TIMESTAMP_get_milliseconds() - start_ms) > TERMINAL_HW_TIMEOUT_MS) {
+                status = (TERMINAL_ERROR_BASE_HW_INTERFACE + USART_ERROR_TX_TIMEOUT);
+                goto errors;
+            }
+        }
+    }
 errors:
     return status;
 }
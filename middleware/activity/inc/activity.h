@@ -0,0 +1,110 @@
+/*
+ * activity.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __ACTIVITY_H__
+#define __ACTIVITY_H__
+
+#include "types.h"
+
+/*** ACTIVITY macros ***/
+
+#define ACTIVITY_STATES_NUMBER_MAX      10
+// Wake duration histogram: bin i covers [4^i, 4^(i+1)[ ms, except first bin [0, 4[ ms and last bin [16384, inf[ ms.
+#define ACTIVITY_HISTOGRAM_BINS_NUMBER  8
+#define ACTIVITY_HISTOGRAM_BIN_LOG2     2
+
+/*** ACTIVITY structures ***/
+
+/*!******************************************************************
+ * \struct ACTIVITY_statistics_t
+ * \brief Time in state and wake duration statistics.
+ *******************************************************************/
+typedef struct {
+    uint32_t state_time_ms[ACTIVITY_STATES_NUMBER_MAX];
+    uint32_t wake_count;
+    uint32_t awake_time_ms;
+    uint32_t wake_histogram[ACTIVITY_HISTOGRAM_BINS_NUMBER];
+} ACTIVITY_statistics_t;
+
+/*** ACTIVITY functions ***/
+
+/*!******************************************************************
+ * \fn void ACTIVITY_init(const char_t* const* state_names, uint8_t states_number, uint32_t timestamp_ms)
+ * \brief Init activity statistics.
+ * \param[in]   state_names: Names of the application states.
+ * \param[in]   states_number: Number of application states.
+ * \param[in]   timestamp_ms: Current millisecond timestamp.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void ACTIVITY_init(const char_t* const* state_names, uint8_t states_number, uint32_t timestamp_ms);
+
+/*!******************************************************************
+ * \fn void ACTIVITY_reset(void)
+ * \brief Reset all statistics (the current state and wake-up time are kept).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void ACTIVITY_reset(void);
+
+/*!******************************************************************
+ * \fn void ACTIVITY_set_state(uint8_t state, uint32_t timestamp_ms)
+ * \brief Account the time elapsed since the last call to the previous state.
+ * \param[in]   state: Current application state.
+ * \param[in]   timestamp_ms: Current millisecond timestamp.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void ACTIVITY_set_state(uint8_t state, uint32_t timestamp_ms);
+
+/*!******************************************************************
+ * \fn void ACTIVITY_wake_up(uint32_t timestamp_ms)
+ * \brief Mark the exit of stop mode.
+ * \param[in]   timestamp_ms: Current millisecond timestamp, taken after TIMESTAMP_exit_low_power().
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void ACTIVITY_wake_up(uint32_t timestamp_ms);
+
+/*!******************************************************************
+ * \fn void ACTIVITY_stop(uint32_t timestamp_ms)
+ * \brief Mark the entry of stop mode and update the wake duration histogram.
+ * \param[in]   timestamp_ms: Current millisecond timestamp.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void ACTIVITY_stop(uint32_t timestamp_ms);
+
+/*!******************************************************************
+ * \fn void ACTIVITY_get_statistics(ACTIVITY_statistics_t* statistics)
+ * \brief Get activity statistics.
+ * \param[in]   none
+ * \param[out]  statistics: Pointer to the statistics structure.
+ * \retval      none
+ *******************************************************************/
+void ACTIVITY_get_statistics(ACTIVITY_statistics_t* statistics);
+
+/*!******************************************************************
+ * \fn uint8_t ACTIVITY_get_states_number(void)
+ * \brief Get the number of application states.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Number of states.
+ *******************************************************************/
+uint8_t ACTIVITY_get_states_number(void);
+
+/*!******************************************************************
+ * \fn const char_t* ACTIVITY_get_state_name(uint8_t state)
+ * \brief Get application state name.
+ * \param[in]   state: State index.
+ * \param[out]  none
+ * \retval      State name.
+ *******************************************************************/
+const char_t* ACTIVITY_get_state_name(uint8_t state);
+
+#endif /* __ACTIVITY_H__ */
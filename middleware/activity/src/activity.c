@@ -0,0 +1,112 @@
+/*
+ * activity.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "activity.h"
+
+#include "types.h"
+
+/*** ACTIVITY local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    const char_t* const* state_names;
+    uint8_t states_number;
+    uint8_t state;
+    uint32_t state_timestamp_ms;
+    uint32_t wake_up_timestamp_ms;
+    ACTIVITY_statistics_t statistics;
+} ACTIVITY_context_t;
+
+/*** ACTIVITY local global variables ***/
+
+static ACTIVITY_context_t activity_ctx;
+
+/*** ACTIVITY local functions ***/
+
+/*******************************************************************/
+static uint8_t _ACTIVITY_get_bin(uint32_t duration_ms) {
+    // Local variables.
+    uint8_t bin = 0;
+    // Logarithmic bins.
+    duration_ms >>= ACTIVITY_HISTOGRAM_BIN_LOG2;
+    while ((duration_ms != 0) && (bin < (ACTIVITY_HISTOGRAM_BINS_NUMBER - 1))) {
+        duration_ms >>= ACTIVITY_HISTOGRAM_BIN_LOG2;
+        bin++;
+    }
+    return bin;
+}
+
+/*** ACTIVITY functions ***/
+
+/*******************************************************************/
+void ACTIVITY_init(const char_t* const* state_names, uint8_t states_number, uint32_t timestamp_ms) {
+    // Init context.
+    activity_ctx.state_names = state_names;
+    activity_ctx.states_number = (states_number > ACTIVITY_STATES_NUMBER_MAX) ? ACTIVITY_STATES_NUMBER_MAX : states_number;
+    activity_ctx.state = 0;
+    activity_ctx.state_timestamp_ms = timestamp_ms;
+    activity_ctx.wake_up_timestamp_ms = timestamp_ms;
+    ACTIVITY_reset();
+}
+
+/*******************************************************************/
+void ACTIVITY_reset(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Reset statistics.
+    for (idx = 0; idx < ACTIVITY_STATES_NUMBER_MAX; idx++) {
+        activity_ctx.statistics.state_time_ms[idx] = 0;
+    }
+    for (idx = 0; idx < ACTIVITY_HISTOGRAM_BINS_NUMBER; idx++) {
+        activity_ctx.statistics.wake_histogram[idx] = 0;
+    }
+    activity_ctx.statistics.wake_count = 0;
+    activity_ctx.statistics.awake_time_ms = 0;
+}
+
+/*******************************************************************/
+void ACTIVITY_set_state(uint8_t state, uint32_t timestamp_ms) {
+    // Account elapsed time to the previous state.
+    if (activity_ctx.state < activity_ctx.states_number) {
+        activity_ctx.statistics.state_time_ms[activity_ctx.state] += (timestamp_ms - activity_ctx.state_timestamp_ms);
+    }
+    activity_ctx.state = state;
+    activity_ctx.state_timestamp_ms = timestamp_ms;
+}
+
+/*******************************************************************/
+void ACTIVITY_wake_up(uint32_t timestamp_ms) {
+    activity_ctx.wake_up_timestamp_ms = timestamp_ms;
+}
+
+/*******************************************************************/
+void ACTIVITY_stop(uint32_t timestamp_ms) {
+    // Local variables.
+    uint32_t duration_ms = (timestamp_ms - activity_ctx.wake_up_timestamp_ms);
+    // Update statistics.
+    activity_ctx.statistics.wake_count++;
+    activity_ctx.statistics.awake_time_ms += duration_ms;
+    activity_ctx.statistics.wake_histogram[_ACTIVITY_get_bin(duration_ms)]++;
+}
+
+/*******************************************************************/
+void ACTIVITY_get_statistics(ACTIVITY_statistics_t* statistics) {
+    // Check parameter.
+    if (statistics == NULL) return;
+    // Copy statistics.
+    (*statistics) = activity_ctx.statistics;
+}
+
+/*******************************************************************/
+uint8_t ACTIVITY_get_states_number(void) {
+    return (activity_ctx.states_number);
+}
+
+/*******************************************************************/
+const char_t* ACTIVITY_get_state_name(uint8_t state) {
+    return (((activity_ctx.state_names != NULL) && (state < activity_ctx.states_number)) ? activity_ctx.state_names[state] : "");
+}
@@ -10,6 +10,7 @@
 #include "adc.h"
 #include "error.h"
 #include "gpio_mapping.h"
+#include "profiler.h"
 #include "tkfx_flags.h"
 #include "types.h"
 
@@ -106,6 +107,7 @@ ANALOG_status_t ANALOG_convert_channel(ANALOG_channel_t channel, int32_t* analog
     ANALOG_status_t status = ANALOG_SUCCESS;
     ADC_status_t adc_status = ADC_SUCCESS;
     int32_t adc_data_12bits = 0;
+    PROFILER_START(PROFILER_PROBE_ANALOG_CONVERSION);
     // Check parameter.
     if (analog_data == NULL) {
         status = ANALOG_ERROR_NULL_PARAMETER;
@@ -160,5 +162,6 @@ ANALOG_status_t ANALOG_convert_channel(ANALOG_channel_t channel, int32_t* analog
         goto errors;
     }
 errors:
+    PROFILER_STOP(PROFILER_PROBE_ANALOG_CONVERSION);
     return status;
 }
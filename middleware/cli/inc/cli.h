@@ -9,7 +9,11 @@
 #define __CLI_H__
 
 #include "at.h"
+#include "overlay.h"
+#include "provisioning.h"
 #include "sigfox_types.h"
+#include "stream.h"
+#include "terminal.h"
 #include "tkfx_flags.h"
 #include "types.h"
 
@@ -22,10 +26,19 @@
 typedef enum {
     // Driver errors.
     CLI_SUCCESS = 0,
+    CLI_ERROR_BAUD_RATE,
+    CLI_ERROR_RSSI_SWEEP,
+    CLI_ERROR_MACRO_SIZE,
+    CLI_ERROR_MACRO_RUNNING,
+    CLI_ERROR_MACRO_FAILED,
     // Low level drivers errors.
     CLI_ERROR_BASE_AT = 0x0100,
+    CLI_ERROR_BASE_PROVISIONING = (CLI_ERROR_BASE_AT + AT_ERROR_BASE_LAST),
+    CLI_ERROR_BASE_STREAM = (CLI_ERROR_BASE_PROVISIONING + PROVISIONING_ERROR_BASE_LAST),
+    CLI_ERROR_BASE_OVERLAY = (CLI_ERROR_BASE_STREAM + STREAM_ERROR_BASE_LAST),
+    CLI_ERROR_BASE_TERMINAL = (CLI_ERROR_BASE_OVERLAY + OVERLAY_ERROR_BASE_LAST),
     // Last base value.
-    CLI_ERROR_BASE_LAST = (CLI_ERROR_BASE_AT + AT_ERROR_BASE_LAST)
+    CLI_ERROR_BASE_LAST = (CLI_ERROR_BASE_TERMINAL + TERMINAL_ERROR_BASE_LAST)
 } CLI_status_t;
 
 #ifdef TKFX_MODE_CLI
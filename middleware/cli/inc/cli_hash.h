@@ -0,0 +1,103 @@
+/*
+ * cli_hash.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ *
+ *  Generated by script/tkfx_cli_hash.py from the CLI_COMMANDS_LIST syntaxes, do not edit.
+ */
+
+#ifndef __CLI_HASH_H__
+#define __CLI_HASH_H__
+
+/*** CLI HASH macros ***/
+
+#define CLI_HASH_SEED               0x000000BE
+#define CLI_HASH_MULTIPLIER         0x01000193
+#define CLI_HASH_TABLE_SIZE_LOG2    7
+#define CLI_HASH_TABLE_SIZE         (1 << CLI_HASH_TABLE_SIZE_LOG2)
+#define CLI_HASH_EMPTY              0xFF
+
+/*** CLI HASH structures ***/
+
+/*!******************************************************************
+ * \enum CLI_command_id_t
+ * \brief CLI commands identifiers (index in the commands list).
+ *******************************************************************/
+typedef enum {
+    CLI_COMMAND_ID_HELP_READ,
+    CLI_COMMAND_ID_RST,
+    CLI_COMMAND_ID_RCC_READ,
+    CLI_COMMAND_ID_BAUD_WRITE,
+    CLI_COMMAND_ID_PAT_WRITE,
+    CLI_COMMAND_ID_MEM_READ,
+    CLI_COMMAND_ID_ACT_READ,
+    CLI_COMMAND_ID_ACT_WRITE,
+    CLI_COMMAND_ID_TRACE_READ,
+    CLI_COMMAND_ID_ERR_READ,
+    CLI_COMMAND_ID_PROF_READ,
+    CLI_COMMAND_ID_PROF_WRITE,
+    CLI_COMMAND_ID_NVM_WRITE,
+    CLI_COMMAND_ID_ID_READ,
+    CLI_COMMAND_ID_ID_WRITE,
+    CLI_COMMAND_ID_KEY_READ,
+    CLI_COMMAND_ID_KEY_WRITE,
+    CLI_COMMAND_ID_PROV_WRITE,
+    CLI_COMMAND_ID_MAC_READ,
+    CLI_COMMAND_ID_MAC_WRITE,
+    CLI_COMMAND_ID_MACR,
+    CLI_COMMAND_ID_MACC,
+    CLI_COMMAND_ID_ADC_READ,
+    CLI_COMMAND_ID_THS_READ,
+    CLI_COMMAND_ID_ACC_READ,
+    CLI_COMMAND_ID_STRM_WRITE,
+    CLI_COMMAND_ID_GPS_WRITE,
+    CLI_COMMAND_ID_SO,
+    CLI_COMMAND_ID_SB_WRITE,
+    CLI_COMMAND_ID_SF_WRITE,
+    CLI_COMMAND_ID_TM_WRITE,
+    CLI_COMMAND_ID_CW_WRITE,
+    CLI_COMMAND_ID_RSSI_WRITE,
+    CLI_COMMAND_ID_RSWP_WRITE,
+    CLI_COMMAND_ID_LAST
+} CLI_command_id_t;
+
+/*** CLI HASH global variables ***/
+
+// Hash table content (command identifier of each bucket).
+#define CLI_HASH_BUCKETS { \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_COMMAND_ID_BAUD_WRITE, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_COMMAND_ID_PAT_WRITE, CLI_HASH_EMPTY, CLI_COMMAND_ID_ADC_READ, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_COMMAND_ID_TM_WRITE, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_COMMAND_ID_HELP_READ, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_COMMAND_ID_ACT_READ, \
+    CLI_COMMAND_ID_ACT_WRITE, CLI_COMMAND_ID_NVM_WRITE, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_COMMAND_ID_TRACE_READ, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_COMMAND_ID_RSSI_WRITE, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_COMMAND_ID_RST, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_COMMAND_ID_ERR_READ, \
+    CLI_COMMAND_ID_THS_READ, CLI_COMMAND_ID_PROF_WRITE, CLI_COMMAND_ID_PROF_READ, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_COMMAND_ID_SB_WRITE, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_COMMAND_ID_RCC_READ, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_COMMAND_ID_ID_READ, CLI_COMMAND_ID_ID_WRITE, CLI_COMMAND_ID_MAC_WRITE, CLI_COMMAND_ID_MAC_READ, \
+    CLI_COMMAND_ID_STRM_WRITE, CLI_HASH_EMPTY, CLI_COMMAND_ID_CW_WRITE, CLI_COMMAND_ID_RSWP_WRITE, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_COMMAND_ID_MACR, CLI_HASH_EMPTY, CLI_COMMAND_ID_GPS_WRITE, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_COMMAND_ID_ACC_READ, \
+    CLI_HASH_EMPTY, CLI_COMMAND_ID_MACC, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_COMMAND_ID_MEM_READ, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_COMMAND_ID_KEY_WRITE, CLI_COMMAND_ID_KEY_READ, \
+    CLI_COMMAND_ID_SO, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_COMMAND_ID_PROV_WRITE, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_COMMAND_ID_SF_WRITE, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, \
+    CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY, CLI_HASH_EMPTY \
+}
+
+#endif /* __CLI_HASH_H__ */
@@ -7,6 +7,8 @@
 
 #include "cli.h"
 
+#include "cli_hash.h"
+
 // Peripherals.
 #include "i2c_address.h"
 #include "iwdg.h"
@@ -16,6 +18,7 @@
 #include "nvm_address.h"
 #include "pwr.h"
 #include "rcc.h"
+#include "rtc.h"
 // Utils.
 #include "at.h"
 #include "at_instance.h"
@@ -23,14 +26,27 @@
 #include "math.h"
 #include "parser.h"
 #include "string.h"
+#include "terminal.h"
+#include "terminal_hw.h"
+#include "terminal_hw_config.h"
 #include "terminal_instance.h"
 #include "types.h"
 // Components.
 #include "sht3x.h"
+#include "sht3x_measurement.h"
 // Middleware.
+#include "activity.h"
 #include "analog.h"
+#include "fault.h"
 #include "gps.h"
+#include "overlay.h"
 #include "power.h"
+#include "profiler.h"
+#include "provisioning.h"
+#include "ram.h"
+#include "stream.h"
+#include "timestamp.h"
+#include "trace.h"
 // Sigfox.
 #include "manuf/rf_api.h"
 #include "sigfox_ep_addon_rfp_api.h"
@@ -49,10 +65,28 @@
 
 // Parsing.
 #define CLI_CHAR_SEPARATOR          STRING_CHAR_COMMA
+#define CLI_CHAR_COMMAND_HEADER     '$'
+#define CLI_CHAR_COMMAND_READ       '?'
+#define CLI_CHAR_COMMAND_WRITE      '='
 // Duration of RSSI command.
 #define CLI_RSSI_REPORT_PERIOD_MS   500
+// RSSI sweep: PLL and RSSI filter settling after each hop, then samples period.
+#define CLI_RSSI_SWEEP_SETTLE_MS        2
+#define CLI_RSSI_SWEEP_SAMPLE_PERIOD_MS 1
+#define CLI_RSSI_SWEEP_CHANNELS_MAX     1000
+#define CLI_RSSI_SWEEP_SAMPLES_MAX      255
+// Delay before switching the terminal to a provisioning session.
+#define CLI_PROVISIONING_SWITCH_DELAY_MS    10
+// Terminal test pattern.
+#define CLI_PATTERN_LINE_SIZE       32
+#define CLI_PATTERN_ALPHABET_SIZE   26
+// Macro stored in NVM: NULL terminated steps, ended by an empty step.
+#define CLI_MACRO_SIZE_BYTES        256
+#define CLI_MACRO_STEP_SIZE_BYTES   48
+#define CLI_MACRO_EXPECT_ERROR      '!'
 // Enabled commands.
 #define CLI_COMMAND_NVM
+#define CLI_COMMAND_MACRO
 #define CLI_COMMAND_SENSORS
 #define CLI_COMMAND_GPS
 #define CLI_COMMAND_SIGFOX_EP_LIB
@@ -66,13 +100,33 @@
 typedef struct {
     volatile uint8_t at_process_flag;
     PARSER_context_t* at_parser_ptr;
+    uint32_t baud_rate;
+#ifdef CLI_COMMAND_NVM
+    uint32_t provisioning_baud_rate;
+#endif
+#ifdef CLI_COMMAND_MACRO
+    uint8_t macro_running;
+#endif
 } CLI_context_t;
 
 /*** CLI local functions declaration ***/
 
 /*******************************************************************/
+static AT_status_t _CLI_dispatch_callback(void);
+static AT_status_t _CLI_help_callback(void);
 static AT_status_t _CLI_rst_callback(void);
 static AT_status_t _CLI_rcc_callback(void);
+static AT_status_t _CLI_baud_callback(void);
+static AT_status_t _CLI_pat_callback(void);
+static AT_status_t _CLI_mem_callback(void);
+static AT_status_t _CLI_get_act_callback(void);
+static AT_status_t _CLI_set_act_callback(void);
+static AT_status_t _CLI_trace_callback(void);
+static AT_status_t _CLI_err_callback(void);
+#ifdef TKFX_PROFILER
+static AT_status_t _CLI_get_prof_callback(void);
+static AT_status_t _CLI_set_prof_callback(void);
+#endif
 /*******************************************************************/
 #ifdef CLI_COMMAND_NVM
 static AT_status_t _CLI_nvm_callback(void);
@@ -80,12 +134,21 @@ static AT_status_t _CLI_get_ep_id_callback(void);
 static AT_status_t _CLI_set_ep_id_callback(void);
 static AT_status_t _CLI_get_ep_key_callback(void);
 static AT_status_t _CLI_set_ep_key_callback(void);
+static AT_status_t _CLI_prov_callback(void);
+#endif
+/*******************************************************************/
+#ifdef CLI_COMMAND_MACRO
+static AT_status_t _CLI_get_mac_callback(void);
+static AT_status_t _CLI_set_mac_callback(void);
+static AT_status_t _CLI_macr_callback(void);
+static AT_status_t _CLI_macc_callback(void);
 #endif
 /*******************************************************************/
 #ifdef CLI_COMMAND_SENSORS
 static AT_status_t _CLI_adc_callback(void);
 static AT_status_t _CLI_ths_callback(void);
 static AT_status_t _CLI_acc_callback(void);
+static AT_status_t _CLI_strm_callback(void);
 #endif
 /*******************************************************************/
 #ifdef CLI_COMMAND_GPS
@@ -109,77 +172,178 @@ static AT_status_t _CLI_cw_callback(void);
 #endif
 #if (defined CLI_COMMAND_RSSI) && (defined BIDIRECTIONAL)
 static AT_status_t _CLI_rssi_callback(void);
+static AT_status_t _CLI_rswp_callback(void);
 #endif
 
 /*** CLI local global variables ***/
 
-static const AT_command_t CLI_COMMANDS_LIST[] = {
-    {
+static const AT_command_t CLI_COMMANDS_LIST[CLI_COMMAND_ID_LAST] = {
+    [CLI_COMMAND_ID_HELP_READ] = {
+        .syntax = "$HELP?",
+        .parameters = NULL,
+        .description = "List commands",
+        .callback = &_CLI_help_callback
+    },
+    [CLI_COMMAND_ID_RST] = {
         .syntax = "$RST",
         .parameters = NULL,
         .description = "Reset MCU",
         .callback = &_CLI_rst_callback
     },
-    {
+    [CLI_COMMAND_ID_RCC_READ] = {
         .syntax = "$RCC?",
         .parameters = NULL,
         .description = "Get clocks frequency",
         .callback = &_CLI_rcc_callback
     },
+    [CLI_COMMAND_ID_BAUD_WRITE] = {
+        .syntax = "$BAUD=",
+        .parameters = "<baud_rate[dec]>",
+        .description = "Set terminal baud rate (after OK reply)",
+        .callback = &_CLI_baud_callback
+    },
+    [CLI_COMMAND_ID_PAT_WRITE] = {
+        .syntax = "$PAT=",
+        .parameters = "<number_of_lines[dec]>",
+        .description = "Send terminal test pattern",
+        .callback = &_CLI_pat_callback
+    },
+    [CLI_COMMAND_ID_MEM_READ] = {
+        .syntax = "$MEM?",
+        .parameters = NULL,
+        .description = "Get RAM budget and stack high-water mark",
+        .callback = &_CLI_mem_callback
+    },
+    [CLI_COMMAND_ID_ACT_READ] = {
+        .syntax = "$ACT?",
+        .parameters = NULL,
+        .description = "Get time in state and wake duration histogram",
+        .callback = &_CLI_get_act_callback
+    },
+    [CLI_COMMAND_ID_ACT_WRITE] = {
+        .syntax = "$ACT=",
+        .parameters = "<0>",
+        .description = "Reset activity statistics",
+        .callback = &_CLI_set_act_callback
+    },
+    [CLI_COMMAND_ID_TRACE_READ] = {
+        .syntax = "$TRACE?",
+        .parameters = NULL,
+        .description = "Dump events trace (oldest first)",
+        .callback = &_CLI_trace_callback
+    },
+    [CLI_COMMAND_ID_ERR_READ] = {
+        .syntax = "$ERR?",
+        .parameters = NULL,
+        .description = "Get aggregated error codes",
+        .callback = &_CLI_err_callback
+    },
+#ifdef TKFX_PROFILER
+    [CLI_COMMAND_ID_PROF_READ] = {
+        .syntax = "$PROF?",
+        .parameters = NULL,
+        .description = "Get profiling probes statistics",
+        .callback = &_CLI_get_prof_callback
+    },
+    [CLI_COMMAND_ID_PROF_WRITE] = {
+        .syntax = "$PROF=",
+        .parameters = "<0>",
+        .description = "Reset profiling probes statistics",
+        .callback = &_CLI_set_prof_callback
+    },
+#endif
 #ifdef CLI_COMMAND_NVM
-    {
+    [CLI_COMMAND_ID_NVM_WRITE] = {
         .syntax = "$NVM=",
         .parameters = "<address[dec]>",
         .description = "Read NVM byte",
         .callback = &_CLI_nvm_callback
     },
-    {
+    [CLI_COMMAND_ID_ID_READ] = {
         .syntax = "$ID?",
         .parameters = NULL,
         .description = "Get Sigfox EP ID",
         .callback = &_CLI_get_ep_id_callback
     },
-    {
+    [CLI_COMMAND_ID_ID_WRITE] = {
         .syntax = "$ID=",
         .parameters = "<id[hex]>",
         .description = "Set Sigfox EP ID",
         .callback = &_CLI_set_ep_id_callback
     },
-    {
+    [CLI_COMMAND_ID_KEY_READ] = {
         .syntax = "$KEY?",
         .parameters = NULL,
         .description = "Get Sigfox EP key",
         .callback = &_CLI_get_ep_key_callback
     },
-    {
+    [CLI_COMMAND_ID_KEY_WRITE] = {
         .syntax = "$KEY=",
         .parameters = "<key[hex]>",
         .description = "Set Sigfox EP key",
         .callback = &_CLI_set_ep_key_callback
     },
+    [CLI_COMMAND_ID_PROV_WRITE] = {
+        .syntax = "$PROV=",
+        .parameters = "<baud_rate[dec]>",
+        .description = "Start binary provisioning session",
+        .callback = &_CLI_prov_callback
+    },
+#endif
+#ifdef CLI_COMMAND_MACRO
+    [CLI_COMMAND_ID_MAC_READ] = {
+        .syntax = "$MAC?",
+        .parameters = NULL,
+        .description = "List macro steps",
+        .callback = &_CLI_get_mac_callback
+    },
+    [CLI_COMMAND_ID_MAC_WRITE] = {
+        .syntax = "$MAC=",
+        .parameters = "<(!)command>",
+        .description = "Append a macro step ('!' when an error is expected)",
+        .callback = &_CLI_set_mac_callback
+    },
+    [CLI_COMMAND_ID_MACR] = {
+        .syntax = "$MACR",
+        .parameters = NULL,
+        .description = "Run macro and print pass/fail report",
+        .callback = &_CLI_macr_callback
+    },
+    [CLI_COMMAND_ID_MACC] = {
+        .syntax = "$MACC",
+        .parameters = NULL,
+        .description = "Clear macro",
+        .callback = &_CLI_macc_callback
+    },
 #endif
 #ifdef CLI_COMMAND_SENSORS
-    {
+    [CLI_COMMAND_ID_ADC_READ] = {
         .syntax = "$ADC?",
         .parameters = NULL,
         .description = "Read analog measurements",
         .callback = &_CLI_adc_callback
     },
-    {
+    [CLI_COMMAND_ID_THS_READ] = {
         .syntax = "$THS?",
         .parameters = NULL,
         .description = "Read temperature and humidity",
         .callback = &_CLI_ths_callback
     },
-    {
+    [CLI_COMMAND_ID_ACC_READ] = {
         .syntax = "$ACC?",
         .parameters = NULL,
         .description = "Read accelerometer chip ID",
         .callback = &_CLI_acc_callback
     },
+    [CLI_COMMAND_ID_STRM_WRITE] = {
+        .syntax = "$STRM=",
+        .parameters = "<channels_mask[hex]>,<period[ms]>",
+        .description = "Stream binary sensors records (stopped by any command)",
+        .callback = &_CLI_strm_callback
+    },
 #endif
 #ifdef CLI_COMMAND_GPS
-    {
+    [CLI_COMMAND_ID_GPS_WRITE] = {
         .syntax = "$GPS=",
         .parameters = "<timeout[s]>",
         .description = "Get GPS position",
@@ -188,20 +352,20 @@ static const AT_command_t CLI_COMMANDS_LIST[] = {
 #endif
 #ifdef CLI_COMMAND_SIGFOX_EP_LIB
 #ifdef CONTROL_KEEP_ALIVE_MESSAGE
-    {
+    [CLI_COMMAND_ID_SO] = {
         .syntax = "$SO",
         .parameters = NULL,
         .description = "Sigfox send control keep-alive",
         .callback = &_CLI_so_callback
     },
 #endif
-    {
+    [CLI_COMMAND_ID_SB_WRITE] = {
         .syntax = "$SB=",
         .parameters = "<data[bit]>,(<bidir_flag[bit]>)",
         .description = "Sigfox send bit",
         .callback = &_CLI_sb_callback
     },
-    {
+    [CLI_COMMAND_ID_SF_WRITE] = {
         .syntax = "$SF=",
         .parameters = "<data[hex]>,(<bidir_flag[bit]>)",
         .description = "Sigfox send frame",
@@ -209,7 +373,7 @@ static const AT_command_t CLI_COMMANDS_LIST[] = {
     },
 #endif
 #ifdef CLI_COMMAND_SIGFOX_EP_ADDON_RFP
-    {
+    [CLI_COMMAND_ID_TM_WRITE] = {
         .syntax = "$TM=",
         .parameters = "<bit_rate_index[dec]>,<test_mode_reference[dec]>",
         .description = "Sigfox RFP test mode",
@@ -217,7 +381,7 @@ static const AT_command_t CLI_COMMANDS_LIST[] = {
     },
 #endif
 #ifdef CLI_COMMAND_CW
-    {
+    [CLI_COMMAND_ID_CW_WRITE] = {
         .syntax = "$CW=",
         .parameters = "<frequency[hz]>,<enable[bit]>,(<output_power[dbm]>)",
         .description = "Continuous wave",
@@ -225,15 +389,31 @@ static const AT_command_t CLI_COMMANDS_LIST[] = {
     },
 #endif
 #if (defined CLI_COMMAND_RSSI) && (defined BIDIRECTIONAL)
-    {
+    [CLI_COMMAND_ID_RSSI_WRITE] = {
         .syntax = "$RSSI=",
         .parameters = "<frequency[hz]>,<duration[s]>",
         .description = "Continuous RSSI measurement",
         .callback = &_CLI_rssi_callback
+    },
+    [CLI_COMMAND_ID_RSWP_WRITE] = {
+        .syntax = "$RSWP=",
+        .parameters = "<start_frequency[hz]>,<stop_frequency[hz]>,<step[hz]>,<samples>",
+        .description = "RSSI sweep with min/max/mean per channel",
+        .callback = &_CLI_rswp_callback
     }
 #endif
 };
 
+static const uint8_t CLI_HASH_TABLE[CLI_HASH_TABLE_SIZE] = CLI_HASH_BUCKETS;
+
+// Single command registered in the AT driver: all syntaxes share the header and are dispatched through the hash table.
+static const AT_command_t CLI_DISPATCH_COMMAND = {
+    .syntax = "$",
+    .parameters = "<command>",
+    .description = "Tracker commands (see $HELP?)",
+    .callback = &_CLI_dispatch_callback
+};
+
 static CLI_context_t cli_ctx;
 
 /*** CLI local functions ***/
@@ -256,6 +436,63 @@ static void _CLI_at_process_callback(void) {
     cli_ctx.at_process_flag = 1;
 }
 
+/*******************************************************************/
+static AT_status_t _CLI_dispatch_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_ERROR_BASE_PARSER + PARSER_ERROR_HEADER;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    PARSER_context_t* parser_ptr = cli_ctx.at_parser_ptr;
+    const AT_command_t* command_ptr = NULL;
+    const char_t* command_str = &((parser_ptr -> buffer)[parser_ptr -> start_index]);
+    uint32_t command_size_max = ((parser_ptr -> buffer_size) - (parser_ptr -> start_index));
+    uint32_t hash = ((CLI_HASH_SEED ^ ((uint8_t) CLI_CHAR_COMMAND_HEADER)) * CLI_HASH_MULTIPLIER);
+    uint8_t command_id = CLI_HASH_EMPTY;
+    uint32_t idx = 0;
+    // The header has been matched by the AT driver: hash the rest of the syntax (including the read or write character).
+    while ((idx < command_size_max) && (command_str[idx] != STRING_CHAR_NULL)) {
+        hash = (hash ^ ((uint8_t) command_str[idx])) * CLI_HASH_MULTIPLIER;
+        idx++;
+        if ((command_str[idx - 1] == CLI_CHAR_COMMAND_READ) || (command_str[idx - 1] == CLI_CHAR_COMMAND_WRITE)) break;
+    }
+    // Get command.
+    command_id = CLI_HASH_TABLE[hash >> (32 - CLI_HASH_TABLE_SIZE_LOG2)];
+    if (command_id == CLI_HASH_EMPTY) goto errors;
+    command_ptr = &(CLI_COMMANDS_LIST[command_id]);
+    // Check command is enabled in this build.
+    if ((command_ptr -> syntax) == NULL) goto errors;
+    // Full syntax check: the parser then points to the parameters, commands without parameters must end the line.
+    parser_status = PARSER_compare(parser_ptr, (((command_ptr -> parameters) == NULL) ? PARSER_MODE_COMMAND : PARSER_MODE_HEADER), (char_t*) &((command_ptr -> syntax)[1]));
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Execute command.
+    status = (command_ptr -> callback)();
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_help_callback(void) {
+    // Local variables.
+    uint8_t command_id = 0;
+    uint8_t idx = 0;
+    // Commands reachable through the hash table, in identifier order.
+    for (command_id = 0; command_id < CLI_COMMAND_ID_LAST; command_id++) {
+        for (idx = 0; idx < CLI_HASH_TABLE_SIZE; idx++) {
+            if (CLI_HASH_TABLE[idx] == command_id) break;
+        }
+        // Skip commands disabled in this build.
+        if ((idx >= CLI_HASH_TABLE_SIZE) || ((CLI_COMMANDS_LIST[command_id].syntax) == NULL)) continue;
+        AT_reply_add_string(AT_INSTANCE_CLI, "AT");
+        AT_reply_add_string(AT_INSTANCE_CLI, (char_t*) CLI_COMMANDS_LIST[command_id].syntax);
+        if ((CLI_COMMANDS_LIST[command_id].parameters) != NULL) {
+            AT_reply_add_string(AT_INSTANCE_CLI, (char_t*) CLI_COMMANDS_LIST[command_id].parameters);
+        }
+        AT_reply_add_string(AT_INSTANCE_CLI, " = ");
+        AT_reply_add_string(AT_INSTANCE_CLI, (char_t*) CLI_COMMANDS_LIST[command_id].description);
+        AT_send_reply(AT_INSTANCE_CLI);
+    }
+    return AT_SUCCESS;
+}
+
 /*******************************************************************/
 static AT_status_t _CLI_rst_callback(void) {
     // Local variables.
@@ -299,6 +536,242 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+static AT_status_t _CLI_baud_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    CLI_status_t cli_status = CLI_SUCCESS;
+    int32_t baud_rate = 0;
+    // Read baud rate parameter.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &baud_rate);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Check range.
+    if ((baud_rate < TERMINAL_HW_BAUD_RATE_MIN) || (baud_rate > TERMINAL_HW_BAUD_RATE_MAX)) {
+        cli_status = CLI_ERROR_BAUD_RATE;
+    }
+    _CLI_check_driver_status(cli_status, CLI_SUCCESS, ERROR_BASE_CLI);
+    // Switch is performed by the CLI process once the reply is sent.
+    cli_ctx.baud_rate = (uint32_t) baud_rate;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_pat_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    char_t pattern[CLI_PATTERN_LINE_SIZE + 1];
+    int32_t number_of_lines = 0;
+    int32_t line_idx = 0;
+    uint8_t idx = 0;
+    // Read number of lines parameter.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &number_of_lines);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Lines loop: '<index[hex]>:<letters shifted by index>', checked by the host to detect lost bytes.
+    for (line_idx = 0; line_idx < number_of_lines; line_idx++) {
+        for (idx = 0; idx < CLI_PATTERN_LINE_SIZE; idx++) {
+            pattern[idx] = (char_t) ('A' + ((line_idx + idx) % CLI_PATTERN_ALPHABET_SIZE));
+        }
+        pattern[CLI_PATTERN_LINE_SIZE] = STRING_CHAR_NULL;
+        AT_reply_add_integer(AT_INSTANCE_CLI, line_idx, STRING_FORMAT_HEXADECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, ":");
+        AT_reply_add_string(AT_INSTANCE_CLI, pattern);
+        AT_send_reply(AT_INSTANCE_CLI);
+        IWDG_reload();
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_mem_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    RAM_statistics_t ram_statistics;
+    // Read statistics.
+    RAM_get_statistics(&ram_statistics);
+    // Print data.
+    AT_reply_add_string(AT_INSTANCE_CLI, "Static=");
+    AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) ram_statistics.static_size_bytes, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(AT_INSTANCE_CLI, "B Free=");
+    AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) ram_statistics.free_size_bytes, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(AT_INSTANCE_CLI, "B");
+    AT_send_reply(AT_INSTANCE_CLI);
+    AT_reply_add_string(AT_INSTANCE_CLI, "Stack=");
+    AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) ram_statistics.stack_high_water_mark_bytes, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(AT_INSTANCE_CLI, "/");
+    AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) ram_statistics.stack_size_bytes, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(AT_INSTANCE_CLI, (ram_statistics.stack_overflow_flag == 0) ? "B" : "B OVERFLOW");
+    AT_send_reply(AT_INSTANCE_CLI);
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_get_act_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    ACTIVITY_statistics_t statistics;
+    uint8_t idx = 0;
+    // Read statistics.
+    ACTIVITY_get_statistics(&statistics);
+    // Time in state.
+    for (idx = 0; idx < ACTIVITY_get_states_number(); idx++) {
+        AT_reply_add_string(AT_INSTANCE_CLI, (char_t*) ACTIVITY_get_state_name(idx));
+        AT_reply_add_string(AT_INSTANCE_CLI, "=");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) statistics.state_time_ms[idx], STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, "ms");
+        AT_send_reply(AT_INSTANCE_CLI);
+    }
+    // Wake cycles.
+    AT_reply_add_string(AT_INSTANCE_CLI, "Wake=");
+    AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) statistics.wake_count, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(AT_INSTANCE_CLI, " awake=");
+    AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) statistics.awake_time_ms, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(AT_INSTANCE_CLI, "ms");
+    AT_send_reply(AT_INSTANCE_CLI);
+    // Histogram (bin lower bound in ms).
+    for (idx = 0; idx < ACTIVITY_HISTOGRAM_BINS_NUMBER; idx++) {
+        AT_reply_add_string(AT_INSTANCE_CLI, ">=");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (idx == 0) ? 0 : (int32_t) (0b1 << (ACTIVITY_HISTOGRAM_BIN_LOG2 * idx)), STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, "ms: ");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) statistics.wake_histogram[idx], STRING_FORMAT_DECIMAL, 0);
+        AT_send_reply(AT_INSTANCE_CLI);
+    }
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_set_act_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    int32_t value = 0;
+    // Read parameter.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &value);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Only reset is supported.
+    if (value != 0) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto errors;
+    }
+    ACTIVITY_reset();
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_trace_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    const TRACE_ring_t* trace_ring = TRACE_get_ring();
+    const TRACE_record_t* record = NULL;
+    uint32_t index = 0;
+    // Print header.
+    AT_reply_add_string(AT_INSTANCE_CLI, "Boot=");
+    AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (trace_ring -> boot_count), STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(AT_INSTANCE_CLI, " Events=");
+    AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (trace_ring -> index), STRING_FORMAT_DECIMAL, 0);
+    AT_send_reply(AT_INSTANCE_CLI);
+    // Print records: <index>:<timestamp_ms>,<event>,<data_8bits>,<data_16bits>.
+    index = ((trace_ring -> index) > TRACE_DEPTH) ? ((trace_ring -> index) - TRACE_DEPTH) : 0;
+    for (; index < (trace_ring -> index); index++) {
+        IWDG_reload();
+        record = &((trace_ring -> records)[index % TRACE_DEPTH]);
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) index, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, ":");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (record -> timestamp_ms), STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, ",");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (record -> event), STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, ",");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (record -> data_8bits), STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, ",");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (record -> data_16bits), STRING_FORMAT_DECIMAL, 0);
+        AT_send_reply(AT_INSTANCE_CLI);
+    }
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_err_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    const FAULT_entry_t* entry = NULL;
+    uint8_t idx = 0;
+    // Aggregate pending codes.
+    FAULT_collect(RTC_get_uptime_seconds());
+    // Print entries: <code>: <count> [<first_time>;<last_time>]s.
+    for (idx = 0; idx < FAULT_get_entries_number(); idx++) {
+        entry = FAULT_get_entry(idx);
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (entry -> code), STRING_FORMAT_HEXADECIMAL, 1);
+        AT_reply_add_string(AT_INSTANCE_CLI, ": ");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (entry -> count), STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, " [");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (entry -> first_time_seconds), STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, ";");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (entry -> last_time_seconds), STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, "]s");
+        AT_send_reply(AT_INSTANCE_CLI);
+    }
+    AT_reply_add_string(AT_INSTANCE_CLI, "Lost=");
+    AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) FAULT_get_lost_count(), STRING_FORMAT_DECIMAL, 0);
+    AT_send_reply(AT_INSTANCE_CLI);
+    return status;
+}
+
+#ifdef TKFX_PROFILER
+/*******************************************************************/
+static AT_status_t _CLI_get_prof_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PROFILER_statistics_t statistics;
+    uint8_t idx = 0;
+    // Probes loop.
+    for (idx = 0; idx < PROFILER_PROBE_LAST; idx++) {
+        PROFILER_get_statistics(idx, &statistics);
+        // Print data.
+        AT_reply_add_string(AT_INSTANCE_CLI, (char_t*) PROFILER_get_probe_name(idx));
+        AT_reply_add_string(AT_INSTANCE_CLI, ": n=");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) statistics.count, STRING_FORMAT_DECIMAL, 0);
+        if (statistics.count != 0) {
+            AT_reply_add_string(AT_INSTANCE_CLI, " min=");
+            AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) statistics.min_us, STRING_FORMAT_DECIMAL, 0);
+            AT_reply_add_string(AT_INSTANCE_CLI, "us max=");
+            AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) statistics.max_us, STRING_FORMAT_DECIMAL, 0);
+            AT_reply_add_string(AT_INSTANCE_CLI, "us mean=");
+            AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (statistics.total_us / statistics.count), STRING_FORMAT_DECIMAL, 0);
+            AT_reply_add_string(AT_INSTANCE_CLI, "us total=");
+            AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (statistics.total_us / 1000), STRING_FORMAT_DECIMAL, 0);
+            AT_reply_add_string(AT_INSTANCE_CLI, "ms");
+        }
+        AT_send_reply(AT_INSTANCE_CLI);
+    }
+    return status;
+}
+#endif
+
+#ifdef TKFX_PROFILER
+/*******************************************************************/
+static AT_status_t _CLI_set_prof_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    int32_t value = 0;
+    // Read parameter.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &value);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Only reset is supported.
+    if (value != 0) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto errors;
+    }
+    PROFILER_reset();
+errors:
+    return status;
+}
+#endif
+
 #ifdef CLI_COMMAND_NVM
 /*******************************************************************/
 static AT_status_t _CLI_nvm_callback(void) {
@@ -406,6 +879,212 @@ static AT_status_t _CLI_set_ep_key_callback(void) {
 errors:
     return status;
 }
+
+/*******************************************************************/
+static AT_status_t _CLI_prov_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    PROVISIONING_status_t provisioning_status = PROVISIONING_SUCCESS;
+    int32_t baud_rate = 0;
+    // Read baud rate parameter.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &baud_rate);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Reply an error if the baud rate is not supported, the host then proposes a lower one.
+    provisioning_status = PROVISIONING_check_baud_rate((uint32_t) baud_rate);
+    _CLI_check_driver_status(provisioning_status, PROVISIONING_SUCCESS, (ERROR_BASE_CLI + CLI_ERROR_BASE_PROVISIONING));
+    // Session is started by the CLI process once the reply is sent.
+    cli_ctx.provisioning_baud_rate = (uint32_t) baud_rate;
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_COMMAND_MACRO
+/*******************************************************************/
+static AT_status_t _CLI_macro_read_step(uint32_t* address, char_t* step, uint8_t* step_size) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t nvm_byte = 0;
+    // Read step until end of string (address is left on the macro terminator).
+    (*step_size) = 0;
+    while (((*address) + (*step_size)) < CLI_MACRO_SIZE_BYTES) {
+        nvm_status = NVM_read_byte((NVM_address_t) (NVM_ADDRESS_CLI_MACRO + (*address) + (*step_size)), &nvm_byte);
+        _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+        if ((nvm_byte == STRING_CHAR_NULL) || ((*step_size) >= CLI_MACRO_STEP_SIZE_BYTES)) break;
+        step[(*step_size)++] = (char_t) nvm_byte;
+    }
+    step[*step_size] = STRING_CHAR_NULL;
+    if ((*step_size) != 0) {
+        (*address) += ((*step_size) + 1);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_get_mac_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    char_t step[CLI_MACRO_STEP_SIZE_BYTES + 1];
+    uint32_t address = 0;
+    uint8_t step_size = 0;
+    uint8_t step_idx = 0;
+    // Steps loop.
+    while (1) {
+        status = _CLI_macro_read_step(&address, step, &step_size);
+        if ((status != AT_SUCCESS) || (step_size == 0)) break;
+        AT_reply_add_integer(AT_INSTANCE_CLI, step_idx, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, ":");
+        AT_reply_add_string(AT_INSTANCE_CLI, step);
+        AT_send_reply(AT_INSTANCE_CLI);
+        step_idx++;
+    }
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_set_mac_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    CLI_status_t cli_status = CLI_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    PARSER_context_t* parser_ptr = cli_ctx.at_parser_ptr;
+    char_t* step_str = &((parser_ptr -> buffer)[parser_ptr -> start_index]);
+    char_t step[CLI_MACRO_STEP_SIZE_BYTES + 1];
+    uint32_t end_address = 0;
+    uint32_t step_size = 0;
+    uint8_t read_size = 0;
+    uint32_t idx = 0;
+    // Macro can't be modified by one of its steps.
+    if (cli_ctx.macro_running != 0) {
+        cli_status = CLI_ERROR_MACRO_RUNNING;
+    }
+    _CLI_check_driver_status(cli_status, CLI_SUCCESS, ERROR_BASE_CLI);
+    // Step is the raw end of the line since the command may contain its own separators.
+    while ((((parser_ptr -> start_index) + step_size) < (parser_ptr -> buffer_size)) && (step_str[step_size] != STRING_CHAR_NULL)) {
+        step_size++;
+    }
+    // Search macro end.
+    do {
+        status = _CLI_macro_read_step(&end_address, step, &read_size);
+        if (status != AT_SUCCESS) goto errors;
+    }
+    while (read_size != 0);
+    // Check step fits (step, its end of string and the macro terminator).
+    if ((step_size == 0) || (step_size > CLI_MACRO_STEP_SIZE_BYTES) || ((end_address + step_size + 2) > CLI_MACRO_SIZE_BYTES)) {
+        cli_status = CLI_ERROR_MACRO_SIZE;
+    }
+    _CLI_check_driver_status(cli_status, CLI_SUCCESS, ERROR_BASE_CLI);
+    // Write new terminator and step, the first character overwrites the current terminator so it is written last.
+    nvm_status = NVM_write_byte((NVM_address_t) (NVM_ADDRESS_CLI_MACRO + end_address + step_size + 1), STRING_CHAR_NULL);
+    _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    nvm_status = NVM_write_byte((NVM_address_t) (NVM_ADDRESS_CLI_MACRO + end_address + step_size), STRING_CHAR_NULL);
+    _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    for (idx = step_size; idx > 0; idx--) {
+        nvm_status = NVM_write_byte((NVM_address_t) (NVM_ADDRESS_CLI_MACRO + end_address + idx - 1), (uint8_t) step_str[idx - 1]);
+        _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_macr_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_status_t step_status = AT_SUCCESS;
+    CLI_status_t cli_status = CLI_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    PARSER_context_t* at_parser_ptr = cli_ctx.at_parser_ptr;
+    PARSER_context_t step_parser;
+    char_t step[CLI_MACRO_STEP_SIZE_BYTES + 1];
+    uint32_t address = 0;
+    uint32_t macro_start_ms = 0;
+    uint32_t step_start_ms = 0;
+    uint32_t step_duration_ms = 0;
+    uint8_t step_size = 0;
+    uint8_t expect_error = 0;
+    uint8_t step_pass = 0;
+    uint8_t number_of_steps = 0;
+    uint8_t number_of_passed_steps = 0;
+    // Macro can't run itself.
+    if (cli_ctx.macro_running != 0) {
+        ERROR_stack_add((ERROR_code_t) (ERROR_BASE_CLI + CLI_ERROR_MACRO_RUNNING));
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto end;
+    }
+    cli_ctx.macro_running = 1;
+    macro_start_ms = TIMESTAMP_get_milliseconds();
+    // Steps loop.
+    while (1) {
+        status = _CLI_macro_read_step(&address, step, &step_size);
+        if (status != AT_SUCCESS) goto errors;
+        if (step_size == 0) break;
+        // Run step through the command dispatcher with a new parser on the stored line, header matched like the AT driver does.
+        expect_error = (step[0] == CLI_MACRO_EXPECT_ERROR) ? 1 : 0;
+        step_parser.buffer = &(step[expect_error]);
+        step_parser.buffer_size = (uint32_t) (step_size - expect_error);
+        step_parser.start_index = 0;
+        step_parser.separator_index = 0;
+        cli_ctx.at_parser_ptr = &step_parser;
+        step_start_ms = TIMESTAMP_get_milliseconds();
+        parser_status = PARSER_compare(&step_parser, PARSER_MODE_HEADER, (char_t*) CLI_DISPATCH_COMMAND.syntax);
+        step_status = (parser_status == PARSER_SUCCESS) ? _CLI_dispatch_callback() : (AT_status_t) (AT_ERROR_BASE_PARSER + parser_status);
+        step_duration_ms = (TIMESTAMP_get_milliseconds() - step_start_ms);
+        cli_ctx.at_parser_ptr = at_parser_ptr;
+        // Check result.
+        step_pass = (((step_status == AT_SUCCESS) ? 0 : 1) == expect_error) ? 1 : 0;
+        number_of_passed_steps += step_pass;
+        // Print '<step>:<PASS/FAIL>,<status>,<duration>ms'.
+        AT_reply_add_integer(AT_INSTANCE_CLI, number_of_steps, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, (step_pass != 0) ? ":PASS," : ":FAIL,");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) step_status, STRING_FORMAT_HEXADECIMAL, 1);
+        AT_reply_add_string(AT_INSTANCE_CLI, ",");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) step_duration_ms, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, "ms");
+        AT_send_reply(AT_INSTANCE_CLI);
+        number_of_steps++;
+        IWDG_reload();
+    }
+    // Print report.
+    AT_reply_add_string(AT_INSTANCE_CLI, (number_of_passed_steps == number_of_steps) ? "MACRO=PASS," : "MACRO=FAIL,");
+    AT_reply_add_integer(AT_INSTANCE_CLI, number_of_passed_steps, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(AT_INSTANCE_CLI, "/");
+    AT_reply_add_integer(AT_INSTANCE_CLI, number_of_steps, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(AT_INSTANCE_CLI, ",");
+    AT_reply_add_integer(AT_INSTANCE_CLI, (int32_t) (TIMESTAMP_get_milliseconds() - macro_start_ms), STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(AT_INSTANCE_CLI, "ms");
+    AT_send_reply(AT_INSTANCE_CLI);
+    if (number_of_passed_steps != number_of_steps) {
+        cli_status = CLI_ERROR_MACRO_FAILED;
+    }
+    _CLI_check_driver_status(cli_status, CLI_SUCCESS, ERROR_BASE_CLI);
+errors:
+    cli_ctx.at_parser_ptr = at_parser_ptr;
+    cli_ctx.macro_running = 0;
+end:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_macc_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    CLI_status_t cli_status = CLI_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    // Macro can't be modified by one of its steps.
+    if (cli_ctx.macro_running != 0) {
+        cli_status = CLI_ERROR_MACRO_RUNNING;
+    }
+    _CLI_check_driver_status(cli_status, CLI_SUCCESS, ERROR_BASE_CLI);
+    // Empty first step.
+    nvm_status = NVM_write_byte((NVM_address_t) NVM_ADDRESS_CLI_MACRO, STRING_CHAR_NULL);
+    _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+errors:
+    return status;
+}
 #endif
 
 #ifdef CLI_COMMAND_SENSORS
@@ -471,7 +1150,7 @@ static AT_status_t _CLI_ths_callback(void) {
     power_status = POWER_enable(POWER_DOMAIN_SENSORS, LPTIM_DELAY_MODE_SLEEP);
     _CLI_check_driver_status(power_status, POWER_SUCCESS, ERROR_BASE_POWER);
     // Perform measurements.
-    sht3x_status = SHT3X_get_temperature_humidity(I2C_ADDRESS_SHT30, &temperature_degrees, &humidity_percent);
+    sht3x_status = SHT3X_MEASUREMENT_single_shot(I2C_ADDRESS_SHT30, SHT3X_MEASUREMENT_REPEATABILITY_HIGH, 1, &temperature_degrees, &humidity_percent);
     _CLI_check_driver_status(sht3x_status, SHT3X_SUCCESS, ERROR_BASE_SHT30);
     // Turn digital sensors off.
     power_status = POWER_disable(POWER_DOMAIN_SENSORS);
@@ -523,6 +1202,26 @@ errors:
 end:
     return status;
 }
+
+/*******************************************************************/
+static AT_status_t _CLI_strm_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    STREAM_status_t stream_status = STREAM_SUCCESS;
+    int32_t channels_mask = 0;
+    int32_t period_ms = 0;
+    // Read parameters.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_HEXADECIMAL, CLI_CHAR_SEPARATOR, &channels_mask);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &period_ms);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Records are sent by the CLI process after the OK reply.
+    stream_status = STREAM_start((uint8_t) channels_mask, (uint32_t) period_ms);
+    _CLI_check_driver_status(stream_status, STREAM_SUCCESS, (ERROR_BASE_CLI + CLI_ERROR_BASE_STREAM));
+errors:
+    return status;
+}
 #endif
 
 #ifdef CLI_COMMAND_GPS
@@ -949,6 +1648,108 @@ errors:
 end:
     return status;
 }
+
+/*******************************************************************/
+static AT_status_t _CLI_rswp_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    CLI_status_t cli_status = CLI_SUCCESS;
+    RF_API_status_t rf_api_status = RF_API_SUCCESS;
+    S2LP_status_t s2lp_status = S2LP_SUCCESS;
+    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    RF_API_radio_parameters_t radio_params;
+    int32_t start_frequency_hz = 0;
+    int32_t stop_frequency_hz = 0;
+    int32_t step_hz = 0;
+    int32_t number_of_samples = 0;
+    int32_t frequency_hz = 0;
+    int32_t rssi_sum = 0;
+    int16_t rssi_dbm = 0;
+    int16_t rssi_min = 0;
+    int16_t rssi_max = 0;
+    int32_t idx = 0;
+    // Read parameters.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &start_frequency_hz);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &stop_frequency_hz);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &step_hz);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &number_of_samples);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Check sweep bounds.
+    if ((step_hz <= 0) || (stop_frequency_hz < start_frequency_hz) || (((stop_frequency_hz - start_frequency_hz) / step_hz) >= CLI_RSSI_SWEEP_CHANNELS_MAX) ||
+        (number_of_samples <= 0) || (number_of_samples > CLI_RSSI_SWEEP_SAMPLES_MAX)) {
+        cli_status = CLI_ERROR_RSSI_SWEEP;
+    }
+    _CLI_check_driver_status(cli_status, CLI_SUCCESS, ERROR_BASE_CLI);
+    // Radio configuration (full initialization is done once, only the synthesizer is updated at each hop).
+    radio_params.rf_mode = RF_API_MODE_RX;
+    radio_params.frequency_hz = (sfx_u32) start_frequency_hz;
+    radio_params.modulation = RF_API_MODULATION_NONE;
+    radio_params.bit_rate_bps = 0;
+    radio_params.tx_power_dbm_eirp = TX_POWER_DBM_EIRP;
+    radio_params.deviation_hz = 0;
+    // Init radio.
+    rf_api_status = RF_API_wake_up();
+    _CLI_check_driver_status(rf_api_status, RF_API_SUCCESS, (ERROR_BASE_SIGFOX_EP_LIB + (SIGFOX_ERROR_SOURCE_RF_API * ERROR_BASE_STEP)));
+    rf_api_status = RF_API_init(&radio_params);
+    _CLI_check_driver_status(rf_api_status, RF_API_SUCCESS, (ERROR_BASE_SIGFOX_EP_LIB + (SIGFOX_ERROR_SOURCE_RF_API * ERROR_BASE_STEP)));
+    // Channels loop.
+    for (frequency_hz = start_frequency_hz; frequency_hz <= stop_frequency_hz; frequency_hz += step_hz) {
+        // Hop: go back to ready state, update synthesizer and restart listening.
+        s2lp_status = S2LP_send_command(S2LP_COMMAND_SABORT);
+        _CLI_check_driver_status(s2lp_status, S2LP_SUCCESS, ERROR_BASE_S2LP);
+        s2lp_status = S2LP_send_command(S2LP_COMMAND_READY);
+        _CLI_check_driver_status(s2lp_status, S2LP_SUCCESS, ERROR_BASE_S2LP);
+        s2lp_status = S2LP_wait_for_state(S2LP_STATE_READY);
+        _CLI_check_driver_status(s2lp_status, S2LP_SUCCESS, ERROR_BASE_S2LP);
+        s2lp_status = S2LP_set_rf_frequency((sfx_u32) frequency_hz);
+        _CLI_check_driver_status(s2lp_status, S2LP_SUCCESS, ERROR_BASE_S2LP);
+        s2lp_status = S2LP_send_command(S2LP_COMMAND_RX);
+        _CLI_check_driver_status(s2lp_status, S2LP_SUCCESS, ERROR_BASE_S2LP);
+        lptim_status = LPTIM_delay_milliseconds(CLI_RSSI_SWEEP_SETTLE_MS, LPTIM_DELAY_MODE_ACTIVE);
+        _CLI_check_driver_status(lptim_status, LPTIM_SUCCESS, ERROR_BASE_LPTIM);
+        // Samples loop.
+        rssi_sum = 0;
+        for (idx = 0; idx < number_of_samples; idx++) {
+            s2lp_status = S2LP_get_rssi(S2LP_RSSI_TYPE_RUN, &rssi_dbm);
+            _CLI_check_driver_status(s2lp_status, S2LP_SUCCESS, ERROR_BASE_S2LP);
+            rssi_sum += rssi_dbm;
+            if ((idx == 0) || (rssi_dbm < rssi_min)) {
+                rssi_min = rssi_dbm;
+            }
+            if ((idx == 0) || (rssi_dbm > rssi_max)) {
+                rssi_max = rssi_dbm;
+            }
+            lptim_status = LPTIM_delay_milliseconds(CLI_RSSI_SWEEP_SAMPLE_PERIOD_MS, LPTIM_DELAY_MODE_ACTIVE);
+            _CLI_check_driver_status(lptim_status, LPTIM_SUCCESS, ERROR_BASE_LPTIM);
+        }
+        // Print '<frequency>:<min>,<max>,<mean>' (the DMA sends the line during the next hop).
+        AT_reply_add_integer(AT_INSTANCE_CLI, frequency_hz, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, ":");
+        AT_reply_add_integer(AT_INSTANCE_CLI, rssi_min, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, ",");
+        AT_reply_add_integer(AT_INSTANCE_CLI, rssi_max, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(AT_INSTANCE_CLI, ",");
+        AT_reply_add_integer(AT_INSTANCE_CLI, (rssi_sum / number_of_samples), STRING_FORMAT_DECIMAL, 0);
+        AT_send_reply(AT_INSTANCE_CLI);
+        // Reload watchdog.
+        IWDG_reload();
+    }
+    // Turn radio off.
+    rf_api_status = RF_API_de_init();
+    _CLI_check_driver_status(rf_api_status, RF_API_SUCCESS, (ERROR_BASE_SIGFOX_EP_LIB + (SIGFOX_ERROR_SOURCE_RF_API * ERROR_BASE_STEP)));
+    rf_api_status = RF_API_sleep();
+    _CLI_check_driver_status(rf_api_status, RF_API_SUCCESS, (ERROR_BASE_SIGFOX_EP_LIB + (SIGFOX_ERROR_SOURCE_RF_API * ERROR_BASE_STEP)));
+    goto end;
+errors:
+    RF_API_de_init();
+    RF_API_sleep();
+end:
+    return status;
+}
 #endif
 
 /*** CLI functions ***/
@@ -958,18 +1759,19 @@ CLI_status_t CLI_init(void) {
     // Local variables.
     CLI_status_t status = CLI_SUCCESS;
     AT_status_t at_status = AT_SUCCESS;
-    uint8_t idx = 0;
     // Init context.
     cli_ctx.at_process_flag = 0;
     cli_ctx.at_parser_ptr = NULL;
+    cli_ctx.baud_rate = 0;
+#ifdef CLI_COMMAND_NVM
+    cli_ctx.provisioning_baud_rate = 0;
+#endif
     // Init AT driver.
     at_status = AT_init(AT_INSTANCE_CLI, TERMINAL_INSTANCE_CLI, &_CLI_at_process_callback, &(cli_ctx.at_parser_ptr));
     AT_exit_error(CLI_ERROR_BASE_AT);
-    // Register commands.
-    for (idx = 0; idx < (sizeof(CLI_COMMANDS_LIST) / sizeof(AT_command_t)); idx++) {
-        at_status = AT_register_command(AT_INSTANCE_CLI, &(CLI_COMMANDS_LIST[idx]));
-        AT_exit_error(CLI_ERROR_BASE_AT);
-    }
+    // Register dispatcher.
+    at_status = AT_register_command(AT_INSTANCE_CLI, &CLI_DISPATCH_COMMAND);
+    AT_exit_error(CLI_ERROR_BASE_AT);
 errors:
     return status;
 }
@@ -979,12 +1781,9 @@ CLI_status_t CLI_de_init(void) {
     // Local variables.
     CLI_status_t status = CLI_SUCCESS;
     AT_status_t at_status = AT_SUCCESS;
-    uint8_t idx = 0;
-    // Unregister commands.
-    for (idx = 0; idx < (sizeof(CLI_COMMANDS_LIST) / sizeof(AT_command_t)); idx++) {
-        at_status = AT_unregister_command(AT_INSTANCE_CLI, &(CLI_COMMANDS_LIST[idx]));
-        AT_exit_error(CLI_ERROR_BASE_AT);
-    }
+    // Unregister dispatcher.
+    at_status = AT_unregister_command(AT_INSTANCE_CLI, &CLI_DISPATCH_COMMAND);
+    AT_exit_error(CLI_ERROR_BASE_AT);
     // Release AT driver.
     at_status = AT_de_init(AT_INSTANCE_CLI);
     AT_exit_error(CLI_ERROR_BASE_AT);
@@ -997,14 +1796,82 @@ CLI_status_t CLI_process(void) {
     // Local variables.
     CLI_status_t status = CLI_SUCCESS;
     AT_status_t at_status = AT_SUCCESS;
+    uint32_t baud_rate = 0;
+#ifdef CLI_COMMAND_NVM
+    PROVISIONING_status_t provisioning_status = PROVISIONING_SUCCESS;
+    OVERLAY_status_t overlay_status = OVERLAY_SUCCESS;
+    OVERLAY_t* overlay = NULL;
+#endif
+#ifdef CLI_COMMAND_SENSORS
+    STREAM_status_t stream_status = STREAM_SUCCESS;
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    uint8_t record[STREAM_RECORD_SIZE_MAX_BYTES];
+    uint8_t record_size = 0;
+#endif
     // Check process flag.
     if (cli_ctx.at_process_flag != 0) {
         // Clear flag.
         cli_ctx.at_process_flag = 0;
+#ifdef CLI_COMMAND_SENSORS
+        // Any received command stops streaming.
+        if (STREAM_is_running() != 0) {
+            stream_status = STREAM_stop();
+            STREAM_exit_error(CLI_ERROR_BASE_STREAM);
+        }
+#endif
         // Process AT driver.
         at_status = AT_process(AT_INSTANCE_CLI);
         AT_exit_error(CLI_ERROR_BASE_AT);
     }
+    // Check baud rate switch request.
+    if (cli_ctx.baud_rate != 0) {
+        baud_rate = cli_ctx.baud_rate;
+        // Release terminal (pending replies are sent at the current baud rate) and restart it at the new one.
+        status = CLI_de_init();
+        if (status != CLI_SUCCESS) goto errors;
+        TERMINAL_HW_set_baud_rate(baud_rate);
+        status = CLI_init();
+        if (status != CLI_SUCCESS) goto errors;
+    }
+#ifdef CLI_COMMAND_NVM
+    // Check provisioning request.
+    if (cli_ctx.provisioning_baud_rate != 0) {
+        baud_rate = cli_ctx.provisioning_baud_rate;
+        // Let the OK reply leave the terminal before releasing it.
+        LPTIM_delay_milliseconds(CLI_PROVISIONING_SWITCH_DELAY_MS, LPTIM_DELAY_MODE_ACTIVE);
+        status = CLI_de_init();
+        if (status != CLI_SUCCESS) goto errors;
+        // The request frame is received in the working buffers.
+        overlay_status = OVERLAY_acquire(OVERLAY_PHASE_CLI, &overlay);
+        if (overlay_status == OVERLAY_SUCCESS) {
+            provisioning_status = PROVISIONING_process(baud_rate, (overlay -> cli).provisioning_request);
+            overlay_status = OVERLAY_release(OVERLAY_PHASE_CLI);
+        }
+        // Restart AT driver in any case.
+        status = CLI_init();
+        if (status != CLI_SUCCESS) goto errors;
+        OVERLAY_exit_error(CLI_ERROR_BASE_OVERLAY);
+        PROVISIONING_exit_error(CLI_ERROR_BASE_PROVISIONING);
+    }
+#endif
+#ifdef CLI_COMMAND_SENSORS
+    // Stream records until a command is received (the process sleeps by short steps).
+    while ((STREAM_is_running() != 0) && (cli_ctx.at_process_flag == 0)) {
+        stream_status = STREAM_process(record, &record_size);
+        IWDG_reload();
+        if (stream_status != STREAM_SUCCESS) {
+            STREAM_stop();
+            STREAM_exit_error(CLI_ERROR_BASE_STREAM);
+        }
+        if (record_size == 0) continue;
+        // Queue the raw record behind the last AT reply: the DMA sends one terminal buffer while the next record is sampled.
+        terminal_status = TERMINAL_HW_write(TERMINAL_INSTANCE_CLI, record, record_size);
+        if (terminal_status != TERMINAL_SUCCESS) {
+            STREAM_stop();
+            TERMINAL_exit_error(CLI_ERROR_BASE_TERMINAL);
+        }
+    }
+#endif
 errors:
     return status;
 }
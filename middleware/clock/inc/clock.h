@@ -0,0 +1,106 @@
+/*
+ * clock.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __CLOCK_H__
+#define __CLOCK_H__
+
+#include "rcc.h"
+#include "types.h"
+
+/*** CLOCK macros ***/
+
+// Profile switch latency estimates (datasheet worst case: regulator settling and oscillator start-up, not measured).
+#define CLOCK_SWITCH_LATENCY_ESTIMATE_US_HIGH_PERFORMANCE   150
+#define CLOCK_SWITCH_LATENCY_ESTIMATE_US_LOW_POWER          60
+
+/*** CLOCK structures ***/
+
+/*!******************************************************************
+ * \enum CLOCK_status_t
+ * \brief CLOCK driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    CLOCK_SUCCESS,
+    CLOCK_ERROR_NULL_PARAMETER,
+    CLOCK_ERROR_PROFILE,
+    CLOCK_ERROR_VOLTAGE_RANGE_TIMEOUT,
+    // Low level drivers errors.
+    CLOCK_ERROR_BASE_RCC = 0x0100,
+    // Last base value.
+    CLOCK_ERROR_BASE_LAST = (CLOCK_ERROR_BASE_RCC + RCC_ERROR_BASE_LAST)
+} CLOCK_status_t;
+
+/*!******************************************************************
+ * \enum CLOCK_profile_t
+ * \brief Clock and core voltage profiles.
+ *******************************************************************/
+typedef enum {
+    CLOCK_PROFILE_HIGH_PERFORMANCE = 0,
+    CLOCK_PROFILE_LOW_POWER,
+    CLOCK_PROFILE_LAST
+} CLOCK_profile_t;
+
+/*!******************************************************************
+ * \struct CLOCK_statistics_t
+ * \brief Profile switches statistics (the latency is the sum of the datasheet estimates of each switch).
+ *******************************************************************/
+typedef struct {
+    uint32_t switch_count[CLOCK_PROFILE_LAST];
+    uint32_t switch_latency_estimate_us;
+} CLOCK_statistics_t;
+
+/*** CLOCK functions ***/
+
+/*!******************************************************************
+ * \fn void CLOCK_init(void)
+ * \brief Init clock policy (the system is assumed to run on HSI16 in voltage range 1).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void CLOCK_init(void);
+
+/*!******************************************************************
+ * \fn CLOCK_status_t CLOCK_set_profile(CLOCK_profile_t profile)
+ * \brief Switch system clock and core voltage range.
+ * \brief High performance: HSI16 in range 1 (radio, GPS, sensors and ADC).
+ * \brief Low power: MSI in range 3 (bookkeeping states), wake-up from stop mode on MSI.
+ * \param[in]   profile: Profile to apply.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+CLOCK_status_t CLOCK_set_profile(CLOCK_profile_t profile);
+
+/*!******************************************************************
+ * \fn CLOCK_profile_t CLOCK_get_profile(void)
+ * \brief Get current profile.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Current profile.
+ *******************************************************************/
+CLOCK_profile_t CLOCK_get_profile(void);
+
+/*!******************************************************************
+ * \fn CLOCK_status_t CLOCK_get_statistics(CLOCK_statistics_t* statistics)
+ * \brief Get profile switches statistics.
+ * \param[in]   none
+ * \param[out]  statistics: Pointer to the statistics structure.
+ * \retval      Function execution status.
+ *******************************************************************/
+CLOCK_status_t CLOCK_get_statistics(CLOCK_statistics_t* statistics);
+
+/*******************************************************************/
+#define CLOCK_exit_error(base) { ERROR_check_exit(clock_status, CLOCK_SUCCESS, base) }
+
+/*******************************************************************/
+#define CLOCK_stack_error(base) { ERROR_check_stack(clock_status, CLOCK_SUCCESS, base) }
+
+/*******************************************************************/
+#define CLOCK_stack_exit_error(base, code) { ERROR_check_stack_exit(clock_status, CLOCK_SUCCESS, base, code) }
+
+#endif /* __CLOCK_H__ */
@@ -0,0 +1,146 @@
+/*
+ * clock.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "clock.h"
+
+#include "error.h"
+#include "profiler.h"
+#include "pwr_reg.h"
+#include "rcc.h"
+#include "rcc_reg.h"
+#include "types.h"
+
+/*** CLOCK local macros ***/
+
+#define CLOCK_PWR_CR_VOS_MASK           (0b11 << 11)
+#define CLOCK_PWR_CR_VOS_RANGE_1        (0b01 << 11)
+#define CLOCK_PWR_CR_VOS_RANGE_3        (0b11 << 11)
+#define CLOCK_PWR_CSR_VOSF              (0b1 << 4)
+
+#define CLOCK_RCC_CFGR_STOPWUCK         (0b1 << 15)
+
+#define CLOCK_VOLTAGE_RANGE_TIMEOUT     100000
+
+#define CLOCK_LOW_POWER_MSI_RANGE       RCC_MSI_RANGE_5_2MHZ
+
+/*** CLOCK local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    CLOCK_profile_t profile;
+    CLOCK_statistics_t statistics;
+} CLOCK_context_t;
+
+/*** CLOCK local global variables ***/
+
+static CLOCK_context_t clock_ctx;
+
+/*** CLOCK local functions ***/
+
+/*******************************************************************/
+static CLOCK_status_t _CLOCK_set_voltage_range(uint32_t vos) {
+    // Local variables.
+    CLOCK_status_t status = CLOCK_SUCCESS;
+    uint32_t loop_count = 0;
+    // Wait for regulator to be ready.
+    while (((PWR -> CSR) & CLOCK_PWR_CSR_VOSF) != 0) {
+        loop_count++;
+        if (loop_count > CLOCK_VOLTAGE_RANGE_TIMEOUT) {
+            status = CLOCK_ERROR_VOLTAGE_RANGE_TIMEOUT;
+            goto errors;
+        }
+    }
+    // Update range.
+    PWR -> CR = ((PWR -> CR) & ~(CLOCK_PWR_CR_VOS_MASK)) | vos;
+    // Wait for new range to be applied.
+    loop_count = 0;
+    while (((PWR -> CSR) & CLOCK_PWR_CSR_VOSF) != 0) {
+        loop_count++;
+        if (loop_count > CLOCK_VOLTAGE_RANGE_TIMEOUT) {
+            status = CLOCK_ERROR_VOLTAGE_RANGE_TIMEOUT;
+            goto errors;
+        }
+    }
+errors:
+    return status;
+}
+
+/*** CLOCK functions ***/
+
+/*******************************************************************/
+void CLOCK_init(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Init context.
+    clock_ctx.profile = CLOCK_PROFILE_HIGH_PERFORMANCE;
+    for (idx = 0; idx < CLOCK_PROFILE_LAST; idx++) {
+        clock_ctx.statistics.switch_count[idx] = 0;
+    }
+    clock_ctx.statistics.switch_latency_estimate_us = 0;
+}
+
+/*******************************************************************/
+CLOCK_status_t CLOCK_set_profile(CLOCK_profile_t profile) {
+    // Local variables.
+    CLOCK_status_t status = CLOCK_SUCCESS;
+    RCC_status_t rcc_status = RCC_SUCCESS;
+    // Check current profile.
+    if (profile == clock_ctx.profile) goto errors;
+    // Check profile.
+    switch (profile) {
+    case CLOCK_PROFILE_HIGH_PERFORMANCE:
+        // Increase core voltage before frequency.
+        status = _CLOCK_set_voltage_range(CLOCK_PWR_CR_VOS_RANGE_1);
+        if (status != CLOCK_SUCCESS) goto errors;
+        rcc_status = RCC_switch_to_hsi();
+        RCC_exit_error(CLOCK_ERROR_BASE_RCC);
+        // Wake-up from stop mode on HSI16.
+        RCC -> CFGR |= CLOCK_RCC_CFGR_STOPWUCK;
+        clock_ctx.statistics.switch_latency_estimate_us += CLOCK_SWITCH_LATENCY_ESTIMATE_US_HIGH_PERFORMANCE;
+        break;
+    case CLOCK_PROFILE_LOW_POWER:
+        // Decrease frequency before core voltage.
+        rcc_status = RCC_switch_to_msi(CLOCK_LOW_POWER_MSI_RANGE);
+        RCC_exit_error(CLOCK_ERROR_BASE_RCC);
+        // Wake-up from stop mode on MSI to stay within range 3 limits.
+        RCC -> CFGR &= ~(CLOCK_RCC_CFGR_STOPWUCK);
+        status = _CLOCK_set_voltage_range(CLOCK_PWR_CR_VOS_RANGE_3);
+        if (status != CLOCK_SUCCESS) goto errors;
+        clock_ctx.statistics.switch_latency_estimate_us += CLOCK_SWITCH_LATENCY_ESTIMATE_US_LOW_POWER;
+        break;
+    default:
+        status = CLOCK_ERROR_PROFILE;
+        goto errors;
+    }
+    // Keep profiling time base in microseconds.
+    PROFILER_UPDATE_CLOCK();
+    // Update context.
+    clock_ctx.profile = profile;
+    clock_ctx.statistics.switch_count[profile]++;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+CLOCK_profile_t CLOCK_get_profile(void) {
+    return (clock_ctx.profile);
+}
+
+/*******************************************************************/
+CLOCK_status_t CLOCK_get_statistics(CLOCK_statistics_t* statistics) {
+    // Local variables.
+    CLOCK_status_t status = CLOCK_SUCCESS;
+    // Check parameter.
+    if (statistics == NULL) {
+        status = CLOCK_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Copy statistics.
+    (*statistics) = clock_ctx.statistics;
+errors:
+    return status;
+}
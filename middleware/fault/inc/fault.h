@@ -0,0 +1,112 @@
+/*
+ * fault.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __FAULT_H__
+#define __FAULT_H__
+
+#include "error.h"
+#include "types.h"
+
+/*** FAULT macros ***/
+
+// Number of distinct error codes kept between two uplinks.
+#define FAULT_TABLE_SIZE                12
+
+/*
+ * Uplink encoding (bit stream, MSB first, zero padded):
+ *   header  4 bits: overflow flag (1) + number of entries left for the next frame (3, saturated).
+ *   entry  21 bits: '0' + code (16) + count (4).
+ *          13 bits: '1' + code offset (8) + count (4), when the code has the same base (high byte) as the previous entry.
+ * Count (4 bits): 0 to 7 for 1 to 8 occurrences, n >= 8 for [2^(n-5)+1, 2^(n-4)] occurrences (15 saturated).
+ * Entries are sorted by code. A full entry with code 0 (SUCCESS) ends the stream.
+ */
+#define FAULT_HEADER_SIZE_BITS          4
+#define FAULT_TAG_SIZE_BITS             1
+#define FAULT_CODE_SIZE_BITS            16
+#define FAULT_OFFSET_SIZE_BITS          8
+#define FAULT_COUNT_SIZE_BITS           4
+
+/*** FAULT structures ***/
+
+/*!******************************************************************
+ * \struct FAULT_entry_t
+ * \brief Aggregated error code.
+ *******************************************************************/
+typedef struct {
+    ERROR_code_t code;
+    uint16_t count;
+    uint32_t first_time_seconds;
+    uint32_t last_time_seconds;
+} FAULT_entry_t;
+
+/*** FAULT functions ***/
+
+/*!******************************************************************
+ * \fn void FAULT_init(void)
+ * \brief Init error aggregation table.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void FAULT_init(void);
+
+/*!******************************************************************
+ * \fn void FAULT_collect(uint32_t time_seconds)
+ * \brief Move all codes of the error stack into the aggregation table.
+ * \param[in]   time_seconds: Current time.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void FAULT_collect(uint32_t time_seconds);
+
+/*!******************************************************************
+ * \fn void FAULT_add(ERROR_code_t code, uint32_t time_seconds)
+ * \brief Add an error code occurrence to the aggregation table.
+ * \param[in]   code: Error code.
+ * \param[in]   time_seconds: Occurrence time.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void FAULT_add(ERROR_code_t code, uint32_t time_seconds);
+
+/*!******************************************************************
+ * \fn uint8_t FAULT_encode(uint8_t* frame, uint8_t frame_size_bytes)
+ * \brief Encode as many entries as possible in an uplink frame and remove them from the table.
+ * \param[in]   frame_size_bytes: Frame size in bytes.
+ * \param[out]  frame: Frame buffer.
+ * \retval      Number of encoded entries.
+ *******************************************************************/
+uint8_t FAULT_encode(uint8_t* frame, uint8_t frame_size_bytes);
+
+/*!******************************************************************
+ * \fn uint8_t FAULT_get_entries_number(void)
+ * \brief Get the number of distinct codes in the table.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Number of entries.
+ *******************************************************************/
+uint8_t FAULT_get_entries_number(void);
+
+/*!******************************************************************
+ * \fn const FAULT_entry_t* FAULT_get_entry(uint8_t idx)
+ * \brief Get an entry of the table (sorted by code).
+ * \param[in]   idx: Entry index.
+ * \param[out]  none
+ * \retval      Pointer to the entry, NULL if the index is out of range.
+ *******************************************************************/
+const FAULT_entry_t* FAULT_get_entry(uint8_t idx);
+
+/*!******************************************************************
+ * \fn uint32_t FAULT_get_lost_count(void)
+ * \brief Get the number of occurrences lost because the table was full.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Number of lost occurrences.
+ *******************************************************************/
+uint32_t FAULT_get_lost_count(void);
+
+#endif /* __FAULT_H__ */
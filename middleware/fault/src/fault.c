@@ -0,0 +1,184 @@
+/*
+ * fault.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "fault.h"
+
+#include "error.h"
+#include "types.h"
+
+/*** FAULT local macros ***/
+
+#define FAULT_COUNT_MAX                 0xFFFF
+#define FAULT_COUNT_EXACT_MAX           8
+#define FAULT_COUNT_CODE_MAX            ((0b1 << FAULT_COUNT_SIZE_BITS) - 1)
+#define FAULT_HEADER_REMAINING_MAX      0b111
+#define FAULT_FULL_ENTRY_SIZE_BITS      (FAULT_TAG_SIZE_BITS + FAULT_CODE_SIZE_BITS + FAULT_COUNT_SIZE_BITS)
+#define FAULT_OFFSET_ENTRY_SIZE_BITS    (FAULT_TAG_SIZE_BITS + FAULT_OFFSET_SIZE_BITS + FAULT_COUNT_SIZE_BITS)
+
+/*** FAULT local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    FAULT_entry_t table[FAULT_TABLE_SIZE];
+    uint8_t entries_number;
+    uint32_t lost_count;
+} FAULT_context_t;
+
+/*** FAULT local global variables ***/
+
+static FAULT_context_t fault_ctx;
+
+/*** FAULT local functions ***/
+
+/*******************************************************************/
+static uint8_t _FAULT_encode_count(uint16_t count) {
+    // Local variables.
+    uint8_t count_code = FAULT_COUNT_EXACT_MAX;
+    uint32_t limit = (FAULT_COUNT_EXACT_MAX << 1);
+    // Exact values.
+    if (count <= FAULT_COUNT_EXACT_MAX) {
+        return ((count == 0) ? 0 : (uint8_t) (count - 1));
+    }
+    // Logarithmic ranges.
+    while ((count > limit) && (count_code < FAULT_COUNT_CODE_MAX)) {
+        limit <<= 1;
+        count_code++;
+    }
+    return count_code;
+}
+
+/*******************************************************************/
+static void _FAULT_write_bits(uint8_t* frame, uint16_t* bit_idx, uint32_t value, uint8_t size_bits) {
+    // Local variables.
+    uint8_t idx = 0;
+    // MSB first.
+    for (idx = size_bits; idx > 0; idx--) {
+        if (((value >> (idx - 1)) & 0b1) != 0) {
+            frame[(*bit_idx) >> 3] |= (0b1 << (7 - ((*bit_idx) & 0b111)));
+        }
+        (*bit_idx)++;
+    }
+}
+
+/*** FAULT functions ***/
+
+/*******************************************************************/
+void FAULT_init(void) {
+    // Reset table.
+    fault_ctx.entries_number = 0;
+    fault_ctx.lost_count = 0;
+}
+
+/*******************************************************************/
+void FAULT_collect(uint32_t time_seconds) {
+    // Empty error stack.
+    while (ERROR_stack_is_empty() == 0) {
+        FAULT_add(ERROR_stack_read(), time_seconds);
+    }
+}
+
+/*******************************************************************/
+void FAULT_add(ERROR_code_t code, uint32_t time_seconds) {
+    // Local variables.
+    uint8_t idx = 0;
+    uint8_t insert_idx = 0;
+    // Ignore success code.
+    if (code == 0) return;
+    // Search code (table is sorted).
+    for (idx = 0; idx < fault_ctx.entries_number; idx++) {
+        if (fault_ctx.table[idx].code == code) {
+            // Merge occurrence.
+            if (fault_ctx.table[idx].count < FAULT_COUNT_MAX) {
+                fault_ctx.table[idx].count++;
+            }
+            fault_ctx.table[idx].last_time_seconds = time_seconds;
+            return;
+        }
+        if (fault_ctx.table[idx].code > code) break;
+    }
+    // Check space.
+    if (fault_ctx.entries_number >= FAULT_TABLE_SIZE) {
+        fault_ctx.lost_count++;
+        return;
+    }
+    // Insert new code.
+    insert_idx = idx;
+    for (idx = fault_ctx.entries_number; idx > insert_idx; idx--) {
+        fault_ctx.table[idx] = fault_ctx.table[idx - 1];
+    }
+    fault_ctx.table[insert_idx].code = code;
+    fault_ctx.table[insert_idx].count = 1;
+    fault_ctx.table[insert_idx].first_time_seconds = time_seconds;
+    fault_ctx.table[insert_idx].last_time_seconds = time_seconds;
+    fault_ctx.entries_number++;
+}
+
+/*******************************************************************/
+uint8_t FAULT_encode(uint8_t* frame, uint8_t frame_size_bytes) {
+    // Local variables.
+    uint16_t frame_size_bits = (uint16_t) (frame_size_bytes << 3);
+    uint16_t bit_idx = FAULT_HEADER_SIZE_BITS;
+    uint8_t encoded_number = 0;
+    uint8_t remaining_number = 0;
+    uint8_t idx = 0;
+    uint8_t previous_valid = 0;
+    ERROR_code_t previous_code = 0;
+    ERROR_code_t code = 0;
+    // Check parameter.
+    if (frame == NULL) return 0;
+    // Reset frame.
+    for (idx = 0; idx < frame_size_bytes; idx++) {
+        frame[idx] = 0;
+    }
+    // Entries loop.
+    for (idx = 0; idx < fault_ctx.entries_number; idx++) {
+        code = fault_ctx.table[idx].code;
+        if ((previous_valid != 0) && ((code >> FAULT_OFFSET_SIZE_BITS) == (previous_code >> FAULT_OFFSET_SIZE_BITS))) {
+            // Same base as previous entry.
+            if ((bit_idx + FAULT_OFFSET_ENTRY_SIZE_BITS) > frame_size_bits) break;
+            _FAULT_write_bits(frame, &bit_idx, 0b1, FAULT_TAG_SIZE_BITS);
+            _FAULT_write_bits(frame, &bit_idx, (code & ((0b1 << FAULT_OFFSET_SIZE_BITS) - 1)), FAULT_OFFSET_SIZE_BITS);
+        }
+        else {
+            // Full code.
+            if ((bit_idx + FAULT_FULL_ENTRY_SIZE_BITS) > frame_size_bits) break;
+            _FAULT_write_bits(frame, &bit_idx, 0b0, FAULT_TAG_SIZE_BITS);
+            _FAULT_write_bits(frame, &bit_idx, code, FAULT_CODE_SIZE_BITS);
+        }
+        _FAULT_write_bits(frame, &bit_idx, _FAULT_encode_count(fault_ctx.table[idx].count), FAULT_COUNT_SIZE_BITS);
+        previous_code = code;
+        previous_valid = 1;
+    }
+    encoded_number = idx;
+    // Remove encoded entries.
+    remaining_number = (uint8_t) (fault_ctx.entries_number - encoded_number);
+    for (idx = 0; idx < remaining_number; idx++) {
+        fault_ctx.table[idx] = fault_ctx.table[idx + encoded_number];
+    }
+    fault_ctx.entries_number = remaining_number;
+    // Header.
+    bit_idx = 0;
+    _FAULT_write_bits(frame, &bit_idx, ((fault_ctx.lost_count != 0) ? 0b1 : 0b0), 1);
+    _FAULT_write_bits(frame, &bit_idx, ((remaining_number > FAULT_HEADER_REMAINING_MAX) ? FAULT_HEADER_REMAINING_MAX : remaining_number), (FAULT_HEADER_SIZE_BITS - 1));
+    fault_ctx.lost_count = 0;
+    return encoded_number;
+}
+
+/*******************************************************************/
+uint8_t FAULT_get_entries_number(void) {
+    return (fault_ctx.entries_number);
+}
+
+/*******************************************************************/
+const FAULT_entry_t* FAULT_get_entry(uint8_t idx) {
+    return ((idx < fault_ctx.entries_number) ? &(fault_ctx.table[idx]) : NULL);
+}
+
+/*******************************************************************/
+uint32_t FAULT_get_lost_count(void) {
+    return (fault_ctx.lost_count);
+}
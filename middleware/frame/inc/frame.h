@@ -0,0 +1,56 @@
+/*
+ * frame.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __FRAME_H__
+#define __FRAME_H__
+
+#include "types.h"
+
+/*** FRAME macros ***/
+
+// Fields list generators, to be used with the TKFX_SIGFOX_<FRAME>_FIELDS(FIELD) layouts of tkfx_frames.h.
+#define FRAME_FIELD_SIZE(name, size_bits)   size_bits,
+#define FRAME_FIELD_VALUE(name, size_bits)  uint32_t name;
+// Maximum size of a field.
+#define FRAME_FIELD_SIZE_BITS_MAX           32
+
+/*** FRAME functions ***/
+
+/*!******************************************************************
+ * \fn void FRAME_pack(uint8_t* frame, const uint8_t* fields_size_bits, uint8_t number_of_fields, const uint32_t* fields_value)
+ * \brief Pack fields in a big endian bit stream (MSB first, last byte zero padded).
+ * \param[in]   fields_size_bits: Size of each field in bits (1 to FRAME_FIELD_SIZE_BITS_MAX).
+ * \param[in]   number_of_fields: Number of fields.
+ * \param[in]   fields_value: Value of each field, truncated to its size.
+ * \param[out]  frame: Output buffer, all bytes covered by the fields are written.
+ * \retval      none
+ *******************************************************************/
+void FRAME_pack(uint8_t* frame, const uint8_t* fields_size_bits, uint8_t number_of_fields, const uint32_t* fields_value);
+
+/*!******************************************************************
+ * \fn uint32_t FRAME_quantize(uint32_t value, uint32_t full_scale, uint8_t size_bits)
+ * \brief Scale a value to a field code (rounded to nearest, saturated), with 32 bits arithmetic only.
+ * \param[in]   value: Value to encode (0 to full_scale).
+ * \param[in]   full_scale: Value corresponding to the code 2^size_bits.
+ * \param[in]   size_bits: Field size in bits (1 to FRAME_FIELD_SIZE_BITS_MAX).
+ * \param[out]  none
+ * \retval      round(value * 2^size_bits / full_scale), at most 2^size_bits - 1.
+ *******************************************************************/
+uint32_t FRAME_quantize(uint32_t value, uint32_t full_scale, uint8_t size_bits);
+
+/*!******************************************************************
+ * \fn uint32_t FRAME_quantize_wrap(uint32_t value, uint32_t full_scale, uint8_t size_bits)
+ * \brief Scale a cyclic value (such as an angle) to a field code (rounded to nearest, modulo 2^size_bits), with 32 bits arithmetic only.
+ * \param[in]   value: Value to encode (0 to 2 * full_scale - 1, reduced modulo full_scale).
+ * \param[in]   full_scale: Value corresponding to one full cycle.
+ * \param[in]   size_bits: Field size in bits (1 to FRAME_FIELD_SIZE_BITS_MAX).
+ * \param[out]  none
+ * \retval      round(value * 2^size_bits / full_scale) modulo 2^size_bits.
+ *******************************************************************/
+uint32_t FRAME_quantize_wrap(uint32_t value, uint32_t full_scale, uint8_t size_bits);
+
+#endif /* __FRAME_H__ */
@@ -0,0 +1,109 @@
+/*
+ * frame.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "frame.h"
+
+#include "types.h"
+
+/*** FRAME local macros ***/
+
+// Largest chunk pushed at once in the 32 bits accumulator (which holds at most 7 pending bits before a push).
+#define FRAME_CHUNK_SIZE_BITS_MAX   24
+
+/*** FRAME local functions ***/
+
+/*******************************************************************/
+static uint32_t _FRAME_divide(uint32_t value, uint32_t full_scale, uint8_t size_bits, uint8_t* round_up_flag) {
+    // Local variables.
+    uint32_t code = 0;
+    uint32_t remainder = value;
+    uint32_t carry = 0;
+    uint8_t idx = 0;
+    // Long division of (value * 2^size_bits) by full_scale (value lower than full_scale), one quotient bit per step so that all terms fit in 32 bits.
+    for (idx = 0; idx < size_bits; idx++) {
+        // The remainder is lower than full scale, so that a shifted out bit always means remainder >= full_scale.
+        carry = (remainder >> 31);
+        remainder <<= 1;
+        code <<= 1;
+        if ((carry != 0) || (remainder >= full_scale)) {
+            remainder -= full_scale;
+            code |= 0b1;
+        }
+    }
+    // Round to nearest (2 * remainder >= full_scale).
+    (*round_up_flag) = (remainder >= (full_scale - remainder)) ? 1 : 0;
+    return code;
+}
+
+/*** FRAME functions ***/
+
+/*******************************************************************/
+void FRAME_pack(uint8_t* frame, const uint8_t* fields_size_bits, uint8_t number_of_fields, const uint32_t* fields_value) {
+    // Local variables.
+    uint32_t accumulator = 0;
+    uint32_t value = 0;
+    uint8_t pending_bits = 0;
+    uint8_t size_bits = 0;
+    uint8_t chunk_bits = 0;
+    uint8_t idx = 0;
+    // Fields loop.
+    for (idx = 0; idx < number_of_fields; idx++) {
+        value = fields_value[idx];
+        size_bits = fields_size_bits[idx];
+        // Fields larger than the accumulator free space are pushed in chunks.
+        while (size_bits > 0) {
+            chunk_bits = (size_bits > FRAME_CHUNK_SIZE_BITS_MAX) ? FRAME_CHUNK_SIZE_BITS_MAX : size_bits;
+            size_bits -= chunk_bits;
+            accumulator = (accumulator << chunk_bits) | ((value >> size_bits) & ((0b1UL << chunk_bits) - 1));
+            pending_bits += chunk_bits;
+            // Flush complete bytes.
+            while (pending_bits >= 8) {
+                pending_bits -= 8;
+                (*(frame++)) = (uint8_t) (accumulator >> pending_bits);
+            }
+        }
+    }
+    // Last partial byte.
+    if (pending_bits != 0) {
+        (*frame) = (uint8_t) (accumulator << (8 - pending_bits));
+    }
+}
+
+/*******************************************************************/
+uint32_t FRAME_quantize(uint32_t value, uint32_t full_scale, uint8_t size_bits) {
+    // Local variables.
+    uint32_t code = 0;
+    uint32_t code_max = (size_bits >= 32) ? 0xFFFFFFFF : ((0b1UL << size_bits) - 1);
+    uint8_t round_up_flag = 0;
+    // Saturate the full scale.
+    if (value >= full_scale) {
+        code = code_max;
+        goto end;
+    }
+    code = _FRAME_divide(value, full_scale, size_bits, &round_up_flag);
+    if ((round_up_flag != 0) && (code < code_max)) {
+        code++;
+    }
+end:
+    return code;
+}
+
+/*******************************************************************/
+uint32_t FRAME_quantize_wrap(uint32_t value, uint32_t full_scale, uint8_t size_bits) {
+    // Local variables.
+    uint32_t code = 0;
+    uint32_t code_max = (size_bits >= 32) ? 0xFFFFFFFF : ((0b1UL << size_bits) - 1);
+    uint8_t round_up_flag = 0;
+    // Reduce modulo full scale.
+    if (value >= full_scale) {
+        value -= full_scale;
+    }
+    code = _FRAME_divide(value, full_scale, size_bits, &round_up_flag);
+    // A code rounded up to 2^size_bits wraps to 0.
+    code = (code + round_up_flag) & code_max;
+    return code;
+}
@@ -10,6 +10,7 @@
 
 #include "analog.h"
 #include "neom8x.h"
+#include "overlay.h"
 #include "types.h"
 
 /*** GPS structures ***/
@@ -25,8 +26,9 @@ typedef enum {
     // Low level drivers errors.
     GPS_ERROR_BASE_NEOM8N = 0x0100,
     GPS_ERROR_BASE_ANALOG = (GPS_ERROR_BASE_NEOM8N + NEOM8X_ERROR_BASE_LAST),
+    GPS_ERROR_BASE_OVERLAY = (GPS_ERROR_BASE_ANALOG + ANALOG_ERROR_BASE_LAST),
     // Last base value.
-    GPS_ERROR_BASE_LAST = (GPS_ERROR_BASE_ANALOG + ANALOG_ERROR_BASE_LAST),
+    GPS_ERROR_BASE_LAST = (GPS_ERROR_BASE_OVERLAY + OVERLAY_ERROR_BASE_LAST),
 } GPS_status_t;
 
 /*!******************************************************************
@@ -10,7 +10,10 @@
 #include "analog.h"
 #include "error.h"
 #include "iwdg.h"
+#include "marker.h"
 #include "neom8x.h"
+#include "overlay.h"
+#include "profiler.h"
 #include "pwr.h"
 #include "rtc.h"
 #include "tkfx_flags.h"
@@ -74,6 +77,8 @@ GPS_status_t GPS_get_position(GPS_position_t* gps_position, uint8_t altitude_sta
     GPS_status_t status = GPS_SUCCESS;
     NEOM8X_status_t neom8x_status = NEOM8X_SUCCESS;
     ANALOG_status_t analog_status = ANALOG_SUCCESS;
+    OVERLAY_status_t overlay_status = OVERLAY_SUCCESS;
+    OVERLAY_t* overlay = NULL;
     NEOM8X_acquisition_t gps_acquisition;
     NEOM8X_acquisition_status_t expected_status = (altitude_stability_threshold == 0) ? NEOM8X_ACQUISITION_STATUS_FOUND : NEOM8X_ACQUISITION_STATUS_STABLE;
     uint32_t start_time = RTC_get_uptime_seconds();
@@ -83,10 +88,14 @@ GPS_status_t GPS_get_position(GPS_position_t* gps_position, uint8_t altitude_sta
         status = GPS_ERROR_NULL_PARAMETER;
         goto errors;
     }
+    MARKER_PHASE(MARKER_PHASE_GPS_ACQUISITION);
     // Reset output data.
     (*acquisition_duration_seconds) = 0;
     (*acquisition_status) = GPS_ACQUISITION_ERROR_TIMEOUT;
     gps_ctx.acquisition_status = NEOM8X_ACQUISITION_STATUS_FAIL;
+    // Own the working buffers during acquisition (the NMEA buffers are inside the driver).
+    overlay_status = OVERLAY_acquire(OVERLAY_PHASE_GPS, &overlay);
+    OVERLAY_exit_error(GPS_ERROR_BASE_OVERLAY);
     // Configure GPS acquisition.
     gps_acquisition.gps_data = NEOM8X_GPS_DATA_POSITION;
     gps_acquisition.completion_callback = &_GPS_completion_callback;
@@ -105,7 +114,9 @@ GPS_status_t GPS_get_position(GPS_position_t* gps_position, uint8_t altitude_sta
         // Check flag.
         if (gps_ctx.process_flag != 0) {
             // Process driver.
+            PROFILER_START(PROFILER_PROBE_GPS_PROCESS);
             neom8x_status = NEOM8X_process();
+            PROFILER_STOP(PROFILER_PROBE_GPS_PROCESS);
             NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
             // Check VSTR voltage.
             analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_VSTR_MV, &vstr_voltage_mv);
@@ -131,6 +142,8 @@ GPS_status_t GPS_get_position(GPS_position_t* gps_position, uint8_t altitude_sta
     }
 errors:
     NEOM8X_stop_acquisition();
+    OVERLAY_release(OVERLAY_PHASE_GPS);
+    MARKER_PHASE(MARKER_PHASE_GPS_END);
     return status;
 }
 
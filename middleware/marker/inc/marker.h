@@ -0,0 +1,76 @@
+/*
+ * marker.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __MARKER_H__
+#define __MARKER_H__
+
+#include "tkfx_flags.h"
+#include "types.h"
+
+/*** MARKER macros ***/
+
+// Pulse code of a state is (state + 1), pulse code of a sub-phase is (MARKER_PHASE_CODE_OFFSET + phase).
+#define MARKER_PHASE_CODE_OFFSET    16
+
+/*** MARKER structures ***/
+
+/*!******************************************************************
+ * \enum MARKER_phase_t
+ * \brief Radio and GPS sub-phases (a phase ending with _END closes the current sub-phase).
+ *******************************************************************/
+typedef enum {
+    MARKER_PHASE_RF_WAKE_UP = 0,
+    MARKER_PHASE_RF_TX,
+    MARKER_PHASE_RF_RX,
+    MARKER_PHASE_RF_IDLE,
+    MARKER_PHASE_RF_END,
+    MARKER_PHASE_GPS_ACQUISITION,
+    MARKER_PHASE_GPS_END,
+    MARKER_PHASE_LAST
+} MARKER_phase_t;
+
+/*** MARKER functions ***/
+
+#ifdef TKFX_MARKERS
+/*!******************************************************************
+ * \fn void MARKER_init(void)
+ * \brief Configure TP2 as marker output and start the SysTick counter used to time the pulses.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void MARKER_init(void);
+
+/*!******************************************************************
+ * \fn void MARKER_state(uint8_t state)
+ * \brief Emit a state pulse code if the state changed since the last call.
+ * \param[in]   state: Current application state.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void MARKER_state(uint8_t state);
+
+/*!******************************************************************
+ * \fn void MARKER_phase(MARKER_phase_t phase)
+ * \brief Emit a sub-phase pulse code.
+ * \param[in]   phase: Sub-phase entered.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void MARKER_phase(MARKER_phase_t phase);
+#endif
+
+/*******************************************************************/
+#ifdef TKFX_MARKERS
+#define MARKER_STATE(state) { MARKER_state(state); }
+#define MARKER_PHASE(phase) { MARKER_phase(phase); }
+#else
+#define MARKER_STATE(state) {}
+#define MARKER_PHASE(phase) {}
+#endif
+
+#endif /* __MARKER_H__ */
@@ -0,0 +1,117 @@
+/*
+ * marker.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "marker.h"
+
+#include "gpio.h"
+#include "gpio_mapping.h"
+#include "rcc.h"
+#include "tkfx_flags.h"
+#include "types.h"
+
+#ifdef TKFX_MARKERS
+
+/*** MARKER local macros ***/
+
+// Pulse width and guard time, timed with the SysTick counter so that they do not depend on the system clock.
+#define MARKER_PULSE_US         2
+#define MARKER_GUARD_US         250
+#define MARKER_STATE_NONE       0xFF
+#define MARKER_DEFAULT_CLOCK_HZ 16000000
+
+// SysTick registers (Cortex-M0+ core, not part of the peripheral register map).
+#define MARKER_SYST_CSR         (*((volatile uint32_t*) 0xE000E010))
+#define MARKER_SYST_RVR         (*((volatile uint32_t*) 0xE000E014))
+#define MARKER_SYST_CVR         (*((volatile uint32_t*) 0xE000E018))
+#define MARKER_SYST_CSR_ENABLE  (0b1 << 0)
+#define MARKER_SYST_CSR_CLKSRC  (0b1 << 2)
+#define MARKER_SYST_MASK        0x00FFFFFF
+
+/*** MARKER local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint8_t state;
+    uint32_t ticks_per_ms;
+} MARKER_context_t;
+
+/*** MARKER local global variables ***/
+
+static MARKER_context_t marker_ctx = {
+    .state = MARKER_STATE_NONE,
+    .ticks_per_ms = (MARKER_DEFAULT_CLOCK_HZ / 1000)
+};
+
+/*** MARKER local functions ***/
+
+/*******************************************************************/
+static void _MARKER_wait_us(uint32_t delay_us) {
+    // Local variables.
+    uint32_t ticks = ((marker_ctx.ticks_per_ms * delay_us) / 1000);
+    uint32_t start = MARKER_SYST_CVR;
+    // Down counter elapsed ticks (modulo 2^24).
+    if (ticks == 0) {
+        ticks = 1;
+    }
+    while (((start - MARKER_SYST_CVR) & MARKER_SYST_MASK) < ticks);
+}
+
+/*******************************************************************/
+static void _MARKER_send(uint8_t code) {
+    // Local variables.
+    uint32_t primask = 0;
+    uint32_t clock_hz = MARKER_DEFAULT_CLOCK_HZ;
+    uint8_t idx = 0;
+    // Update time base (the system clock may have been switched since the last code).
+    if (RCC_get_frequency_hz(RCC_CLOCK_SYSTEM, &clock_hz) != RCC_SUCCESS) {
+        clock_hz = MARKER_DEFAULT_CLOCK_HZ;
+    }
+    marker_ctx.ticks_per_ms = (clock_hz / 1000);
+    // Interrupts would stretch the gaps between pulses.
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) : : "memory");
+    for (idx = 0; idx < code; idx++) {
+        GPIO_write(&GPIO_TP2, 1);
+        _MARKER_wait_us(MARKER_PULSE_US);
+        GPIO_write(&GPIO_TP2, 0);
+        _MARKER_wait_us(MARKER_PULSE_US);
+    }
+    __asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+    // Guard time to separate consecutive codes (interrupts enabled, it can only be stretched).
+    _MARKER_wait_us(MARKER_GUARD_US);
+}
+
+/*** MARKER functions ***/
+
+/*******************************************************************/
+void MARKER_init(void) {
+    // Configure test point.
+    GPIO_configure(&GPIO_TP2, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
+    GPIO_write(&GPIO_TP2, 0);
+    marker_ctx.state = MARKER_STATE_NONE;
+    // Free-running SysTick on the processor clock, without interrupt.
+    MARKER_SYST_CSR = 0;
+    MARKER_SYST_RVR = MARKER_SYST_MASK;
+    MARKER_SYST_CVR = 0;
+    MARKER_SYST_CSR = (MARKER_SYST_CSR_CLKSRC | MARKER_SYST_CSR_ENABLE);
+}
+
+/*******************************************************************/
+void MARKER_state(uint8_t state) {
+    // Check change.
+    if (state == marker_ctx.state) return;
+    marker_ctx.state = state;
+    _MARKER_send((uint8_t) (state + 1));
+}
+
+/*******************************************************************/
+void MARKER_phase(MARKER_phase_t phase) {
+    // Check parameter.
+    if (phase >= MARKER_PHASE_LAST) return;
+    _MARKER_send((uint8_t) (MARKER_PHASE_CODE_OFFSET + phase));
+}
+
+#endif /* TKFX_MARKERS */
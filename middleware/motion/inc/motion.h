@@ -0,0 +1,77 @@
+/*
+ * motion.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __MOTION_H__
+#define __MOTION_H__
+
+#include "types.h"
+
+/*** MOTION macros ***/
+
+#define MOTION_BUCKET_UNITS_PER_EVENT   1000
+
+/*** MOTION structures ***/
+
+/*!******************************************************************
+ * \struct MOTION_bucket_configuration_t
+ * \brief Leaky bucket start detector parameters.
+ *******************************************************************/
+typedef struct {
+    uint32_t fill_per_event;
+    uint32_t leak_per_second;
+    uint32_t start_threshold;
+    uint32_t capacity;
+} MOTION_bucket_configuration_t;
+
+/*** MOTION functions ***/
+
+/*!******************************************************************
+ * \fn void MOTION_init(const MOTION_bucket_configuration_t* configuration)
+ * \brief Init motion start detector.
+ * \param[in]   configuration: Pointer to the leaky bucket parameters.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void MOTION_init(const MOTION_bucket_configuration_t* configuration);
+
+/*!******************************************************************
+ * \fn void MOTION_reset(void)
+ * \brief Empty the leaky bucket.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void MOTION_reset(void);
+
+/*!******************************************************************
+ * \fn void MOTION_add_event(uint32_t timestamp_ms)
+ * \brief Add a motion event to the leaky bucket (can be called under interrupt).
+ * \param[in]   timestamp_ms: Event timestamp in milliseconds.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void MOTION_add_event(uint32_t timestamp_ms);
+
+/*!******************************************************************
+ * \fn uint32_t MOTION_get_level(uint32_t timestamp_ms)
+ * \brief Get the leaky bucket level after applying the leak up to the given time.
+ * \param[in]   timestamp_ms: Current timestamp in milliseconds.
+ * \param[out]  none
+ * \retval      Bucket level in MOTION_BUCKET_UNITS_PER_EVENT units.
+ *******************************************************************/
+uint32_t MOTION_get_level(uint32_t timestamp_ms);
+
+/*!******************************************************************
+ * \fn uint8_t MOTION_is_start_detected(uint32_t timestamp_ms)
+ * \brief Check if the bucket level is above the start threshold.
+ * \param[in]   timestamp_ms: Current timestamp in milliseconds.
+ * \param[out]  none
+ * \retval      1 if the start condition is met, 0 otherwise.
+ *******************************************************************/
+uint8_t MOTION_is_start_detected(uint32_t timestamp_ms);
+
+#endif /* __MOTION_H__ */
@@ -0,0 +1,124 @@
+/*
+ * motion.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "motion.h"
+
+#include "ramfunc.h"
+#include "types.h"
+
+/*** MOTION local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    const MOTION_bucket_configuration_t* configuration;
+    volatile uint32_t level;
+    volatile uint32_t last_update_ms;
+} MOTION_context_t;
+
+/*** MOTION local global variables ***/
+
+static MOTION_context_t motion_ctx = {
+    .configuration = NULL,
+    .level = 0,
+    .last_update_ms = 0
+};
+
+/*** MOTION local functions ***/
+
+#ifdef __arm__
+/*******************************************************************/
+#define _MOTION_enter_critical_section(primask) { __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) : : "memory"); }
+
+/*******************************************************************/
+#define _MOTION_exit_critical_section(primask) { __asm volatile ("msr primask, %0" : : "r" (primask) : "memory"); }
+#else
+// Host build (script/tkfx_motion_replay.py): no interrupt to mask.
+#define _MOTION_enter_critical_section(primask) { (void) (primask); }
+#define _MOTION_exit_critical_section(primask) { (void) (primask); }
+#endif
+
+/*******************************************************************/
+static RAMFUNC void _MOTION_leak(uint32_t timestamp_ms) {
+    // Local variables.
+    uint32_t elapsed_ms = (timestamp_ms - motion_ctx.last_update_ms);
+    uint32_t leak_per_second = (motion_ctx.configuration -> leak_per_second);
+    uint32_t leak = 0;
+    uint32_t consumed_ms = 0;
+    // Check parameters.
+    if ((leak_per_second == 0) || (motion_ctx.level == 0)) {
+        motion_ctx.last_update_ms = timestamp_ms;
+        return;
+    }
+    // Saturate on long gaps (also avoids multiplication overflow).
+    if (elapsed_ms >= ((motion_ctx.level / leak_per_second) + 1) * 1000) {
+        motion_ctx.level = 0;
+        motion_ctx.last_update_ms = timestamp_ms;
+        return;
+    }
+    leak = ((elapsed_ms * leak_per_second) / 1000);
+    if (leak == 0) return;
+    // Only advance the reference by the time actually consumed to avoid cumulative truncation.
+    consumed_ms = ((leak * 1000) / leak_per_second);
+    motion_ctx.last_update_ms += consumed_ms;
+    motion_ctx.level = (leak >= motion_ctx.level) ? 0 : (motion_ctx.level - leak);
+}
+
+/*** MOTION functions ***/
+
+/*******************************************************************/
+void MOTION_init(const MOTION_bucket_configuration_t* configuration) {
+    // Store configuration.
+    motion_ctx.configuration = configuration;
+    MOTION_reset();
+}
+
+/*******************************************************************/
+void MOTION_reset(void) {
+    // Local variables.
+    uint32_t primask = 0;
+    // Empty bucket.
+    _MOTION_enter_critical_section(primask);
+    motion_ctx.level = 0;
+    _MOTION_exit_critical_section(primask);
+}
+
+/*******************************************************************/
+RAMFUNC void MOTION_add_event(uint32_t timestamp_ms) {
+    // Local variables.
+    uint32_t primask = 0;
+    uint32_t level = 0;
+    // Check configuration.
+    if (motion_ctx.configuration == NULL) return;
+    _MOTION_enter_critical_section(primask);
+    // Apply leak then fill.
+    _MOTION_leak(timestamp_ms);
+    level = (motion_ctx.level + (motion_ctx.configuration -> fill_per_event));
+    motion_ctx.level = (level > (motion_ctx.configuration -> capacity)) ? (motion_ctx.configuration -> capacity) : level;
+    _MOTION_exit_critical_section(primask);
+}
+
+/*******************************************************************/
+uint32_t MOTION_get_level(uint32_t timestamp_ms) {
+    // Local variables.
+    uint32_t primask = 0;
+    uint32_t level = 0;
+    // Check configuration.
+    if (motion_ctx.configuration == NULL) return 0;
+    _MOTION_enter_critical_section(primask);
+    _MOTION_leak(timestamp_ms);
+    level = motion_ctx.level;
+    _MOTION_exit_critical_section(primask);
+    return level;
+}
+
+/*******************************************************************/
+uint8_t MOTION_is_start_detected(uint32_t timestamp_ms) {
+    // Local variables.
+    uint32_t level = MOTION_get_level(timestamp_ms);
+    // Compare to threshold.
+    return ((motion_ctx.configuration != NULL) && (level > (motion_ctx.configuration -> start_threshold))) ? 1 : 0;
+}
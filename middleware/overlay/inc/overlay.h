@@ -0,0 +1,129 @@
+/*
+ * overlay.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __OVERLAY_H__
+#define __OVERLAY_H__
+
+#ifdef USE_SIGFOX_EP_FLAGS_H
+#include "sigfox_ep_flags.h"
+#endif
+#include "sigfox_types.h"
+#include "provisioning.h"
+#include "tkfx_flags.h"
+#include "types.h"
+
+/*** OVERLAY macros ***/
+
+// S2LP FIFO buffer: deviation and PA output power for each of the 40 samples of a symbol profile.
+#define OVERLAY_RADIO_FIFO_BUFFER_SIZE_BYTES    80
+
+/*** OVERLAY structures ***/
+
+/*!******************************************************************
+ * \enum OVERLAY_status_t
+ * \brief OVERLAY driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    OVERLAY_SUCCESS,
+    OVERLAY_ERROR_NULL_PARAMETER,
+    OVERLAY_ERROR_PHASE,
+    OVERLAY_ERROR_BUSY,
+    OVERLAY_ERROR_NOT_OWNER,
+    // Last base value.
+    OVERLAY_ERROR_BASE_LAST = 0x0100
+} OVERLAY_status_t;
+
+/*!******************************************************************
+ * \enum OVERLAY_phase_t
+ * \brief Mutually exclusive phases sharing the working buffers.
+ *******************************************************************/
+typedef enum {
+    OVERLAY_PHASE_NONE = 0,
+    OVERLAY_PHASE_GPS,
+    OVERLAY_PHASE_RADIO,
+    OVERLAY_PHASE_CLI,
+    OVERLAY_PHASE_LAST
+} OVERLAY_phase_t;
+
+/*!******************************************************************
+ * \struct OVERLAY_radio_t
+ * \brief Radio phase working buffers (RF API).
+ *******************************************************************/
+typedef struct {
+    uint8_t symbol_fifo_buffer[OVERLAY_RADIO_FIFO_BUFFER_SIZE_BYTES];
+    uint8_t ramp_fifo_buffer[OVERLAY_RADIO_FIFO_BUFFER_SIZE_BYTES];
+    uint8_t tx_bitstream[SIGFOX_UL_BITSTREAM_SIZE_BYTES];
+#ifdef BIDIRECTIONAL
+    uint8_t dl_phy_content[SIGFOX_DL_PHY_CONTENT_SIZE_BYTES];
+#endif
+} OVERLAY_radio_t;
+
+#ifdef TKFX_MODE_CLI
+/*!******************************************************************
+ * \struct OVERLAY_cli_t
+ * \brief CLI phase working buffers.
+ *******************************************************************/
+typedef struct {
+    uint8_t provisioning_request[PROVISIONING_REQUEST_SIZE_BYTES];
+} OVERLAY_cli_t;
+#endif
+
+/*!******************************************************************
+ * \union OVERLAY_t
+ * \brief Working buffers of all phases, overlaid in the same RAM area.
+ * \brief The GPS phase has no member: the NMEA buffers are static inside the NEO-M8x driver.
+ * \brief It still owns the area during acquisitions so that no other phase can run concurrently.
+ *******************************************************************/
+typedef union {
+    OVERLAY_radio_t radio;
+#ifdef TKFX_MODE_CLI
+    OVERLAY_cli_t cli;
+#endif
+} OVERLAY_t;
+
+/*** OVERLAY functions ***/
+
+/*!******************************************************************
+ * \fn OVERLAY_status_t OVERLAY_acquire(OVERLAY_phase_t phase, OVERLAY_t** overlay)
+ * \brief Give the working buffers to a phase.
+ * \brief The function fails if another phase (or the same one) already owns them.
+ * \param[in]   phase: Phase requesting the buffers.
+ * \param[out]  overlay: Pointer to the working buffers, valid until the phase releases them.
+ * \retval      Function execution status.
+ *******************************************************************/
+OVERLAY_status_t OVERLAY_acquire(OVERLAY_phase_t phase, OVERLAY_t** overlay);
+
+/*!******************************************************************
+ * \fn OVERLAY_status_t OVERLAY_release(OVERLAY_phase_t phase)
+ * \brief Release the working buffers.
+ * \brief The function fails if the phase does not own them.
+ * \param[in]   phase: Phase owning the buffers.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+OVERLAY_status_t OVERLAY_release(OVERLAY_phase_t phase);
+
+/*!******************************************************************
+ * \fn OVERLAY_phase_t OVERLAY_get_owner(void)
+ * \brief Get the phase currently owning the working buffers.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Current owner.
+ *******************************************************************/
+OVERLAY_phase_t OVERLAY_get_owner(void);
+
+/*******************************************************************/
+#define OVERLAY_exit_error(base) { ERROR_check_exit(overlay_status, OVERLAY_SUCCESS, base) }
+
+/*******************************************************************/
+#define OVERLAY_stack_error(base) { ERROR_check_stack(overlay_status, OVERLAY_SUCCESS, base) }
+
+/*******************************************************************/
+#define OVERLAY_stack_exit_error(base, code) { ERROR_check_stack_exit(overlay_status, OVERLAY_SUCCESS, base, code) }
+
+#endif /* __OVERLAY_H__ */
@@ -0,0 +1,84 @@
+/*
+ * overlay.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "overlay.h"
+
+#include "tkfx_flags.h"
+#include "types.h"
+
+/*** OVERLAY local macros ***/
+
+#define OVERLAY_POISON_VALUE    0xA5
+
+/*** OVERLAY local global variables ***/
+
+static OVERLAY_t overlay_buffer;
+static OVERLAY_phase_t overlay_owner = OVERLAY_PHASE_NONE;
+
+/*** OVERLAY local functions ***/
+
+#ifdef TKFX_MODE_DEBUG
+/*******************************************************************/
+static void _OVERLAY_poison(void) {
+    // Local variables.
+    uint8_t* buffer = (uint8_t*) &overlay_buffer;
+    uint16_t idx = 0;
+    // Fill buffers with a known pattern to expose accesses after release.
+    for (idx = 0; idx < sizeof(OVERLAY_t); idx++) {
+        buffer[idx] = OVERLAY_POISON_VALUE;
+    }
+}
+#endif
+
+/*** OVERLAY functions ***/
+
+/*******************************************************************/
+OVERLAY_status_t OVERLAY_acquire(OVERLAY_phase_t phase, OVERLAY_t** overlay) {
+    // Local variables.
+    OVERLAY_status_t status = OVERLAY_SUCCESS;
+    // Check parameters.
+    if (overlay == NULL) {
+        status = OVERLAY_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*overlay) = NULL;
+    if ((phase == OVERLAY_PHASE_NONE) || (phase >= OVERLAY_PHASE_LAST)) {
+        status = OVERLAY_ERROR_PHASE;
+        goto errors;
+    }
+    // Phases are mutually exclusive.
+    if (overlay_owner != OVERLAY_PHASE_NONE) {
+        status = OVERLAY_ERROR_BUSY;
+        goto errors;
+    }
+    overlay_owner = phase;
+    (*overlay) = &overlay_buffer;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+OVERLAY_status_t OVERLAY_release(OVERLAY_phase_t phase) {
+    // Local variables.
+    OVERLAY_status_t status = OVERLAY_SUCCESS;
+    // Check owner.
+    if ((phase == OVERLAY_PHASE_NONE) || (phase != overlay_owner)) {
+        status = OVERLAY_ERROR_NOT_OWNER;
+        goto errors;
+    }
+#ifdef TKFX_MODE_DEBUG
+    _OVERLAY_poison();
+#endif
+    overlay_owner = OVERLAY_PHASE_NONE;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+OVERLAY_phase_t OVERLAY_get_owner(void) {
+    return overlay_owner;
+}
@@ -15,6 +15,7 @@
 #include "gpio_mapping.h"
 #include "s2lp.h"
 #include "sht3x.h"
+#include "trace.h"
 #include "types.h"
 
 /*** POWER local global variables ***/
@@ -96,6 +97,9 @@ POWER_status_t POWER_enable(POWER_domain_t domain, LPTIM_delay_mode_t delay_mode
         goto errors;
     }
     // Update state.
+    if (power_domain_state[domain] == 0) {
+        TRACE_add(TRACE_EVENT_POWER, (uint8_t) domain, 1);
+    }
     power_domain_state[domain] = 1;
     // Power on delay.
     if (delay_ms != 0) {
@@ -156,6 +160,9 @@ POWER_status_t POWER_disable(POWER_domain_t domain) {
         goto errors;
     }
     // Update state.
+    if (power_domain_state[domain] != 0) {
+        TRACE_add(TRACE_EVENT_POWER, (uint8_t) domain, 0);
+    }
     power_domain_state[domain] = 0;
 errors:
     return status;
@@ -0,0 +1,119 @@
+/*
+ * profiler.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include "tkfx_flags.h"
+#include "types.h"
+
+/*** PROFILER structures ***/
+
+/*!******************************************************************
+ * \enum PROFILER_probe_t
+ * \brief Profiling probes list.
+ *******************************************************************/
+typedef enum {
+    PROFILER_PROBE_STATE_MACHINE = 0,
+    PROFILER_PROBE_RF_API_SEND,
+    PROFILER_PROBE_RF_API_PROCESS,
+    PROFILER_PROBE_GPS_PROCESS,
+    PROFILER_PROBE_ANALOG_CONVERSION,
+    PROFILER_PROBE_LAST
+} PROFILER_probe_t;
+
+/*!******************************************************************
+ * \struct PROFILER_statistics_t
+ * \brief Probe execution time statistics.
+ *******************************************************************/
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t total_us;
+} PROFILER_statistics_t;
+
+/*** PROFILER functions ***/
+
+#ifdef TKFX_PROFILER
+/*!******************************************************************
+ * \fn void PROFILER_init(void)
+ * \brief Start profiling time base (TIM22 on system clock, microsecond resolution).
+ * \brief Time spent in stop mode is not counted since the timer clock is off.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void PROFILER_init(void);
+
+/*!******************************************************************
+ * \fn void PROFILER_update_clock(void)
+ * \brief Update time base prescaler after a system clock switch.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void PROFILER_update_clock(void);
+
+/*!******************************************************************
+ * \fn void PROFILER_start(PROFILER_probe_t probe)
+ * \brief Start a probe measurement.
+ * \param[in]   probe: Probe to start.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void PROFILER_start(PROFILER_probe_t probe);
+
+/*!******************************************************************
+ * \fn void PROFILER_stop(PROFILER_probe_t probe)
+ * \brief Stop a probe measurement and update its statistics.
+ * \param[in]   probe: Probe to stop.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void PROFILER_stop(PROFILER_probe_t probe);
+
+/*!******************************************************************
+ * \fn void PROFILER_reset(void)
+ * \brief Reset all probes statistics.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void PROFILER_reset(void);
+
+/*!******************************************************************
+ * \fn void PROFILER_get_statistics(PROFILER_probe_t probe, PROFILER_statistics_t* statistics)
+ * \brief Get probe statistics.
+ * \param[in]   probe: Probe to read.
+ * \param[out]  statistics: Pointer to the statistics structure.
+ * \retval      none
+ *******************************************************************/
+void PROFILER_get_statistics(PROFILER_probe_t probe, PROFILER_statistics_t* statistics);
+
+/*!******************************************************************
+ * \fn const char_t* PROFILER_get_probe_name(PROFILER_probe_t probe)
+ * \brief Get probe name.
+ * \param[in]   probe: Probe to read.
+ * \param[out]  none
+ * \retval      Probe name.
+ *******************************************************************/
+const char_t* PROFILER_get_probe_name(PROFILER_probe_t probe);
+#endif
+
+/*******************************************************************/
+#ifdef TKFX_PROFILER
+#define PROFILER_START(probe) { PROFILER_start(probe); }
+#define PROFILER_STOP(probe) { PROFILER_stop(probe); }
+#define PROFILER_UPDATE_CLOCK() { PROFILER_update_clock(); }
+#else
+#define PROFILER_START(probe) {}
+#define PROFILER_STOP(probe) {}
+#define PROFILER_UPDATE_CLOCK() {}
+#endif
+
+#endif /* __PROFILER_H__ */
@@ -0,0 +1,208 @@
+/*
+ * profiler.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "profiler.h"
+
+#include "nvic.h"
+#include "nvic_priority.h"
+#include "rcc.h"
+#include "rcc_reg.h"
+#include "tim_reg.h"
+#include "tkfx_flags.h"
+#include "types.h"
+
+#ifdef TKFX_PROFILER
+
+/*** PROFILER local macros ***/
+
+#define PROFILER_RCC_APB2ENR_TIM22EN    (0b1 << 5)
+
+#define PROFILER_TIM_CR1_CEN            (0b1 << 0)
+#define PROFILER_TIM_CR1_URS            (0b1 << 2)
+#define PROFILER_TIM_DIER_UIE           (0b1 << 0)
+#define PROFILER_TIM_SR_UIF             (0b1 << 0)
+#define PROFILER_TIM_EGR_UG             (0b1 << 0)
+#define PROFILER_TIM_ARR_MAX            0xFFFF
+
+#define PROFILER_TICK_FREQUENCY_HZ      1000000
+#define PROFILER_DEFAULT_CLOCK_HZ       16000000
+
+/*** PROFILER local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t start_us;
+    uint8_t running;
+    PROFILER_statistics_t statistics;
+} PROFILER_probe_context_t;
+
+/*******************************************************************/
+typedef struct {
+    volatile uint32_t base_us;
+    uint32_t tick_ns;
+    uint32_t wrap_us;
+    PROFILER_probe_context_t probes[PROFILER_PROBE_LAST];
+} PROFILER_context_t;
+
+/*** PROFILER local global variables ***/
+
+static const char_t* PROFILER_PROBE_NAME[PROFILER_PROBE_LAST] = {
+    "STATE_MACHINE",
+    "RF_API_SEND",
+    "RF_API_PROCESS",
+    "GPS_PROCESS",
+    "ANALOG_CONVERSION"
+};
+
+static PROFILER_context_t profiler_ctx;
+
+/*** PROFILER local functions ***/
+
+/*******************************************************************/
+void TIM22_IRQHandler(void) {
+    // Extend counter (the flag may already have been handled by the time read function).
+    if (((TIM22 -> SR) & PROFILER_TIM_SR_UIF) != 0) {
+        // Status flags are rc_w0: writing 1 leaves the other flags untouched (no read-modify-write race).
+        TIM22 -> SR = ~(PROFILER_TIM_SR_UIF);
+        profiler_ctx.base_us += profiler_ctx.wrap_us;
+    }
+}
+
+/*******************************************************************/
+static uint32_t _PROFILER_get_time_us(void) {
+    // Local variables.
+    uint32_t primask = 0;
+    uint32_t counter = 0;
+    uint32_t time_us = 0;
+    // Enter critical section.
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) : : "memory");
+    counter = (TIM22 -> CNT);
+    // Handle pending overflow.
+    if (((TIM22 -> SR) & PROFILER_TIM_SR_UIF) != 0) {
+        counter = (TIM22 -> CNT);
+        TIM22 -> SR = ~(PROFILER_TIM_SR_UIF);
+        profiler_ctx.base_us += profiler_ctx.wrap_us;
+    }
+    time_us = profiler_ctx.base_us + ((counter * profiler_ctx.tick_ns) / 1000);
+    // Exit critical section.
+    __asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+    return time_us;
+}
+
+/*******************************************************************/
+static void _PROFILER_set_prescaler(void) {
+    // Local variables.
+    uint32_t clock_hz = PROFILER_DEFAULT_CLOCK_HZ;
+    uint32_t divider = 0;
+    // Read system clock.
+    if (RCC_get_frequency_hz(RCC_CLOCK_SYSTEM, &clock_hz) != RCC_SUCCESS) {
+        clock_hz = PROFILER_DEFAULT_CLOCK_HZ;
+    }
+    // Closest divider to 1MHz.
+    divider = ((clock_hz + (PROFILER_TICK_FREQUENCY_HZ >> 1)) / PROFILER_TICK_FREQUENCY_HZ);
+    if (divider == 0) {
+        divider = 1;
+    }
+    profiler_ctx.tick_ns = ((divider * 1000000) / (clock_hz / 1000));
+    profiler_ctx.wrap_us = (((PROFILER_TIM_ARR_MAX + 1) * profiler_ctx.tick_ns) / 1000);
+    // Apply prescaler (update event resets the counter without setting the update flag).
+    TIM22 -> PSC = (divider - 1);
+    TIM22 -> EGR = PROFILER_TIM_EGR_UG;
+}
+
+/*** PROFILER functions ***/
+
+/*******************************************************************/
+void PROFILER_init(void) {
+    // Init context.
+    profiler_ctx.base_us = 0;
+    PROFILER_reset();
+    // Enable peripheral clock.
+    RCC -> APB2ENR |= PROFILER_RCC_APB2ENR_TIM22EN;
+    // Free-running up-counter with overflow interrupt.
+    TIM22 -> CR1 = PROFILER_TIM_CR1_URS;
+    TIM22 -> ARR = PROFILER_TIM_ARR_MAX;
+    _PROFILER_set_prescaler();
+    TIM22 -> SR = ~(PROFILER_TIM_SR_UIF);
+    TIM22 -> DIER |= PROFILER_TIM_DIER_UIE;
+    NVIC_enable_interrupt(NVIC_INTERRUPT_TIM22, NVIC_PRIORITY_PROFILER);
+    TIM22 -> CR1 |= PROFILER_TIM_CR1_CEN;
+}
+
+/*******************************************************************/
+void PROFILER_update_clock(void) {
+    // Local variables.
+    uint32_t primask = 0;
+    // Enter critical section.
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) : : "memory");
+    // Close current epoch with the previous tick period.
+    profiler_ctx.base_us = _PROFILER_get_time_us();
+    _PROFILER_set_prescaler();
+    // Exit critical section.
+    __asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+
+/*******************************************************************/
+void PROFILER_start(PROFILER_probe_t probe) {
+    // Check parameter.
+    if (probe >= PROFILER_PROBE_LAST) return;
+    // Store start time.
+    profiler_ctx.probes[probe].start_us = _PROFILER_get_time_us();
+    profiler_ctx.probes[probe].running = 1;
+}
+
+/*******************************************************************/
+void PROFILER_stop(PROFILER_probe_t probe) {
+    // Local variables.
+    PROFILER_statistics_t* statistics = NULL;
+    uint32_t duration_us = 0;
+    // Check parameter.
+    if ((probe >= PROFILER_PROBE_LAST) || (profiler_ctx.probes[probe].running == 0)) return;
+    // Compute duration.
+    duration_us = (_PROFILER_get_time_us() - profiler_ctx.probes[probe].start_us);
+    profiler_ctx.probes[probe].running = 0;
+    // Update statistics.
+    statistics = &(profiler_ctx.probes[probe].statistics);
+    statistics -> count++;
+    if (duration_us < (statistics -> min_us)) {
+        statistics -> min_us = duration_us;
+    }
+    if (duration_us > (statistics -> max_us)) {
+        statistics -> max_us = duration_us;
+    }
+    // Saturate total.
+    statistics -> total_us = ((statistics -> total_us) > (0xFFFFFFFF - duration_us)) ? 0xFFFFFFFF : ((statistics -> total_us) + duration_us);
+}
+
+/*******************************************************************/
+void PROFILER_reset(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Reset all probes.
+    for (idx = 0; idx < PROFILER_PROBE_LAST; idx++) {
+        profiler_ctx.probes[idx].running = 0;
+        profiler_ctx.probes[idx].statistics.count = 0;
+        profiler_ctx.probes[idx].statistics.min_us = 0xFFFFFFFF;
+        profiler_ctx.probes[idx].statistics.max_us = 0;
+        profiler_ctx.probes[idx].statistics.total_us = 0;
+    }
+}
+
+/*******************************************************************/
+void PROFILER_get_statistics(PROFILER_probe_t probe, PROFILER_statistics_t* statistics) {
+    // Check parameters.
+    if ((probe >= PROFILER_PROBE_LAST) || (statistics == NULL)) return;
+    // Copy statistics.
+    (*statistics) = profiler_ctx.probes[probe].statistics;
+}
+
+/*******************************************************************/
+const char_t* PROFILER_get_probe_name(PROFILER_probe_t probe) {
+    return ((probe < PROFILER_PROBE_LAST) ? PROFILER_PROBE_NAME[probe] : "");
+}
+
+#endif /* TKFX_PROFILER */
@@ -0,0 +1,111 @@
+/*
+ * provisioning.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __PROVISIONING_H__
+#define __PROVISIONING_H__
+
+#include "lptim.h"
+#include "nvm.h"
+#include "sigfox_types.h"
+#include "tkfx_flags.h"
+#include "types.h"
+#include "usart.h"
+
+/*** PROVISIONING macros ***/
+
+// Frames synchronization byte.
+#define PROVISIONING_SYNC                   0xA5
+// Provisioned area: Sigfox EP ID, key and initial EP library NVM data (contiguous from NVM_ADDRESS_SIGFOX_EP_ID).
+#define PROVISIONING_DATA_SIZE_BYTES        (SIGFOX_EP_ID_SIZE_BYTES + SIGFOX_EP_KEY_SIZE_BYTES + SIGFOX_NVM_DATA_SIZE_BYTES)
+// Request: sync, data size, data, CRC (big endian, computed over data size and data).
+#define PROVISIONING_REQUEST_SIZE_BYTES     (2 + PROVISIONING_DATA_SIZE_BYTES + 2)
+// Response: sync, result, CRC of the provisioned area read back from NVM (big endian).
+#define PROVISIONING_RESPONSE_SIZE_BYTES    4
+// Accepted session baud rates.
+#define PROVISIONING_BAUD_RATE_MIN          9600
+#define PROVISIONING_BAUD_RATE_MAX          460800
+
+/*** PROVISIONING structures ***/
+
+/*!******************************************************************
+ * \enum PROVISIONING_status_t
+ * \brief Provisioning driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    PROVISIONING_SUCCESS = 0,
+    PROVISIONING_ERROR_NULL_PARAMETER,
+    PROVISIONING_ERROR_BAUD_RATE,
+    // Low level drivers errors.
+    PROVISIONING_ERROR_BASE_USART = 0x0100,
+    PROVISIONING_ERROR_BASE_NVM = (PROVISIONING_ERROR_BASE_USART + USART_ERROR_BASE_LAST),
+    PROVISIONING_ERROR_BASE_LPTIM = (PROVISIONING_ERROR_BASE_NVM + NVM_ERROR_BASE_LAST),
+    // Last base value.
+    PROVISIONING_ERROR_BASE_LAST = (PROVISIONING_ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST)
+} PROVISIONING_status_t;
+
+/*!******************************************************************
+ * \enum PROVISIONING_result_t
+ * \brief Provisioning transaction result sent in the response frame.
+ *******************************************************************/
+typedef enum {
+    PROVISIONING_RESULT_SUCCESS = 0,
+    PROVISIONING_RESULT_ERROR_SIZE,
+    PROVISIONING_RESULT_ERROR_CRC,
+    PROVISIONING_RESULT_ERROR_NVM,
+    PROVISIONING_RESULT_ERROR_VERIFY,
+    PROVISIONING_RESULT_ERROR_LAST
+} PROVISIONING_result_t;
+
+#ifdef TKFX_MODE_CLI
+
+/*** PROVISIONING functions ***/
+
+/*!******************************************************************
+ * \fn PROVISIONING_status_t PROVISIONING_check_baud_rate(uint32_t baud_rate)
+ * \brief Check if a provisioning session baud rate is supported.
+ * \param[in]   baud_rate: Requested baud rate.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+PROVISIONING_status_t PROVISIONING_check_baud_rate(uint32_t baud_rate);
+
+/*!******************************************************************
+ * \fn PROVISIONING_status_t PROVISIONING_process(uint32_t baud_rate, uint8_t* request)
+ * \brief Run a binary provisioning session on the terminal USART (blocking).
+ * \brief The terminal must be released by the caller. The session waits for one request frame, writes and verifies
+ * \brief the provisioned area in NVM, sends the response frame and releases the USART.
+ * \param[in]   baud_rate: Session baud rate.
+ * \param[in]   request: Request frame buffer of PROVISIONING_REQUEST_SIZE_BYTES bytes, owned by the caller during the session.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+PROVISIONING_status_t PROVISIONING_process(uint32_t baud_rate, uint8_t* request);
+
+/*!******************************************************************
+ * \fn uint16_t PROVISIONING_compute_crc(uint8_t* data, uint8_t data_size_bytes, uint16_t init_value)
+ * \brief Compute CRC-16/CCITT (polynomial 0x1021, no reflection).
+ * \param[in]   data: Input bytes.
+ * \param[in]   data_size_bytes: Number of bytes.
+ * \param[in]   init_value: Initial CRC value (0xFFFF, or previous result to continue a computation).
+ * \param[out]  none
+ * \retval      CRC value.
+ *******************************************************************/
+uint16_t PROVISIONING_compute_crc(uint8_t* data, uint8_t data_size_bytes, uint16_t init_value);
+
+/*******************************************************************/
+#define PROVISIONING_exit_error(base) { ERROR_check_exit(provisioning_status, PROVISIONING_SUCCESS, base) }
+
+/*******************************************************************/
+#define PROVISIONING_stack_error(base) { ERROR_check_stack(provisioning_status, PROVISIONING_SUCCESS, base) }
+
+/*******************************************************************/
+#define PROVISIONING_stack_exit_error(base, code) { ERROR_check_stack_exit(provisioning_status, PROVISIONING_SUCCESS, base, code) }
+
+#endif /* TKFX_MODE_CLI */
+
+#endif /* __PROVISIONING_H__ */
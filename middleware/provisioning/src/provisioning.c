@@ -0,0 +1,205 @@
+/*
+ * provisioning.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "provisioning.h"
+
+#include "error.h"
+#include "gpio_mapping.h"
+#include "iwdg.h"
+#include "lptim.h"
+#include "nvic_priority.h"
+#include "nvm.h"
+#include "nvm_address.h"
+#include "tkfx_flags.h"
+#include "types.h"
+#include "usart.h"
+
+#ifdef TKFX_MODE_CLI
+
+/*** PROVISIONING local macros ***/
+
+#define PROVISIONING_USART_INSTANCE         USART_INSTANCE_USART2
+
+#define PROVISIONING_CRC_POLYNOMIAL         0x1021
+#define PROVISIONING_CRC_INIT_VALUE         0xFFFF
+
+// Time given to the host to switch its baud rate and send the request.
+#define PROVISIONING_TIMEOUT_MS             5000
+#define PROVISIONING_POLLING_PERIOD_MS      10
+// Time to flush the last response byte before releasing the USART.
+#define PROVISIONING_FLUSH_DELAY_MS         2
+
+/*** PROVISIONING local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint8_t* request;
+    volatile uint8_t request_size;
+} PROVISIONING_context_t;
+
+/*** PROVISIONING local global variables ***/
+
+static PROVISIONING_context_t provisioning_ctx;
+
+/*** PROVISIONING local functions ***/
+
+/*******************************************************************/
+static void _PROVISIONING_rx_irq_callback(uint8_t data) {
+    // Wait for synchronization byte.
+    if ((provisioning_ctx.request_size == 0) && (data != PROVISIONING_SYNC)) goto end;
+    // Store byte.
+    if (provisioning_ctx.request_size < PROVISIONING_REQUEST_SIZE_BYTES) {
+        provisioning_ctx.request[provisioning_ctx.request_size] = data;
+        provisioning_ctx.request_size++;
+    }
+end:
+    return;
+}
+
+/*******************************************************************/
+static PROVISIONING_status_t _PROVISIONING_write(uint8_t* data) {
+    // Local variables.
+    PROVISIONING_status_t status = PROVISIONING_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t nvm_byte = 0;
+    uint8_t idx = 0;
+    // Write area, skipping unchanged bytes to save EEPROM programming time.
+    for (idx = 0; idx < PROVISIONING_DATA_SIZE_BYTES; idx++) {
+        nvm_status = NVM_read_byte((NVM_ADDRESS_SIGFOX_EP_ID + idx), &nvm_byte);
+        NVM_exit_error(PROVISIONING_ERROR_BASE_NVM);
+        if (nvm_byte != data[idx]) {
+            nvm_status = NVM_write_byte((NVM_ADDRESS_SIGFOX_EP_ID + idx), data[idx]);
+            NVM_exit_error(PROVISIONING_ERROR_BASE_NVM);
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static PROVISIONING_status_t _PROVISIONING_verify(uint8_t* data, PROVISIONING_result_t* result, uint16_t* crc) {
+    // Local variables.
+    PROVISIONING_status_t status = PROVISIONING_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t nvm_byte = 0;
+    uint8_t idx = 0;
+    // Read back area.
+    (*crc) = PROVISIONING_CRC_INIT_VALUE;
+    for (idx = 0; idx < PROVISIONING_DATA_SIZE_BYTES; idx++) {
+        nvm_status = NVM_read_byte((NVM_ADDRESS_SIGFOX_EP_ID + idx), &nvm_byte);
+        NVM_exit_error(PROVISIONING_ERROR_BASE_NVM);
+        if (nvm_byte != data[idx]) {
+            (*result) = PROVISIONING_RESULT_ERROR_VERIFY;
+        }
+        (*crc) = PROVISIONING_compute_crc(&nvm_byte, 1, (*crc));
+    }
+errors:
+    return status;
+}
+
+/*** PROVISIONING functions ***/
+
+/*******************************************************************/
+PROVISIONING_status_t PROVISIONING_check_baud_rate(uint32_t baud_rate) {
+    // Local variables.
+    PROVISIONING_status_t status = PROVISIONING_SUCCESS;
+    // Check range.
+    if ((baud_rate < PROVISIONING_BAUD_RATE_MIN) || (baud_rate > PROVISIONING_BAUD_RATE_MAX)) {
+        status = PROVISIONING_ERROR_BAUD_RATE;
+    }
+    return status;
+}
+
+/*******************************************************************/
+PROVISIONING_status_t PROVISIONING_process(uint32_t baud_rate, uint8_t* request) {
+    // Local variables.
+    PROVISIONING_status_t status = PROVISIONING_SUCCESS;
+    USART_status_t usart_status = USART_SUCCESS;
+    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    USART_configuration_t usart_config;
+    PROVISIONING_result_t result = PROVISIONING_RESULT_SUCCESS;
+    uint8_t response[PROVISIONING_RESPONSE_SIZE_BYTES];
+    uint16_t crc = 0;
+    uint32_t time_ms = 0;
+    // Check parameters.
+    if (request == NULL) {
+        status = PROVISIONING_ERROR_NULL_PARAMETER;
+        goto end;
+    }
+    status = PROVISIONING_check_baud_rate(baud_rate);
+    if (status != PROVISIONING_SUCCESS) goto end;
+    // Reset context.
+    provisioning_ctx.request = request;
+    provisioning_ctx.request_size = 0;
+    // Init USART at session baud rate.
+    usart_config.baud_rate = baud_rate;
+    usart_config.nvic_priority = NVIC_PRIORITY_CLI;
+    usart_config.rxne_callback = &_PROVISIONING_rx_irq_callback;
+    usart_status = USART_init(PROVISIONING_USART_INSTANCE, &GPIO_AT_USART, &usart_config);
+    USART_exit_error(PROVISIONING_ERROR_BASE_USART);
+    usart_status = USART_enable_rx(PROVISIONING_USART_INSTANCE);
+    USART_exit_error(PROVISIONING_ERROR_BASE_USART);
+    // Wait for request.
+    while (provisioning_ctx.request_size < PROVISIONING_REQUEST_SIZE_BYTES) {
+        // Exit silently on timeout, the host retries the whole transaction.
+        if (time_ms >= PROVISIONING_TIMEOUT_MS) goto errors;
+        lptim_status = LPTIM_delay_milliseconds(PROVISIONING_POLLING_PERIOD_MS, LPTIM_DELAY_MODE_SLEEP);
+        LPTIM_exit_error(PROVISIONING_ERROR_BASE_LPTIM);
+        time_ms += PROVISIONING_POLLING_PERIOD_MS;
+        IWDG_reload();
+    }
+    // Check frame.
+    crc = PROVISIONING_compute_crc(&(provisioning_ctx.request[1]), (PROVISIONING_REQUEST_SIZE_BYTES - 3), PROVISIONING_CRC_INIT_VALUE);
+    if (provisioning_ctx.request[1] != PROVISIONING_DATA_SIZE_BYTES) {
+        result = PROVISIONING_RESULT_ERROR_SIZE;
+    }
+    else if (crc != ((provisioning_ctx.request[PROVISIONING_REQUEST_SIZE_BYTES - 2] << 8) | provisioning_ctx.request[PROVISIONING_REQUEST_SIZE_BYTES - 1])) {
+        result = PROVISIONING_RESULT_ERROR_CRC;
+    }
+    else {
+        // Write and verify the whole area in one transaction.
+        status = _PROVISIONING_write(&(provisioning_ctx.request[2]));
+        if (status == PROVISIONING_SUCCESS) {
+            status = _PROVISIONING_verify(&(provisioning_ctx.request[2]), &result, &crc);
+        }
+        if (status != PROVISIONING_SUCCESS) {
+            result = PROVISIONING_RESULT_ERROR_NVM;
+        }
+    }
+    // Send response.
+    response[0] = PROVISIONING_SYNC;
+    response[1] = (uint8_t) result;
+    response[2] = (uint8_t) (crc >> 8);
+    response[3] = (uint8_t) (crc >> 0);
+    usart_status = USART_write(PROVISIONING_USART_INSTANCE, response, PROVISIONING_RESPONSE_SIZE_BYTES);
+    USART_exit_error(PROVISIONING_ERROR_BASE_USART);
+    lptim_status = LPTIM_delay_milliseconds(PROVISIONING_FLUSH_DELAY_MS, LPTIM_DELAY_MODE_ACTIVE);
+    LPTIM_exit_error(PROVISIONING_ERROR_BASE_LPTIM);
+errors:
+    // Release USART.
+    USART_de_init(PROVISIONING_USART_INSTANCE, &GPIO_AT_USART);
+end:
+    return status;
+}
+
+/*******************************************************************/
+uint16_t PROVISIONING_compute_crc(uint8_t* data, uint8_t data_size_bytes, uint16_t init_value) {
+    // Local variables.
+    uint16_t crc = init_value;
+    uint8_t idx = 0;
+    uint8_t bit_idx = 0;
+    // Bytes loop.
+    for (idx = 0; idx < data_size_bytes; idx++) {
+        crc ^= (uint16_t) (data[idx] << 8);
+        for (bit_idx = 0; bit_idx < 8; bit_idx++) {
+            crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ PROVISIONING_CRC_POLYNOMIAL) : (uint16_t) (crc << 1);
+        }
+    }
+    return crc;
+}
+
+#endif /* TKFX_MODE_CLI */
@@ -0,0 +1,44 @@
+/*
+ * ram.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __RAM_H__
+#define __RAM_H__
+
+#include "types.h"
+
+/*** RAM macros ***/
+
+// Pattern written by the reset handler in the free RAM and the unused stack.
+#define RAM_PAINT_PATTERN   0xC5C5C5C5
+
+/*** RAM structures ***/
+
+/*!******************************************************************
+ * \struct RAM_statistics_t
+ * \brief RAM budget and stack usage.
+ *******************************************************************/
+typedef struct {
+    uint32_t static_size_bytes;
+    uint32_t free_size_bytes;
+    uint32_t stack_size_bytes;
+    uint32_t stack_high_water_mark_bytes;
+    uint8_t stack_overflow_flag;
+} RAM_statistics_t;
+
+/*** RAM functions ***/
+
+/*!******************************************************************
+ * \fn void RAM_get_statistics(RAM_statistics_t* statistics)
+ * \brief Get RAM budget and stack high-water mark since reset.
+ * \brief The stack overflow flag is set when the painted guard area below the stack has been written.
+ * \param[in]   none
+ * \param[out]  statistics: Pointer to the statistics structure.
+ * \retval      none
+ *******************************************************************/
+void RAM_get_statistics(RAM_statistics_t* statistics);
+
+#endif /* __RAM_H__ */
@@ -0,0 +1,49 @@
+/*
+ * ram.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "ram.h"
+
+#include "types.h"
+
+/*** RAM local global variables ***/
+
+// Linker symbols.
+extern uint32_t __noinit_start__;
+extern uint32_t __bss_end__;
+extern uint32_t __HeapLimit;
+extern uint32_t __StackLimit;
+extern uint32_t __StackTop;
+
+/*** RAM local functions ***/
+
+/*******************************************************************/
+static uint32_t* _RAM_get_lowest_used_address(void) {
+    // Local variables.
+    uint32_t* address = &__HeapLimit;
+    // The painted area is contiguous from the heap limit up to the deepest stack pointer.
+    while ((address < &__StackTop) && ((*address) == RAM_PAINT_PATTERN)) {
+        address++;
+    }
+    return address;
+}
+
+/*** RAM functions ***/
+
+/*******************************************************************/
+void RAM_get_statistics(RAM_statistics_t* statistics) {
+    // Local variables.
+    uint32_t* lowest_used_address = _RAM_get_lowest_used_address();
+    // Check parameter.
+    if (statistics == NULL) return;
+    // Static allocation (no-init, RAM functions, data and bss).
+    statistics -> static_size_bytes = (uint32_t) (((uint8_t*) &__bss_end__) - ((uint8_t*) &__noinit_start__));
+    statistics -> free_size_bytes = (uint32_t) (((uint8_t*) &__StackLimit) - ((uint8_t*) &__HeapLimit));
+    // Stack usage.
+    statistics -> stack_size_bytes = (uint32_t) (((uint8_t*) &__StackTop) - ((uint8_t*) &__StackLimit));
+    statistics -> stack_high_water_mark_bytes = (uint32_t) (((uint8_t*) &__StackTop) - ((uint8_t*) lowest_used_address));
+    statistics -> stack_overflow_flag = (lowest_used_address < &__StackLimit) ? 1 : 0;
+}
@@ -49,9 +49,13 @@
 #include "gpio_mapping.h"
 #include "iwdg.h"
 #include "manuf/mcu_api.h"
+#include "marker.h"
 #include "nvic_priority.h"
+#include "overlay.h"
+#include "profiler.h"
 #include "power.h"
 #include "pwr.h"
+#include "ramfunc.h"
 #include "s2lp.h"
 #include "types.h"
 
@@ -69,6 +73,10 @@
 
 #define RF_API_FIFO_TX_ALMOST_EMPTY_THRESHOLD   (RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES >> 1)
 
+#if (RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES != OVERLAY_RADIO_FIFO_BUFFER_SIZE_BYTES)
+#error "RF API symbol FIFO buffer size does not match the overlay radio buffers"
+#endif
+
 #define RF_API_SMPS_FREQUENCY_HZ_TX             5500000
 #ifdef BIDIRECTIONAL
 #define RF_API_SMPS_FREQUENCY_HZ_RX             1500000
@@ -99,6 +107,7 @@ typedef enum {
     RF_API_ERROR_LATENCY_TYPE,
     // Low level drivers errors.
     RF_API_ERROR_DRIVER_MCU_API,
+    RF_API_ERROR_DRIVER_OVERLAY,
     RF_API_ERROR_DRIVER_POWER,
     RF_API_ERROR_DRIVER_S2LP
 } RF_API_custom_status_t;
@@ -132,17 +141,15 @@ typedef struct {
     // Common.
     RF_API_state_t state;
     volatile RF_API_flags_t flags;
+    // TX and RX buffers (overlaid with the other phases, valid between wake-up and sleep).
+    OVERLAY_radio_t* buffers;
     // TX.
-    sfx_u8 symbol_fifo_buffer[RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES];
-    sfx_u8 ramp_fifo_buffer[RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES];
-    sfx_u8 tx_bitstream[SIGFOX_UL_BITSTREAM_SIZE_BYTES];
     sfx_u8 tx_bitstream_size_bytes;
     sfx_u8 tx_byte_idx;
     sfx_u8 tx_bit_idx;
     sfx_u8 tx_fdev;
 #ifdef BIDIRECTIONAL
     // RX.
-    sfx_u8 dl_phy_content[SIGFOX_DL_PHY_CONTENT_SIZE_BYTES];
     sfx_s16 dl_rssi_dbm;
 #endif
 } RF_API_context_t;
@@ -170,7 +177,7 @@ static RF_API_context_t rf_api_ctx;
 /*** RF API local functions ***/
 
 /*******************************************************************/
-static void _RF_API_s2lp_gpio_irq_callback(void) {
+static RAMFUNC void _RF_API_s2lp_gpio_irq_callback(void) {
     // Set flag if IRQ is enabled.
     rf_api_ctx.flags.field.gpio_irq_flag = rf_api_ctx.flags.field.gpio_irq_enable;
 }
@@ -200,6 +207,48 @@ static void _RF_API_disable_s2lp_nirq(void) {
     EXTI_release_gpio(&GPIO_S2LP_GPIO0, GPIO_MODE_INPUT);
 }
 
+/*******************************************************************/
+static RAMFUNC S2LP_status_t _RF_API_refill_symbol_fifo(void) {
+    // Local variables.
+    S2LP_status_t s2lp_status = S2LP_SUCCESS;
+    sfx_u8 idx = 0;
+    // Check bit.
+    if ((rf_api_ctx.buffers->tx_bitstream[rf_api_ctx.tx_byte_idx] & (1 << (7 - rf_api_ctx.tx_bit_idx))) == 0) {
+        // Phase shift and amplitude shaping required.
+        rf_api_ctx.tx_fdev = (rf_api_ctx.tx_fdev == RF_API_FDEV_NEGATIVE) ? RF_API_FDEV_POSITIVE : RF_API_FDEV_NEGATIVE; // Toggle deviation.
+        for (idx = 0; idx < RF_API_SYMBOL_PROFILE_SIZE_BYTES; idx++) {
+            rf_api_ctx.buffers->symbol_fifo_buffer[(2 * idx)] = (idx == RF_API_FIFO_BUFFER_FDEV_IDX) ? rf_api_ctx.tx_fdev : 0; // Deviation.
+            rf_api_ctx.buffers->symbol_fifo_buffer[(2 * idx) + 1] = RF_API_BIT0_AMPLITUDE_PROFILE[idx]; // PA output power.
+        }
+    }
+    else {
+        // Constant CW.
+        for (idx = 0; idx < RF_API_SYMBOL_PROFILE_SIZE_BYTES; idx++) {
+            rf_api_ctx.buffers->symbol_fifo_buffer[(2 * idx)] = 0; // Deviation.
+            rf_api_ctx.buffers->symbol_fifo_buffer[(2 * idx) + 1] = RF_API_BIT0_AMPLITUDE_PROFILE[0]; // PA output power.
+        }
+    }
+    // Load bit into FIFO (S2LP_write_fifo() and the SPI transfer functions are placed in .ramfunc by the linker script).
+    s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.buffers->symbol_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
+    if (s2lp_status != S2LP_SUCCESS) goto errors;
+    // Increment bit index.
+    rf_api_ctx.tx_bit_idx++;
+    if (rf_api_ctx.tx_bit_idx >= 8) {
+        // Reset bit index.
+        rf_api_ctx.tx_bit_idx = 0;
+        // Increment byte index.
+        rf_api_ctx.tx_byte_idx++;
+        // Check end of bitstream.
+        if (rf_api_ctx.tx_byte_idx >= (rf_api_ctx.tx_bitstream_size_bytes)) {
+            rf_api_ctx.tx_byte_idx = 0;
+            // Update state.
+            rf_api_ctx.state = RF_API_STATE_TX_RAMP_DOWN;
+        }
+    }
+errors:
+    return s2lp_status;
+}
+
 /*******************************************************************/
 static RF_API_status_t _RF_API_internal_process(void) {
     // Local variables.
@@ -207,6 +256,7 @@ static RF_API_status_t _RF_API_internal_process(void) {
     S2LP_status_t s2lp_status = S2LP_SUCCESS;
     sfx_u8 s2lp_irq_flag = 0;
     sfx_u8 idx = 0;
+    PROFILER_START(PROFILER_PROBE_RF_API_PROCESS);
     // Perform state machine.
     switch (rf_api_ctx.state) {
     case RF_API_STATE_READY:
@@ -215,13 +265,13 @@ static RF_API_status_t _RF_API_internal_process(void) {
     case RF_API_STATE_TX_RAMP_UP:
         // Fill ramp-up.
         for (idx = 0; idx < RF_API_SYMBOL_PROFILE_SIZE_BYTES; idx++) {
-            rf_api_ctx.ramp_fifo_buffer[(2 * idx)] = 0; // Deviation.
-            rf_api_ctx.ramp_fifo_buffer[(2 * idx) + 1] = RF_API_RAMP_AMPLITUDE_PROFILE[RF_API_SYMBOL_PROFILE_SIZE_BYTES - idx - 1]; // PA output power.
+            rf_api_ctx.buffers->ramp_fifo_buffer[(2 * idx)] = 0; // Deviation.
+            rf_api_ctx.buffers->ramp_fifo_buffer[(2 * idx) + 1] = RF_API_RAMP_AMPLITUDE_PROFILE[RF_API_SYMBOL_PROFILE_SIZE_BYTES - idx - 1]; // PA output power.
         }
         // Load ramp-up buffer into FIFO.
         s2lp_status = S2LP_send_command(S2LP_COMMAND_FLUSHTXFIFO);
         S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
-        s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.ramp_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
+        s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.buffers->ramp_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
         S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
         // Enable external GPIO interrupt.
         s2lp_status = S2LP_clear_all_irq();
@@ -246,39 +296,9 @@ static RF_API_status_t _RF_API_internal_process(void) {
         S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
         // Check flag.
         if (s2lp_irq_flag != 0) {
-            // Check bit.
-            if ((rf_api_ctx.tx_bitstream[rf_api_ctx.tx_byte_idx] & (1 << (7 - rf_api_ctx.tx_bit_idx))) == 0) {
-                // Phase shift and amplitude shaping required.
-                rf_api_ctx.tx_fdev = (rf_api_ctx.tx_fdev == RF_API_FDEV_NEGATIVE) ? RF_API_FDEV_POSITIVE : RF_API_FDEV_NEGATIVE; // Toggle deviation.
-                for (idx = 0; idx < RF_API_SYMBOL_PROFILE_SIZE_BYTES; idx++) {
-                    rf_api_ctx.symbol_fifo_buffer[(2 * idx)] = (idx == RF_API_FIFO_BUFFER_FDEV_IDX) ? rf_api_ctx.tx_fdev : 0; // Deviation.
-                    rf_api_ctx.symbol_fifo_buffer[(2 * idx) + 1] = RF_API_BIT0_AMPLITUDE_PROFILE[idx]; // PA output power.
-                }
-            }
-            else {
-                // Constant CW.
-                for (idx = 0; idx < RF_API_SYMBOL_PROFILE_SIZE_BYTES; idx++) {
-                    rf_api_ctx.symbol_fifo_buffer[(2 * idx)] = 0; // Deviation.
-                    rf_api_ctx.symbol_fifo_buffer[(2 * idx) + 1] = RF_API_BIT0_AMPLITUDE_PROFILE[0]; // PA output power.
-                }
-            }
-            // Load bit into FIFO.
-            s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.symbol_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
+            // Load next bit into FIFO.
+            s2lp_status = _RF_API_refill_symbol_fifo();
             S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
-            // Increment bit index.
-            rf_api_ctx.tx_bit_idx++;
-            if (rf_api_ctx.tx_bit_idx >= 8) {
-                // Reset bit index.
-                rf_api_ctx.tx_bit_idx = 0;
-                // Increment byte index.
-                rf_api_ctx.tx_byte_idx++;
-                // Check end of bitstream.
-                if (rf_api_ctx.tx_byte_idx >= (rf_api_ctx.tx_bitstream_size_bytes)) {
-                    rf_api_ctx.tx_byte_idx = 0;
-                    // Update state.
-                    rf_api_ctx.state = RF_API_STATE_TX_RAMP_DOWN;
-                }
-            }
             // Clear flag.
             s2lp_status = S2LP_clear_all_irq();
             S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
@@ -292,11 +312,11 @@ static RF_API_status_t _RF_API_internal_process(void) {
         if (s2lp_irq_flag != 0) {
             // Fill ramp-down.
             for (idx = 0; idx < RF_API_SYMBOL_PROFILE_SIZE_BYTES; idx++) {
-                rf_api_ctx.ramp_fifo_buffer[(2 * idx)] = 0; // FDEV.
-                rf_api_ctx.ramp_fifo_buffer[(2 * idx) + 1] = RF_API_RAMP_AMPLITUDE_PROFILE[idx]; // PA output power for ramp-down.
+                rf_api_ctx.buffers->ramp_fifo_buffer[(2 * idx)] = 0; // FDEV.
+                rf_api_ctx.buffers->ramp_fifo_buffer[(2 * idx) + 1] = RF_API_RAMP_AMPLITUDE_PROFILE[idx]; // PA output power for ramp-down.
             }
             // Load ramp-down buffer into FIFO.
-            s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.ramp_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
+            s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.buffers->ramp_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
             S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
             // Update state.
             rf_api_ctx.state = RF_API_STATE_TX_PADDING_BIT;
@@ -313,10 +333,10 @@ static RF_API_status_t _RF_API_internal_process(void) {
         if (s2lp_irq_flag != 0) {
             // Padding bit to ensure last ramp down is completely transmitted.
             for (idx = 0; idx < RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES; idx++) {
-                rf_api_ctx.symbol_fifo_buffer[idx] = 0x00;
+                rf_api_ctx.buffers->symbol_fifo_buffer[idx] = 0x00;
             }
             // Load padding buffer into FIFO.
-            s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.symbol_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
+            s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.buffers->symbol_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
             S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
             // Update state.
             rf_api_ctx.state = RF_API_STATE_TX_END;
@@ -371,7 +391,7 @@ static RF_API_status_t _RF_API_internal_process(void) {
         // Check flag.
         if (s2lp_irq_flag != 0) {
             // Read FIFO and RSSI.
-            s2lp_status = S2LP_read_fifo((sfx_u8*) rf_api_ctx.dl_phy_content, SIGFOX_DL_PHY_CONTENT_SIZE_BYTES);
+            s2lp_status = S2LP_read_fifo((sfx_u8*) rf_api_ctx.buffers->dl_phy_content, SIGFOX_DL_PHY_CONTENT_SIZE_BYTES);
             S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
             s2lp_status = S2LP_get_rssi(S2LP_RSSI_TYPE_SYNC_WORD, &rf_api_ctx.dl_rssi_dbm);
             S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
@@ -393,6 +413,7 @@ static RF_API_status_t _RF_API_internal_process(void) {
         break;
     }
 errors:
+    PROFILER_STOP(PROFILER_PROBE_RF_API_PROCESS);
     RETURN();
 }
 
@@ -433,6 +454,13 @@ RF_API_status_t RF_API_wake_up(void) {
     // Local variables.
     RF_API_status_t status = RF_API_SUCCESS;
     POWER_status_t power_status = POWER_SUCCESS;
+    OVERLAY_status_t overlay_status = OVERLAY_SUCCESS;
+    OVERLAY_t* overlay = SFX_NULL;
+    MARKER_PHASE(MARKER_PHASE_RF_WAKE_UP);
+    // Take the working buffers.
+    overlay_status = OVERLAY_acquire(OVERLAY_PHASE_RADIO, &overlay);
+    OVERLAY_stack_exit_error(ERROR_BASE_OVERLAY, (RF_API_status_t) RF_API_ERROR_DRIVER_OVERLAY);
+    rf_api_ctx.buffers = &(overlay->radio);
     // Turn radio TCXO on.
     power_status = POWER_enable(POWER_DOMAIN_TCXO, LPTIM_DELAY_MODE_SLEEP);
     POWER_stack_exit_error(ERROR_BASE_POWER, (RF_API_status_t) RF_API_ERROR_DRIVER_POWER);
@@ -445,10 +473,18 @@ RF_API_status_t RF_API_sleep(void) {
     // Local variables.
     RF_API_status_t status = RF_API_SUCCESS;
     POWER_status_t power_status = POWER_SUCCESS;
+    OVERLAY_status_t overlay_status = OVERLAY_SUCCESS;
+    // Give back the working buffers (the CLI also calls this function to stop a radio which was not woken up).
+    if (rf_api_ctx.buffers != SFX_NULL) {
+        rf_api_ctx.buffers = SFX_NULL;
+        overlay_status = OVERLAY_release(OVERLAY_PHASE_RADIO);
+        OVERLAY_stack_exit_error(ERROR_BASE_OVERLAY, (RF_API_status_t) RF_API_ERROR_DRIVER_OVERLAY);
+    }
     // Turn radio TCXO off.
     power_status = POWER_disable(POWER_DOMAIN_TCXO);
     POWER_stack_exit_error(ERROR_BASE_POWER, (RF_API_status_t) RF_API_ERROR_DRIVER_POWER);
 errors:
+    MARKER_PHASE(MARKER_PHASE_RF_END);
     RETURN();
 }
 
@@ -597,10 +633,12 @@ RF_API_status_t RF_API_send(RF_API_tx_data_t* tx_data) {
     // Local variables.
     RF_API_status_t status = RF_API_SUCCESS;
     sfx_u8 idx = 0;
+    PROFILER_START(PROFILER_PROBE_RF_API_SEND);
+    MARKER_PHASE(MARKER_PHASE_RF_TX);
     // Store TX data.
     rf_api_ctx.tx_bitstream_size_bytes = (tx_data->bitstream_size_bytes);
     for (idx = 0; idx < (rf_api_ctx.tx_bitstream_size_bytes); idx++) {
-        rf_api_ctx.tx_bitstream[idx] = (tx_data->bitstream)[idx];
+        rf_api_ctx.buffers->tx_bitstream[idx] = (tx_data->bitstream)[idx];
     }
     // Enable GPIO interrupt.
     status = _RF_API_enable_s2lp_nirq(S2LP_FIFO_FLAG_DIRECTION_TX);
@@ -629,6 +667,8 @@ RF_API_status_t RF_API_send(RF_API_tx_data_t* tx_data) {
 errors:
     // Disable GPIO interrupt.
     _RF_API_disable_s2lp_nirq();
+    PROFILER_STOP(PROFILER_PROBE_RF_API_SEND);
+    MARKER_PHASE(MARKER_PHASE_RF_IDLE);
     RETURN();
 }
 
@@ -640,6 +680,7 @@ RF_API_status_t RF_API_receive(RF_API_rx_data_t* rx_data) {
     MCU_API_status_t mcu_api_status = MCU_API_SUCCESS;
     S2LP_status_t s2lp_status = S2LP_SUCCESS;
     sfx_bool dl_timeout = SFX_FALSE;
+    MARKER_PHASE(MARKER_PHASE_RF_RX);
     // Enable GPIO interrupt.
     status = _RF_API_enable_s2lp_nirq(S2LP_FIFO_FLAG_DIRECTION_RX);
     CHECK_STATUS(RF_API_SUCCESS);
@@ -681,6 +722,7 @@ RF_API_status_t RF_API_receive(RF_API_rx_data_t* rx_data) {
 errors:
     // Disable GPIO interrupt.
     _RF_API_disable_s2lp_nirq();
+    MARKER_PHASE(MARKER_PHASE_RF_IDLE);
     RETURN();
 }
 #endif
@@ -700,7 +742,7 @@ RF_API_status_t RF_API_get_dl_phy_content_and_rssi(sfx_u8* dl_phy_content, sfx_u
     }
     // Fill data.
     for (idx = 0; idx < dl_phy_content_size; idx++) {
-        dl_phy_content[idx] = rf_api_ctx.dl_phy_content[idx];
+        dl_phy_content[idx] = rf_api_ctx.buffers->dl_phy_content[idx];
     }
     (*dl_rssi_dbm) = (sfx_s16) rf_api_ctx.dl_rssi_dbm;
 errors:
@@ -769,5 +811,10 @@ void RF_API_error(void) {
     // Force all front-end off.
     S2LP_shutdown(1);
     POWER_disable(POWER_DOMAIN_RADIO);
+    // Give back the working buffers since the library does not call the sleep function after an error.
+    if (rf_api_ctx.buffers != SFX_NULL) {
+        rf_api_ctx.buffers = SFX_NULL;
+        OVERLAY_release(OVERLAY_PHASE_RADIO);
+    }
 }
 #endif
@@ -0,0 +1,122 @@
+/*
+ * stream.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __STREAM_H__
+#define __STREAM_H__
+
+#include "analog.h"
+#include "lptim.h"
+#include "mma865xfc.h"
+#include "power.h"
+#include "sht3x.h"
+#include "tkfx_flags.h"
+#include "types.h"
+
+/*** STREAM macros ***/
+
+// Record: sync, sequence, channels mask, timestamp (ms, 32 bits), one 16-bits value per selected channel,
+// XOR checksum of all bytes after sync. Multi-bytes fields are little endian.
+#define STREAM_SYNC                     0xFE
+#define STREAM_RECORD_HEADER_SIZE_BYTES 7
+#define STREAM_RECORD_SIZE_MAX_BYTES    (STREAM_RECORD_HEADER_SIZE_BYTES + (STREAM_CHANNEL_LAST * 2) + 1)
+
+#define STREAM_PERIOD_MS_MIN            10
+#define STREAM_PERIOD_MS_MAX            60000
+// Longest sleep of a process call, so that the caller can reload the watchdog and check the terminal.
+#define STREAM_SLEEP_STEP_MS_MAX        100
+
+/*** STREAM structures ***/
+
+/*!******************************************************************
+ * \enum STREAM_status_t
+ * \brief Stream driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    STREAM_SUCCESS = 0,
+    STREAM_ERROR_CHANNELS,
+    STREAM_ERROR_PERIOD,
+    // Low level drivers errors.
+    STREAM_ERROR_BASE_POWER = 0x0100,
+    STREAM_ERROR_BASE_ANALOG = (STREAM_ERROR_BASE_POWER + POWER_ERROR_BASE_LAST),
+    STREAM_ERROR_BASE_SHT30 = (STREAM_ERROR_BASE_ANALOG + ANALOG_ERROR_BASE_LAST),
+    STREAM_ERROR_BASE_MMA8653FC = (STREAM_ERROR_BASE_SHT30 + SHT3X_ERROR_BASE_LAST),
+    STREAM_ERROR_BASE_LPTIM = (STREAM_ERROR_BASE_MMA8653FC + MMA865XFC_ERROR_BASE_LAST),
+    // Last base value.
+    STREAM_ERROR_BASE_LAST = (STREAM_ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST)
+} STREAM_status_t;
+
+/*!******************************************************************
+ * \enum STREAM_channel_t
+ * \brief Stream channels (bit index in the channels mask, values order in records).
+ *******************************************************************/
+typedef enum {
+    STREAM_CHANNEL_VSRC_MV = 0,
+    STREAM_CHANNEL_VSTR_MV,
+    STREAM_CHANNEL_VMCU_MV,
+    STREAM_CHANNEL_TEMPERATURE_DEGREES,
+    STREAM_CHANNEL_HUMIDITY_PERCENT,
+    STREAM_CHANNEL_ACC_X_RAW,
+    STREAM_CHANNEL_ACC_Y_RAW,
+    STREAM_CHANNEL_ACC_Z_RAW,
+    STREAM_CHANNEL_LAST
+} STREAM_channel_t;
+
+#ifdef TKFX_MODE_CLI
+
+/*** STREAM functions ***/
+
+/*!******************************************************************
+ * \fn STREAM_status_t STREAM_start(uint8_t channels_mask, uint32_t period_ms)
+ * \brief Turn the required sensors on and start streaming.
+ * \param[in]   channels_mask: Bit field of the channels to sample (see STREAM_channel_t).
+ * \param[in]   period_ms: Sampling period.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+STREAM_status_t STREAM_start(uint8_t channels_mask, uint32_t period_ms);
+
+/*!******************************************************************
+ * \fn STREAM_status_t STREAM_stop(void)
+ * \brief Stop streaming and turn sensors off.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+STREAM_status_t STREAM_stop(void);
+
+/*!******************************************************************
+ * \fn STREAM_status_t STREAM_process(uint8_t* record, uint8_t* record_size_bytes)
+ * \brief Sample the selected channels if the period is elapsed, otherwise sleep for at most STREAM_SLEEP_STEP_MS_MAX.
+ * \param[in]   none
+ * \param[out]  record: Record buffer (STREAM_RECORD_SIZE_MAX_BYTES bytes).
+ * \param[out]  record_size_bytes: Record size, 0 if no sample was taken.
+ * \retval      Function execution status.
+ *******************************************************************/
+STREAM_status_t STREAM_process(uint8_t* record, uint8_t* record_size_bytes);
+
+/*!******************************************************************
+ * \fn uint8_t STREAM_is_running(void)
+ * \brief Get streaming state.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Non zero while streaming.
+ *******************************************************************/
+uint8_t STREAM_is_running(void);
+
+/*******************************************************************/
+#define STREAM_exit_error(base) { ERROR_check_exit(stream_status, STREAM_SUCCESS, base) }
+
+/*******************************************************************/
+#define STREAM_stack_error(base) { ERROR_check_stack(stream_status, STREAM_SUCCESS, base) }
+
+/*******************************************************************/
+#define STREAM_stack_exit_error(base, code) { ERROR_check_stack_exit(stream_status, STREAM_SUCCESS, base, code) }
+
+#endif /* TKFX_MODE_CLI */
+
+#endif /* __STREAM_H__ */
@@ -0,0 +1,290 @@
+/*
+ * stream.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "stream.h"
+
+#include "analog.h"
+#include "error.h"
+#include "i2c_address.h"
+#include "lptim.h"
+#include "mma865xfc.h"
+#include "mma865xfc_configuration.h"
+#include "mma865xfc_hw.h"
+#include "power.h"
+#include "sht3x.h"
+#include "sht3x_measurement.h"
+#include "timestamp.h"
+#include "tkfx_flags.h"
+#include "types.h"
+
+#ifdef TKFX_MODE_CLI
+
+/*** STREAM local macros ***/
+
+#define STREAM_CHANNELS_MASK_ANALOG     ((0b1 << STREAM_CHANNEL_VSRC_MV) | (0b1 << STREAM_CHANNEL_VSTR_MV) | (0b1 << STREAM_CHANNEL_VMCU_MV))
+#define STREAM_CHANNELS_MASK_SHT3X      ((0b1 << STREAM_CHANNEL_TEMPERATURE_DEGREES) | (0b1 << STREAM_CHANNEL_HUMIDITY_PERCENT))
+#define STREAM_CHANNELS_MASK_MMA865XFC  ((0b1 << STREAM_CHANNEL_ACC_X_RAW) | (0b1 << STREAM_CHANNEL_ACC_Y_RAW) | (0b1 << STREAM_CHANNEL_ACC_Z_RAW))
+
+#define STREAM_MMA865XFC_OUT_SIZE_BYTES 6
+
+// Medium repeatability keeps the conversion time around 6ms.
+#define STREAM_SHT3X_REPEATABILITY      SHT3X_MEASUREMENT_REPEATABILITY_MEDIUM
+// Single shot mode is used when no periodic rate is at least twice faster than the stream.
+#define STREAM_SHT3X_SINGLE_SHOT        SHT3X_MEASUREMENT_RATE_LAST
+
+/*** STREAM local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint8_t channels_mask;
+    uint8_t sht3x_rate;
+    uint32_t period_ms;
+    uint32_t next_time_ms;
+    uint8_t sequence;
+    uint8_t running;
+} STREAM_context_t;
+
+/*** STREAM local global variables ***/
+
+// SHT3x periodic mode measurement period indexed by rate.
+static const uint16_t STREAM_SHT3X_RATE_PERIOD_MS[SHT3X_MEASUREMENT_RATE_LAST] = { 2000, 1000, 500, 250, 100 };
+
+static STREAM_context_t stream_ctx = {
+    .channels_mask = 0,
+    .sht3x_rate = STREAM_SHT3X_SINGLE_SHOT
+};
+
+/*** STREAM local functions ***/
+
+/*******************************************************************/
+static STREAM_status_t _STREAM_read_analog(int16_t* values) {
+    // Local variables.
+    STREAM_status_t status = STREAM_SUCCESS;
+    ANALOG_status_t analog_status = ANALOG_SUCCESS;
+    const ANALOG_channel_t analog_channel[3] = { ANALOG_CHANNEL_VSRC_MV, ANALOG_CHANNEL_VSTR_MV, ANALOG_CHANNEL_VMCU_MV };
+    int32_t value = 0;
+    uint8_t idx = 0;
+    // Channels loop.
+    for (idx = 0; idx < 3; idx++) {
+        if ((stream_ctx.channels_mask & (0b1 << (STREAM_CHANNEL_VSRC_MV + idx))) == 0) continue;
+        analog_status = ANALOG_convert_channel(analog_channel[idx], &value);
+        ANALOG_exit_error(STREAM_ERROR_BASE_ANALOG);
+        values[STREAM_CHANNEL_VSRC_MV + idx] = (int16_t) value;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static STREAM_status_t _STREAM_read_sht3x(int16_t* values) {
+    // Local variables.
+    STREAM_status_t status = STREAM_SUCCESS;
+    SHT3X_status_t sht3x_status = SHT3X_SUCCESS;
+    int32_t temperature_degrees = 0;
+    int32_t humidity_percent = 0;
+    // Fetch the last periodic result or trigger a conversion.
+    if (stream_ctx.sht3x_rate != STREAM_SHT3X_SINGLE_SHOT) {
+        sht3x_status = SHT3X_MEASUREMENT_fetch_periodic(I2C_ADDRESS_SHT30, &temperature_degrees, &humidity_percent);
+    }
+    else {
+        sht3x_status = SHT3X_MEASUREMENT_single_shot(I2C_ADDRESS_SHT30, STREAM_SHT3X_REPEATABILITY, 1, &temperature_degrees, &humidity_percent);
+    }
+    SHT3X_exit_error(STREAM_ERROR_BASE_SHT30);
+    values[STREAM_CHANNEL_TEMPERATURE_DEGREES] = (int16_t) temperature_degrees;
+    values[STREAM_CHANNEL_HUMIDITY_PERCENT] = (int16_t) humidity_percent;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static STREAM_status_t _STREAM_start_sht3x(void) {
+    // Local variables.
+    STREAM_status_t status = STREAM_SUCCESS;
+    SHT3X_status_t sht3x_status = SHT3X_SUCCESS;
+    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    uint8_t idx = 0;
+    // Select the slowest periodic rate giving a new result at each stream period (sensor stays powered during the stream).
+    stream_ctx.sht3x_rate = STREAM_SHT3X_SINGLE_SHOT;
+    for (idx = 0; idx < SHT3X_MEASUREMENT_RATE_LAST; idx++) {
+        if ((STREAM_SHT3X_RATE_PERIOD_MS[idx] << 1) <= stream_ctx.period_ms) {
+            stream_ctx.sht3x_rate = idx;
+            break;
+        }
+    }
+    if (stream_ctx.sht3x_rate == STREAM_SHT3X_SINGLE_SHOT) goto errors;
+    sht3x_status = SHT3X_MEASUREMENT_start_periodic(I2C_ADDRESS_SHT30, STREAM_SHT3X_REPEATABILITY, (SHT3X_MEASUREMENT_rate_t) stream_ctx.sht3x_rate);
+    SHT3X_exit_error(STREAM_ERROR_BASE_SHT30);
+    // Wait for the first result.
+    lptim_status = LPTIM_delay_milliseconds(STREAM_SHT3X_RATE_PERIOD_MS[stream_ctx.sht3x_rate], LPTIM_DELAY_MODE_SLEEP);
+    LPTIM_exit_error(STREAM_ERROR_BASE_LPTIM);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static STREAM_status_t _STREAM_read_mma865xfc(int16_t* values) {
+    // Local variables.
+    STREAM_status_t status = STREAM_SUCCESS;
+    MMA865XFC_status_t mma865xfc_status = MMA865XFC_SUCCESS;
+    uint8_t register_address = MMA865XFC_REGISTER_OUT_X_MSB;
+    uint8_t data[STREAM_MMA865XFC_OUT_SIZE_BYTES];
+    uint8_t idx = 0;
+    // Burst read of the 3 axis (left justified 16-bits words, MSB first).
+    mma865xfc_status = MMA865XFC_HW_i2c_write(I2C_ADDRESS_MMA8653FC, &register_address, 1, 0);
+    MMA865XFC_exit_error(STREAM_ERROR_BASE_MMA8653FC);
+    mma865xfc_status = MMA865XFC_HW_i2c_read(I2C_ADDRESS_MMA8653FC, data, STREAM_MMA865XFC_OUT_SIZE_BYTES);
+    MMA865XFC_exit_error(STREAM_ERROR_BASE_MMA8653FC);
+    for (idx = 0; idx < 3; idx++) {
+        values[STREAM_CHANNEL_ACC_X_RAW + idx] = (int16_t) ((data[idx << 1] << 8) | data[(idx << 1) + 1]);
+    }
+errors:
+    return status;
+}
+
+/*** STREAM functions ***/
+
+/*******************************************************************/
+STREAM_status_t STREAM_start(uint8_t channels_mask, uint32_t period_ms) {
+    // Local variables.
+    STREAM_status_t status = STREAM_SUCCESS;
+    POWER_status_t power_status = POWER_SUCCESS;
+    MMA865XFC_status_t mma865xfc_status = MMA865XFC_SUCCESS;
+    // Check parameters.
+    if (channels_mask == 0) {
+        status = STREAM_ERROR_CHANNELS;
+        goto errors;
+    }
+    if ((period_ms < STREAM_PERIOD_MS_MIN) || (period_ms > STREAM_PERIOD_MS_MAX)) {
+        status = STREAM_ERROR_PERIOD;
+        goto errors;
+    }
+    // Init context.
+    stream_ctx.channels_mask = channels_mask;
+    stream_ctx.period_ms = period_ms;
+    stream_ctx.sequence = 0;
+    stream_ctx.running = 1;
+    // Turn required domains on.
+    if ((channels_mask & STREAM_CHANNELS_MASK_ANALOG) != 0) {
+        power_status = POWER_enable(POWER_DOMAIN_ANALOG, LPTIM_DELAY_MODE_SLEEP);
+        POWER_exit_error(STREAM_ERROR_BASE_POWER);
+    }
+    if ((channels_mask & (STREAM_CHANNELS_MASK_SHT3X | STREAM_CHANNELS_MASK_MMA865XFC)) != 0) {
+        power_status = POWER_enable(POWER_DOMAIN_SENSORS, LPTIM_DELAY_MODE_SLEEP);
+        POWER_exit_error(STREAM_ERROR_BASE_POWER);
+    }
+    // Accelerometer must be active to update its output registers.
+    if ((channels_mask & STREAM_CHANNELS_MASK_MMA865XFC) != 0) {
+        mma865xfc_status = MMA865XFC_CONFIGURATION_write(I2C_ADDRESS_MMA8653FC, &(MMA865XFC_ACTIVE_CONFIGURATION[0]), MMA865XFC_ACTIVE_CONFIGURATION_SIZE);
+        MMA865XFC_exit_error(STREAM_ERROR_BASE_MMA8653FC);
+    }
+    // Heater-off periodic mode for slow streams.
+    if ((channels_mask & STREAM_CHANNELS_MASK_SHT3X) != 0) {
+        status = _STREAM_start_sht3x();
+        if (status != STREAM_SUCCESS) goto errors;
+    }
+    stream_ctx.next_time_ms = TIMESTAMP_get_milliseconds();
+    goto end;
+errors:
+    STREAM_stop();
+end:
+    return status;
+}
+
+/*******************************************************************/
+STREAM_status_t STREAM_stop(void) {
+    // Local variables.
+    STREAM_status_t status = STREAM_SUCCESS;
+    POWER_status_t power_status = POWER_SUCCESS;
+    SHT3X_status_t sht3x_status = SHT3X_SUCCESS;
+    // Update state.
+    stream_ctx.running = 0;
+    // Go back to single shot mode before power down (domains are turned off even on error).
+    if (stream_ctx.sht3x_rate != STREAM_SHT3X_SINGLE_SHOT) {
+        stream_ctx.sht3x_rate = STREAM_SHT3X_SINGLE_SHOT;
+        sht3x_status = SHT3X_MEASUREMENT_stop_periodic(I2C_ADDRESS_SHT30);
+        if (sht3x_status != SHT3X_SUCCESS) {
+            status = (STREAM_status_t) (STREAM_ERROR_BASE_SHT30 + sht3x_status);
+        }
+    }
+    // Turn domains off.
+    power_status = POWER_disable(POWER_DOMAIN_ANALOG);
+    POWER_exit_error(STREAM_ERROR_BASE_POWER);
+    power_status = POWER_disable(POWER_DOMAIN_SENSORS);
+    POWER_exit_error(STREAM_ERROR_BASE_POWER);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+STREAM_status_t STREAM_process(uint8_t* record, uint8_t* record_size_bytes) {
+    // Local variables.
+    STREAM_status_t status = STREAM_SUCCESS;
+    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    int16_t values[STREAM_CHANNEL_LAST];
+    uint8_t record_size = 0;
+    uint32_t time_ms = 0;
+    int32_t wait_ms = 0;
+    uint8_t checksum = 0;
+    uint8_t idx = 0;
+    // Reset output.
+    (*record_size_bytes) = 0;
+    // Check state.
+    if (stream_ctx.running == 0) goto errors;
+    // Sleep by steps until the next period.
+    wait_ms = (int32_t) (stream_ctx.next_time_ms - TIMESTAMP_get_milliseconds());
+    if (wait_ms > 0) {
+        lptim_status = LPTIM_delay_milliseconds(((wait_ms > STREAM_SLEEP_STEP_MS_MAX) ? STREAM_SLEEP_STEP_MS_MAX : (uint32_t) wait_ms), LPTIM_DELAY_MODE_SLEEP);
+        LPTIM_exit_error(STREAM_ERROR_BASE_LPTIM);
+        goto errors;
+    }
+    // Sample channels.
+    time_ms = TIMESTAMP_get_milliseconds();
+    if ((stream_ctx.channels_mask & STREAM_CHANNELS_MASK_ANALOG) != 0) {
+        status = _STREAM_read_analog(values);
+        if (status != STREAM_SUCCESS) goto errors;
+    }
+    if ((stream_ctx.channels_mask & STREAM_CHANNELS_MASK_SHT3X) != 0) {
+        status = _STREAM_read_sht3x(values);
+        if (status != STREAM_SUCCESS) goto errors;
+    }
+    if ((stream_ctx.channels_mask & STREAM_CHANNELS_MASK_MMA865XFC) != 0) {
+        status = _STREAM_read_mma865xfc(values);
+        if (status != STREAM_SUCCESS) goto errors;
+    }
+    // Build record.
+    record[record_size++] = STREAM_SYNC;
+    record[record_size++] = stream_ctx.sequence;
+    record[record_size++] = stream_ctx.channels_mask;
+    for (idx = 0; idx < 4; idx++) {
+        record[record_size++] = (uint8_t) (time_ms >> (idx << 3));
+    }
+    for (idx = 0; idx < STREAM_CHANNEL_LAST; idx++) {
+        if ((stream_ctx.channels_mask & (0b1 << idx)) == 0) continue;
+        record[record_size++] = (uint8_t) (values[idx] >> 0);
+        record[record_size++] = (uint8_t) (values[idx] >> 8);
+    }
+    for (idx = 1; idx < record_size; idx++) {
+        checksum ^= record[idx];
+    }
+    record[record_size++] = checksum;
+    stream_ctx.sequence++;
+    (*record_size_bytes) = record_size;
+    // Next period (no catch-up if the sampling took longer than the period).
+    stream_ctx.next_time_ms += stream_ctx.period_ms;
+    if (((int32_t) (stream_ctx.next_time_ms - TIMESTAMP_get_milliseconds())) <= 0) {
+        stream_ctx.next_time_ms = TIMESTAMP_get_milliseconds();
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+uint8_t STREAM_is_running(void) {
+    return (stream_ctx.running);
+}
+
+#endif /* TKFX_MODE_CLI */
@@ -0,0 +1,54 @@
+/*
+ * timestamp.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TIMESTAMP_H__
+#define __TIMESTAMP_H__
+
+#include "types.h"
+
+/*** TIMESTAMP functions ***/
+
+/*!******************************************************************
+ * \fn void TIMESTAMP_init(void)
+ * \brief Init millisecond timestamp driver (must be called after RTC_init()).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TIMESTAMP_init(void);
+
+/*!******************************************************************
+ * \fn void TIMESTAMP_enter_low_power(void)
+ * \brief Must be called before entering stop or sleep mode.
+ * \brief Until TIMESTAMP_exit_low_power(), each reading (such as the one of a wake-up interrupt) waits for the RTC shadow registers resynchronization.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TIMESTAMP_enter_low_power(void);
+
+/*!******************************************************************
+ * \fn void TIMESTAMP_exit_low_power(void)
+ * \brief Resynchronize the RTC shadow registers after wake-up, must be called before the first timestamp of the main loop.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TIMESTAMP_exit_low_power(void);
+
+/*!******************************************************************
+ * \fn uint32_t TIMESTAMP_get_milliseconds(void)
+ * \brief Get a free-running millisecond timestamp based on the RTC calendar and sub-second registers.
+ * \brief The value wraps every 2^32 ms, so only differences between timestamps must be used.
+ * \brief The function must be called at least once per day to track calendar roll-over (done by the main loop on each wake-up).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Current timestamp in milliseconds.
+ *******************************************************************/
+uint32_t TIMESTAMP_get_milliseconds(void);
+
+#endif /* __TIMESTAMP_H__ */
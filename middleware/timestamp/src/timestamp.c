@@ -0,0 +1,147 @@
+/*
+ * timestamp.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "timestamp.h"
+
+#include "ramfunc.h"
+#include "rtc_reg.h"
+#include "types.h"
+
+/*** TIMESTAMP local macros ***/
+
+#define TIMESTAMP_RTC_WPR_KEY_1         0xCA
+#define TIMESTAMP_RTC_WPR_KEY_2         0x53
+#define TIMESTAMP_RTC_WPR_LOCK          0xFF
+
+#define TIMESTAMP_RTC_ISR_RSF           (0b1 << 5)
+// Writing 1 to the other rc_w0 flags (ALRAF to TAMP2F) and 0 to INIT leaves them unchanged.
+#define TIMESTAMP_RTC_ISR_RC_W0_FLAGS   (0b1111111 << 8)
+// RSF is set within 2 RTCCLK periods, the loop only guards against a stopped RTC clock.
+#define TIMESTAMP_RTC_RSF_TIMEOUT_COUNT 100000
+
+#define TIMESTAMP_MS_PER_DAY            86400000
+
+/*** TIMESTAMP local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t last_day_ms;
+    uint32_t day_offset_ms;
+    volatile uint8_t low_power_flag;
+} TIMESTAMP_context_t;
+
+/*** TIMESTAMP local global variables ***/
+
+static TIMESTAMP_context_t timestamp_ctx;
+
+/*** TIMESTAMP local functions ***/
+
+#ifdef __arm__
+/*******************************************************************/
+#define _TIMESTAMP_enter_critical_section(primask) { __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) : : "memory"); }
+
+/*******************************************************************/
+#define _TIMESTAMP_exit_critical_section(primask) { __asm volatile ("msr primask, %0" : : "r" (primask) : "memory"); }
+#else
+// Host build (script/tkfx_activity_check.py): no interrupt to mask.
+#define _TIMESTAMP_enter_critical_section(primask) { (void) (primask); }
+#define _TIMESTAMP_exit_critical_section(primask) { (void) (primask); }
+#endif
+
+/*******************************************************************/
+static RAMFUNC uint32_t _TIMESTAMP_bcd_to_binary(uint32_t bcd_value) {
+    return ((((bcd_value >> 4) & 0x0F) * 10) + (bcd_value & 0x0F));
+}
+
+/*******************************************************************/
+static RAMFUNC void _TIMESTAMP_synchronize(void) {
+    // Local variables.
+    uint32_t loop_count = 0;
+    // Shadow registers keep the time of stop mode entry until the next RTCCLK synchronization:
+    // clear RSF and wait for the hardware to set it again on the next copy.
+    RTC->WPR = TIMESTAMP_RTC_WPR_KEY_1;
+    RTC->WPR = TIMESTAMP_RTC_WPR_KEY_2;
+    RTC->ISR = TIMESTAMP_RTC_ISR_RC_W0_FLAGS;
+    RTC->WPR = TIMESTAMP_RTC_WPR_LOCK;
+    while (((RTC->ISR) & TIMESTAMP_RTC_ISR_RSF) == 0) {
+        loop_count++;
+        if (loop_count > TIMESTAMP_RTC_RSF_TIMEOUT_COUNT) break;
+    }
+}
+
+/*******************************************************************/
+static RAMFUNC uint32_t _TIMESTAMP_get_day_milliseconds(void) {
+    // Local variables.
+    uint32_t ssr = 0;
+    uint32_t tr = 0;
+    uint32_t prediv_s = 0;
+    uint32_t seconds = 0;
+    // Resynchronize shadow registers on each reading between low power entry and exit (typically under wake-up interrupt).
+    if (timestamp_ctx.low_power_flag != 0) {
+        _TIMESTAMP_synchronize();
+    }
+    // Reading SSR locks the TR and DR shadow registers until DR is read, so that the sample is consistent.
+    ssr = (RTC->SSR) & 0xFFFF;
+    tr = (RTC->TR);
+    (void) (RTC->DR);
+    prediv_s = (RTC->PRER) & 0x7FFF;
+    // Convert calendar time.
+    seconds = (_TIMESTAMP_bcd_to_binary((tr >> 16) & 0x3F) * 3600);
+    seconds += (_TIMESTAMP_bcd_to_binary((tr >> 8) & 0x7F) * 60);
+    seconds += (_TIMESTAMP_bcd_to_binary((tr >> 0) & 0x7F));
+    // Add sub-second part (SSR down-counter from PREDIV_S to 0).
+    return ((seconds * 1000) + (((prediv_s - ssr) * 1000) / (prediv_s + 1)));
+}
+
+/*** TIMESTAMP functions ***/
+
+/*******************************************************************/
+void TIMESTAMP_init(void) {
+    // Init context.
+    timestamp_ctx.low_power_flag = 0;
+    _TIMESTAMP_synchronize();
+    timestamp_ctx.last_day_ms = _TIMESTAMP_get_day_milliseconds();
+    timestamp_ctx.day_offset_ms = 0;
+}
+
+/*******************************************************************/
+void TIMESTAMP_enter_low_power(void) {
+    // Readings done after wake-up and before TIMESTAMP_exit_low_power() will resynchronize the shadow registers.
+    timestamp_ctx.low_power_flag = 1;
+}
+
+/*******************************************************************/
+void TIMESTAMP_exit_low_power(void) {
+    // Local variables.
+    uint32_t primask = 0;
+    // Enter critical section since the function can be called under interrupt.
+    _TIMESTAMP_enter_critical_section(primask);
+    _TIMESTAMP_synchronize();
+    timestamp_ctx.low_power_flag = 0;
+    // Exit critical section.
+    _TIMESTAMP_exit_critical_section(primask);
+}
+
+/*******************************************************************/
+RAMFUNC uint32_t TIMESTAMP_get_milliseconds(void) {
+    // Local variables.
+    uint32_t primask = 0;
+    uint32_t day_ms = 0;
+    uint32_t timestamp_ms = 0;
+    // Enter critical section since the function can be called under interrupt.
+    _TIMESTAMP_enter_critical_section(primask);
+    day_ms = _TIMESTAMP_get_day_milliseconds();
+    // Check calendar roll-over.
+    if (day_ms < timestamp_ctx.last_day_ms) {
+        timestamp_ctx.day_offset_ms += TIMESTAMP_MS_PER_DAY;
+    }
+    timestamp_ctx.last_day_ms = day_ms;
+    timestamp_ms = (timestamp_ctx.day_offset_ms + day_ms);
+    // Exit critical section.
+    _TIMESTAMP_exit_critical_section(primask);
+    return timestamp_ms;
+}
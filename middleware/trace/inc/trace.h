@@ -0,0 +1,89 @@
+/*
+ * trace.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include "types.h"
+
+/*** TRACE macros ***/
+
+// Ring depth (power of 2).
+#define TRACE_DEPTH             32
+// Header magic, to be changed whenever the record layout changes.
+#define TRACE_MAGIC             0x54524331
+
+/*** TRACE structures ***/
+
+/*!******************************************************************
+ * \enum TRACE_event_t
+ * \brief Trace event types.
+ *******************************************************************/
+typedef enum {
+    TRACE_EVENT_RESET = 0,
+    TRACE_EVENT_STATE,
+    TRACE_EVENT_POWER,
+    TRACE_EVENT_RADIO,
+    TRACE_EVENT_GPS,
+    TRACE_EVENT_LAST
+} TRACE_event_t;
+
+/*!******************************************************************
+ * \struct TRACE_record_t
+ * \brief Trace record (8 bytes).
+ *******************************************************************/
+typedef struct {
+    uint32_t timestamp_ms;
+    uint8_t event;
+    uint8_t data_8bits;
+    uint16_t data_16bits;
+} TRACE_record_t;
+
+/*!******************************************************************
+ * \struct TRACE_ring_t
+ * \brief Trace ring, kept across resets in the no-init RAM section.
+ *******************************************************************/
+typedef struct {
+    uint32_t magic;
+    uint32_t index;
+    uint32_t index_check;
+    uint32_t boot_count;
+    TRACE_record_t records[TRACE_DEPTH];
+} TRACE_ring_t;
+
+/*** TRACE functions ***/
+
+/*!******************************************************************
+ * \fn void TRACE_init(uint8_t reset_flags)
+ * \brief Recover the trace ring from the previous run (or clear it if invalid) and add a reset event.
+ * \param[in]   reset_flags: Reset flags read from the RCC_CSR register.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TRACE_init(uint8_t reset_flags);
+
+/*!******************************************************************
+ * \fn void TRACE_add(TRACE_event_t event, uint8_t data_8bits, uint16_t data_16bits)
+ * \brief Add an event to the trace ring (main context only).
+ * \param[in]   event: Event type.
+ * \param[in]   data_8bits: Event specific data.
+ * \param[in]   data_16bits: Event specific data.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TRACE_add(TRACE_event_t event, uint8_t data_8bits, uint16_t data_16bits);
+
+/*!******************************************************************
+ * \fn const TRACE_ring_t* TRACE_get_ring(void)
+ * \brief Get trace ring.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Pointer to the trace ring.
+ *******************************************************************/
+const TRACE_ring_t* TRACE_get_ring(void);
+
+#endif /* __TRACE_H__ */
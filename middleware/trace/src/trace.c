@@ -0,0 +1,65 @@
+/*
+ * trace.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "trace.h"
+
+#include "timestamp.h"
+#include "types.h"
+
+/*** TRACE local macros ***/
+
+#define TRACE_DEPTH_MASK    (TRACE_DEPTH - 1)
+
+#if ((TRACE_DEPTH & TRACE_DEPTH_MASK) != 0)
+#error "TRACE_DEPTH must be a power of 2"
+#endif
+
+/*** TRACE local global variables ***/
+
+// Not initialized by the startup code: content survives watchdog and software resets.
+static TRACE_ring_t trace_ring __attribute__((section(".noinit.trace_ring")));
+
+/*** TRACE functions ***/
+
+/*******************************************************************/
+void TRACE_init(uint8_t reset_flags) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Check ring integrity (random content after power on).
+    if ((trace_ring.magic != TRACE_MAGIC) || (trace_ring.index_check != (~trace_ring.index))) {
+        for (idx = 0; idx < TRACE_DEPTH; idx++) {
+            trace_ring.records[idx].timestamp_ms = 0;
+            trace_ring.records[idx].event = TRACE_EVENT_LAST;
+            trace_ring.records[idx].data_8bits = 0;
+            trace_ring.records[idx].data_16bits = 0;
+        }
+        trace_ring.index = 0;
+        trace_ring.boot_count = 0;
+        trace_ring.magic = TRACE_MAGIC;
+    }
+    trace_ring.boot_count++;
+    TRACE_add(TRACE_EVENT_RESET, reset_flags, (uint16_t) trace_ring.boot_count);
+}
+
+/*******************************************************************/
+void TRACE_add(TRACE_event_t event, uint8_t data_8bits, uint16_t data_16bits) {
+    // Local variables.
+    TRACE_record_t* record = &(trace_ring.records[trace_ring.index & TRACE_DEPTH_MASK]);
+    // Fill record.
+    record -> timestamp_ms = TIMESTAMP_get_milliseconds();
+    record -> event = (uint8_t) event;
+    record -> data_8bits = data_8bits;
+    record -> data_16bits = data_16bits;
+    // Update index.
+    trace_ring.index++;
+    trace_ring.index_check = (~trace_ring.index);
+}
+
+/*******************************************************************/
+const TRACE_ring_t* TRACE_get_ring(void) {
+    return ((const TRACE_ring_t*) &trace_ring);
+}
@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+#
+# tkfx_activity_check.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Run a stop/wake sequence through the firmware middleware/timestamp and middleware/activity modules, built on the
+# host (gcc) against a simulated RTC and driven through ctypes. The simulated RTC reproduces the stale calendar shadow
+# registers after stop mode: they keep the time of stop entry until software clears RSF and the next sync sets it again.
+#
+# Usage: tkfx_activity_check.py [--awake-ms <ms>] [--stop-s <s>] [--cycles <n>]
+#        tkfx_activity_check.py --self-test
+
+import argparse
+import ctypes
+import os
+import subprocess
+import sys
+import tempfile
+
+ROOT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+SOURCE_FILES = [
+    os.path.join(ROOT_DIR, "middleware", "timestamp", "src", "timestamp.c"),
+    os.path.join(ROOT_DIR, "middleware", "activity", "src", "activity.c"),
+]
+# Host types.h replacement shared with the batch decoder and firmware headers (the simulated rtc_reg.h is generated in the build directory).
+INCLUDE_DIRS = [
+    os.path.join(ROOT_DIR, "script", "tkfx_decoder"),
+    os.path.join(ROOT_DIR, "application", "inc"),
+    os.path.join(ROOT_DIR, "middleware", "timestamp", "inc"),
+    os.path.join(ROOT_DIR, "middleware", "activity", "inc"),
+]
+# Default LSE prescalers (32768 Hz / (127 + 1) / (255 + 1)).
+PREDIV_S = 255
+HISTOGRAM_BINS_NUMBER = 8
+HISTOGRAM_BIN_LOG2 = 2
+STATES_NUMBER_MAX = 10
+
+RTC_REG_H = """
+#ifndef __RTC_REG_H__
+#define __RTC_REG_H__
+#include <stdint.h>
+typedef struct {
+    volatile uint32_t TR;
+    volatile uint32_t DR;
+    volatile uint32_t CR;
+    volatile uint32_t ISR;
+    volatile uint32_t PRER;
+    volatile uint32_t WPR;
+    volatile uint32_t SSR;
+} RTC_registers_t;
+// Each register access steps the simulated hardware.
+RTC_registers_t* RTC_HOST_access(void);
+#define RTC     (RTC_HOST_access())
+#endif
+"""
+
+RTC_HOST_C = """
+#include "rtc_reg.h"
+#define RTC_HOST_PREDIV_S   %d
+#define RTC_HOST_ISR_RSF    (1 << 5)
+static RTC_registers_t rtc_host_registers = { .ISR = RTC_HOST_ISR_RSF, .PRER = RTC_HOST_PREDIV_S };
+static uint64_t rtc_host_ticks = 0;
+static uint8_t rtc_host_stale = 0;
+static uint32_t _RTC_HOST_bcd(uint32_t value) {
+    return (((value / 10) << 4) | (value %% 10));
+}
+static void _RTC_HOST_copy(void) {
+    uint64_t seconds = (rtc_host_ticks / (RTC_HOST_PREDIV_S + 1));
+    rtc_host_registers.SSR = (uint32_t) (RTC_HOST_PREDIV_S - (rtc_host_ticks %% (RTC_HOST_PREDIV_S + 1)));
+    rtc_host_registers.TR = (_RTC_HOST_bcd((seconds / 3600) %% 24) << 16) | (_RTC_HOST_bcd((seconds / 60) %% 60) << 8) | _RTC_HOST_bcd(seconds %% 60);
+}
+RTC_registers_t* RTC_HOST_access(void) {
+    // RSF cleared by software: the next synchronization copies the counters and sets it again.
+    if ((rtc_host_registers.ISR & RTC_HOST_ISR_RSF) == 0) {
+        rtc_host_stale = 0;
+        rtc_host_registers.ISR |= RTC_HOST_ISR_RSF;
+    }
+    if (rtc_host_stale == 0) {
+        _RTC_HOST_copy();
+    }
+    return &rtc_host_registers;
+}
+void RTC_HOST_advance(uint64_t ticks, uint8_t stop_mode) {
+    rtc_host_ticks += ticks;
+    // Shadow registers are not updated in stop mode and stay stale after wake-up until RSF is cleared.
+    if (stop_mode != 0) {
+        rtc_host_stale = 1;
+    }
+}
+uint32_t RTC_HOST_get_milliseconds(void) {
+    return (uint32_t) ((rtc_host_ticks * 1000) / (RTC_HOST_PREDIV_S + 1));
+}
+uint32_t RTC_HOST_get_wpr(void) {
+    return rtc_host_registers.WPR;
+}
+""" % PREDIV_S
+
+class ActivityStatistics(ctypes.Structure):
+    # Mirror of ACTIVITY_statistics_t.
+    _fields_ = [
+        ("state_time_ms", ctypes.c_uint32 * STATES_NUMBER_MAX),
+        ("wake_count", ctypes.c_uint32),
+        ("awake_time_ms", ctypes.c_uint32),
+        ("wake_histogram", ctypes.c_uint32 * HISTOGRAM_BINS_NUMBER),
+    ]
+
+class Firmware:
+
+    def __init__(self, library):
+        self.library = library
+        self.library.TIMESTAMP_init()
+        self.library.ACTIVITY_init(None, 1, self.library.TIMESTAMP_get_milliseconds())
+
+    def run(self, duration_ms):
+        self.library.RTC_HOST_advance(ms_to_ticks(duration_ms), 0)
+
+    def stop(self, duration_ms, irq_offset_ms, armed=True):
+        # Main loop TKFX_STATE_SLEEP sequence, with a motion IRQ taken irq_offset_ms before the main loop resumes.
+        self.library.ACTIVITY_stop(self.library.TIMESTAMP_get_milliseconds())
+        if armed:
+            self.library.TIMESTAMP_enter_low_power()
+        self.library.RTC_HOST_advance(ms_to_ticks(duration_ms - irq_offset_ms), 1)
+        irq_ms = self.library.TIMESTAMP_get_milliseconds()
+        irq_real_ms = self.library.RTC_HOST_get_milliseconds()
+        self.library.RTC_HOST_advance(ms_to_ticks(irq_offset_ms), 0)
+        if armed:
+            self.library.TIMESTAMP_exit_low_power()
+        self.library.ACTIVITY_wake_up(self.library.TIMESTAMP_get_milliseconds())
+        return irq_ms, irq_real_ms
+
+    def statistics(self):
+        statistics = ActivityStatistics()
+        self.library.ACTIVITY_get_statistics(ctypes.byref(statistics))
+        return statistics
+
+def ms_to_ticks(duration_ms):
+    return (duration_ms * (PREDIV_S + 1)) // 1000
+
+def get_bin(duration_ms):
+    # Same logarithmic bins as _ACTIVITY_get_bin().
+    duration_ms >>= HISTOGRAM_BIN_LOG2
+    bin_idx = 0
+    while duration_ms != 0 and bin_idx < (HISTOGRAM_BINS_NUMBER - 1):
+        duration_ms >>= HISTOGRAM_BIN_LOG2
+        bin_idx += 1
+    return bin_idx
+
+def build(build_dir):
+    # Compile the firmware modules with the simulated RTC as a host shared library.
+    with open(os.path.join(build_dir, "rtc_reg.h"), "w") as f:
+        f.write(RTC_REG_H)
+    with open(os.path.join(build_dir, "rtc_host.c"), "w") as f:
+        f.write(RTC_HOST_C)
+    library_path = os.path.join(build_dir, "libactivity.so")
+    command = ["gcc", "-O2", "-shared", "-fPIC", "-Wno-attributes", "-I" + build_dir]
+    command += ["-I" + include_dir for include_dir in INCLUDE_DIRS]
+    command += SOURCE_FILES + [os.path.join(build_dir, "rtc_host.c"), "-o", library_path]
+    subprocess.run(command, check=True)
+    library = ctypes.CDLL(library_path)
+    library.RTC_HOST_advance.argtypes = [ctypes.c_uint64, ctypes.c_uint8]
+    library.RTC_HOST_advance.restype = None
+    library.RTC_HOST_get_milliseconds.restype = ctypes.c_uint32
+    library.RTC_HOST_get_wpr.restype = ctypes.c_uint32
+    library.TIMESTAMP_get_milliseconds.restype = ctypes.c_uint32
+    library.ACTIVITY_init.argtypes = [ctypes.c_void_p, ctypes.c_uint8, ctypes.c_uint32]
+    library.ACTIVITY_stop.argtypes = [ctypes.c_uint32]
+    library.ACTIVITY_wake_up.argtypes = [ctypes.c_uint32]
+    return library
+
+def sequence(library, awake_ms, stop_s, cycles, armed=True):
+    firmware = Firmware(library)
+    irq_errors_ms = []
+    for _ in range(cycles):
+        firmware.run(awake_ms)
+        irq_ms, irq_real_ms = firmware.stop(stop_s * 1000, min(awake_ms, 100), armed)
+        irq_errors_ms.append(irq_real_ms - irq_ms)
+    firmware.run(awake_ms)
+    firmware.library.ACTIVITY_stop(firmware.library.TIMESTAMP_get_milliseconds())
+    return firmware.statistics(), irq_errors_ms
+
+def self_test(library):
+    # One SSR step of tolerance on each timestamp.
+    step_ms = (1000 // (PREDIV_S + 1)) + 1
+    awake_ms = 40
+    cycles = 3
+    statistics, irq_errors_ms = sequence(library, awake_ms, 60, cycles)
+    if max(abs(error_ms) for error_ms in irq_errors_ms) > step_ms:
+        return "wake-up interrupt timestamp off by %s ms" % irq_errors_ms
+    if statistics.wake_count != (cycles + 1):
+        return "wake count %d instead of %d" % (statistics.wake_count, cycles + 1)
+    if abs(statistics.awake_time_ms - ((cycles + 1) * awake_ms)) > ((cycles + 1) * 2 * step_ms):
+        return "awake time %d ms instead of %d ms" % (statistics.awake_time_ms, (cycles + 1) * awake_ms)
+    if statistics.wake_histogram[get_bin(awake_ms)] != (cycles + 1):
+        return "wake durations not in bin %d: %s" % (get_bin(awake_ms), list(statistics.wake_histogram))
+    if library.RTC_HOST_get_wpr() != 0xFF:
+        return "RTC write protection left unlocked"
+    # The simulated RTC must reproduce the stale timestamp when the resynchronization is not armed.
+    statistics, irq_errors_ms = sequence(library, awake_ms, 60, 1, armed=False)
+    if irq_errors_ms[0] < 50000:
+        return "simulated RTC does not reproduce stale shadow registers"
+    return None
+
+def main():
+    parser = argparse.ArgumentParser(description="Check activity statistics of a stop/wake sequence on the host.")
+    parser.add_argument("--awake-ms", type=int, default=40, help="awake duration of each wake cycle")
+    parser.add_argument("--stop-s", type=int, default=60, help="stop mode duration")
+    parser.add_argument("--cycles", type=int, default=10, help="number of stop/wake cycles")
+    parser.add_argument("--self-test", action="store_true", help="check the stop/wake sequence and exit")
+    args = parser.parse_args()
+    with tempfile.TemporaryDirectory() as build_dir:
+        library = build(build_dir)
+        if args.self_test:
+            error = self_test(library)
+            if error is not None:
+                sys.exit("Self-test failed: " + error)
+            print("Self-test passed")
+            return
+        statistics, irq_errors_ms = sequence(library, args.awake_ms, args.stop_s, args.cycles)
+        print("wake_count=%d awake_time_ms=%d" % (statistics.wake_count, statistics.awake_time_ms))
+        print("wake_histogram=" + ",".join(str(count) for count in statistics.wake_histogram))
+        print("irq_timestamp_error_ms_max=%d" % max(abs(error_ms) for error_ms in irq_errors_ms))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+#
+# tkfx_charge_model.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# MCU charge model per wake cycle: compares running every state on HSI16 (range 1) with the
+# per state clock profile policy defined in application/src/main.c (TKFX_STATE_CLOCK_PROFILE).
+# Only the MCU core is modelled: external power domains (radio, GPS, sensors) are identical in both cases.
+
+import argparse
+import os
+import re
+import sys
+
+MAIN_FILE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "application", "src", "main.c")
+
+# Profile model: system clock frequency (Hz), run current (A) and sleep current (A), STM32L0 datasheet typical values.
+PROFILES = {
+    "HIGH_PERFORMANCE": { "frequency_hz": 16000000, "run_a": 2.1e-3, "sleep_a": 0.65e-3, "switch_us": 150 },
+    "LOW_POWER":        { "frequency_hz": 2097000,  "run_a": 0.21e-3, "sleep_a": 0.06e-3, "switch_us": 60 },
+}
+# Stop mode exit: wake-up time (us) and current (A) per wake-up clock.
+STOP_EXIT = { "HIGH_PERFORMANCE": (8.0, 1.0e-3), "LOW_POWER": (5.0, 0.2e-3) }
+
+# Per state workload: CPU cycles and time spent waiting in sleep mode (peripheral transfers, delays) in ms.
+STATE_WORKLOAD = {
+    "STARTUP":     (20000, 0.0),
+    "WAKEUP":      (40000, 0.0),
+    "MEASURE":     (30000, 210.0),
+    "MODE_UPDATE": (15000, 100.0),
+    "MONITORING":  (5000, 0.0),
+    "GEOLOC":      (400000, 0.0),
+    "ERROR_STACK": (3000, 0.0),
+    "OFF":         (500, 0.0),
+    "SLEEP":       (1500, 0.0),
+}
+
+# Wake cycles: sequence of states executed after a stop mode exit.
+CYCLES = {
+    "rtc_tick":   ["SLEEP"],
+    "monitoring": ["SLEEP", "WAKEUP", "MEASURE", "MODE_UPDATE", "MONITORING", "ERROR_STACK", "OFF", "SLEEP"],
+    "geoloc":     ["SLEEP", "WAKEUP", "MEASURE", "MODE_UPDATE", "GEOLOC", "ERROR_STACK", "OFF", "SLEEP"],
+}
+
+def parse_policy(main_file):
+    # Extract state clock profiles in enum order.
+    with open(main_file) as f:
+        content = f.read()
+    match = re.search(r"TKFX_STATE_CLOCK_PROFILE\[TKFX_STATE_LAST\] = \{(.*?)\};", content, re.S)
+    if match is None:
+        return None
+    entries = re.findall(r"CLOCK_PROFILE_(\w+)[^/]*// (\w+)", match.group(1))
+    return { state: profile for profile, state in entries }
+
+def cycle_charge(states, policy):
+    # Returns charge (C) and duration (s) of a wake cycle.
+    charge = 0.0
+    duration = 0.0
+    first = policy[states[0]]
+    wakeup_us, wakeup_a = STOP_EXIT[first]
+    charge += wakeup_a * wakeup_us * 1e-6
+    duration += wakeup_us * 1e-6
+    profile = first
+    for state in states:
+        target = policy[state]
+        if target != profile:
+            switch_s = PROFILES[target]["switch_us"] * 1e-6
+            charge += PROFILES["HIGH_PERFORMANCE"]["run_a"] * switch_s
+            duration += switch_s
+            profile = target
+        cycles, sleep_ms = STATE_WORKLOAD[state]
+        run_s = cycles / PROFILES[profile]["frequency_hz"]
+        charge += (PROFILES[profile]["run_a"] * run_s) + (PROFILES[profile]["sleep_a"] * sleep_ms * 1e-3)
+        duration += run_s + (sleep_ms * 1e-3)
+    return charge, duration
+
+def main():
+    parser = argparse.ArgumentParser(description="MCU charge per wake cycle.")
+    parser.add_argument("--main-file", default=MAIN_FILE, help="firmware main.c path")
+    parser.add_argument("--tick-period", type=float, default=10.0, help="RTC wake-up period (s)")
+    args = parser.parse_args()
+    policy = parse_policy(args.main_file)
+    if policy is None:
+        sys.exit("TKFX_STATE_CLOCK_PROFILE not found in " + args.main_file)
+    baseline = { state: "HIGH_PERFORMANCE" for state in policy }
+    print("%-12s %14s %14s %14s %10s" % ("cycle", "baseline_uC", "policy_uC", "policy_ms", "gain_%"))
+    for name, states in CYCLES.items():
+        q_base, _ = cycle_charge(states, baseline)
+        q_policy, t_policy = cycle_charge(states, policy)
+        print("%-12s %14.3f %14.3f %14.3f %10.1f" % (name, q_base * 1e6, q_policy * 1e6, t_policy * 1e3, 100.0 * (q_base - q_policy) / q_base))
+    q_base, _ = cycle_charge(CYCLES["rtc_tick"], baseline)
+    q_policy, _ = cycle_charge(CYCLES["rtc_tick"], policy)
+    print("RTC tick average current: baseline %.3f uA, policy %.3f uA" % (q_base * 1e6 / args.tick_period, q_policy * 1e6 / args.tick_period))
+
+if __name__ == "__main__":
+    main()
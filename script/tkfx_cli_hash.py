@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+#
+# tkfx_cli_hash.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Generate the CLI commands perfect hash (middleware/cli/inc/cli_hash.h) from the CLI_COMMANDS_LIST syntaxes of cli.c.
+#
+# Each syntax (including the trailing '?' or '=') gets a command identifier and a bucket of a power of 2 table.
+# The seed is searched so that no bucket is shared: the firmware lookup is then a single hash over the command
+# characters followed by one string compare. All syntaxes are hashed whatever the build flags, so that the
+# generated file does not depend on the configuration.
+#
+# The hash must match _CLI_dispatch_callback() of cli.c (the '$' header is hashed first):
+#   h = seed, then h = (h ^ c) * multiplier (32 bits) for each character, bucket = h >> (32 - log2(table_size)).
+#
+# Usage: tkfx_cli_hash.py [--check]
+
+import argparse
+import os
+import re
+import sys
+
+ROOT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+CLI_FILE = os.path.join(ROOT_DIR, "middleware", "cli", "src", "cli.c")
+HASH_FILE = os.path.join(ROOT_DIR, "middleware", "cli", "inc", "cli_hash.h")
+
+MULTIPLIER = 0x01000193
+EMPTY = 0xFF
+
+HEADER = """/*
+ * cli_hash.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ *
+ *  Generated by script/tkfx_cli_hash.py from the CLI_COMMANDS_LIST syntaxes, do not edit.
+ */
+
+#ifndef __CLI_HASH_H__
+#define __CLI_HASH_H__
+
+/*** CLI HASH macros ***/
+
+#define CLI_HASH_SEED               0x%08X
+#define CLI_HASH_MULTIPLIER         0x%08X
+#define CLI_HASH_TABLE_SIZE_LOG2    %d
+#define CLI_HASH_TABLE_SIZE         (1 << CLI_HASH_TABLE_SIZE_LOG2)
+#define CLI_HASH_EMPTY              0x%02X
+
+/*** CLI HASH structures ***/
+
+/*!******************************************************************
+ * \\enum CLI_command_id_t
+ * \\brief CLI commands identifiers (index in the commands list).
+ *******************************************************************/
+typedef enum {
+%s
+    CLI_COMMAND_ID_LAST
+} CLI_command_id_t;
+
+/*** CLI HASH global variables ***/
+
+// Hash table content (command identifier of each bucket).
+#define CLI_HASH_BUCKETS { \\
+%s
+}
+
+#endif /* __CLI_HASH_H__ */
+"""
+
+def parse_syntaxes(path):
+    # Returns (designator, syntax) list of the CLI_COMMANDS_LIST entries.
+    with open(path) as f:
+        content = f.read()
+    match = re.search(r"static const AT_command_t CLI_COMMANDS_LIST\[[^\]]*\] = \{(.*?)^\};", content, re.S | re.M)
+    if match is None:
+        sys.exit("CLI_COMMANDS_LIST not found in " + path)
+    entries = re.findall(r"(?:\[(\w+)\]\s*=\s*)?\{\s*\.syntax\s*=\s*\"([^\"]+)\"", match.group(1))
+    if not entries:
+        sys.exit("No command found in " + path)
+    return entries
+
+def identifier(syntax):
+    name = re.sub(r"[^A-Z0-9]", "", syntax.upper())
+    if syntax.endswith("?"):
+        name += "_READ"
+    elif syntax.endswith("="):
+        name += "_WRITE"
+    return "CLI_COMMAND_ID_" + name
+
+def bucket(syntax, seed, table_size_log2):
+    h = seed
+    for char in syntax.encode("ascii"):
+        h = ((h ^ char) * MULTIPLIER) & 0xFFFFFFFF
+    return h >> (32 - table_size_log2)
+
+def search(syntaxes, table_size_log2, seed_max):
+    for seed in range(seed_max):
+        buckets = [bucket(syntax, seed, table_size_log2) for syntax in syntaxes]
+        if len(set(buckets)) == len(buckets):
+            return seed, buckets
+    return None, None
+
+def generate(syntaxes, seed, table_size_log2, buckets):
+    identifiers = [identifier(syntax) for syntax in syntaxes]
+    enum = "\n".join("    %s," % name for name in identifiers)
+    table = [EMPTY] * (1 << table_size_log2)
+    for idx, value in enumerate(buckets):
+        table[value] = idx
+    cells = [identifiers[value] if value != EMPTY else "CLI_HASH_EMPTY" for value in table]
+    lines = ["    " + ", ".join(cells[idx:idx + 4]) + ("," if (idx + 4) < len(cells) else "") + " \\" for idx in range(0, len(cells), 4)]
+    return HEADER % (seed, MULTIPLIER, table_size_log2, EMPTY, enum, "\n".join(lines))
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the CLI commands perfect hash header.")
+    parser.add_argument("--check", action="store_true", help="only check that the header is up to date")
+    parser.add_argument("--table-size-log2", type=int, default=7, help="hash table size (log2)")
+    parser.add_argument("--seed-max", type=int, default=1 << 20, help="number of seeds to try")
+    parser.add_argument("--cli-file", default=CLI_FILE, help="firmware cli.c path")
+    parser.add_argument("--hash-file", default=HASH_FILE, help="generated cli_hash.h path")
+    args = parser.parse_args()
+    entries = parse_syntaxes(args.cli_file)
+    syntaxes = [syntax for _, syntax in entries]
+    if len(set(syntaxes)) != len(syntaxes):
+        sys.exit("Duplicated command syntax")
+    if len(syntaxes) >= min(EMPTY, 1 << args.table_size_log2):
+        sys.exit("Too many commands (%d) for the table size" % len(syntaxes))
+    errors = ["%s is registered as %s" % (syntax, designator) for designator, syntax in entries if designator != identifier(syntax)]
+    seed, buckets = search(syntaxes, args.table_size_log2, args.seed_max)
+    if seed is None:
+        sys.exit("No collision-free seed found, increase --table-size-log2 or --seed-max")
+    content = generate(syntaxes, seed, args.table_size_log2, buckets)
+    if args.check:
+        try:
+            with open(args.hash_file) as f:
+                current = f.read()
+        except FileNotFoundError:
+            current = ""
+        if current != content:
+            errors.append(args.hash_file + " is not up to date")
+        if errors:
+            sys.exit("\n".join(errors))
+        print("%d commands, %d buckets, seed 0x%08X: OK" % (len(syntaxes), 1 << args.table_size_log2, seed))
+        return
+    with open(args.hash_file, "w") as f:
+        f.write(content)
+    print("%d commands, %d buckets, seed 0x%08X written to %s" % (len(syntaxes), 1 << args.table_size_log2, seed, args.hash_file))
+    for error in errors:
+        print("Warning: " + error + " in CLI_COMMANDS_LIST")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+#
+# tkfx_cli_macro.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Store a production test macro in the device NVM and run it.
+#
+# The macro file contains one CLI command per line (without the AT prefix). A leading '!' marks a step which is
+# expected to fail (negative test), empty lines and lines starting with '#' are ignored. The macro is written
+# once with AT$MACC and AT$MAC=<step>, then AT$MACR runs all steps on-device and replies one
+# '<step>:<PASS|FAIL>,<status>,<duration>ms' line per step followed by 'MACRO=<PASS|FAIL>,<passed>/<steps>,<duration>ms'.
+#
+# Usage: tkfx_cli_macro.py <port> --upload factory.mac [--run]
+#        tkfx_cli_macro.py <port> --run
+#        tkfx_cli_macro.py --check factory.mac
+#        tkfx_cli_macro.py --self-test
+
+import argparse
+import re
+import sys
+import time
+
+CLI_BAUD_RATE = 9600
+# Must match CLI_MACRO_SIZE_BYTES and CLI_MACRO_STEP_SIZE_BYTES of cli.c.
+MACRO_SIZE_BYTES = 256
+MACRO_STEP_SIZE_BYTES = 48
+
+STEP_PATTERN = re.compile(r"^(\d+):(PASS|FAIL),(?:0x)?([0-9A-Fa-f]+),(\d+)ms$")
+REPORT_PATTERN = re.compile(r"^MACRO=(PASS|FAIL),(\d+)/(\d+),(\d+)ms$")
+
+def load_steps(path):
+    with open(path, "r") as macro_file:
+        lines = [line.strip() for line in macro_file]
+    return [line for line in lines if line and not line.startswith("#")]
+
+def check_steps(steps):
+    # Returns errors list (firmware storage limits).
+    errors = []
+    for step in steps:
+        if len(step.encode("ascii")) > MACRO_STEP_SIZE_BYTES:
+            errors.append("step '%s' is longer than %d characters" % (step, MACRO_STEP_SIZE_BYTES))
+        if not step.lstrip("!").startswith("$"):
+            errors.append("step '%s' is not a CLI command" % step)
+    size = sum(len(step) + 1 for step in steps) + 1
+    if size > MACRO_SIZE_BYTES:
+        errors.append("macro size %d bytes exceeds %d bytes" % (size, MACRO_SIZE_BYTES))
+    return errors
+
+def parse_report(lines):
+    # Returns (passed, steps list of (index, result, status, duration_ms, output lines), total_ms).
+    steps = []
+    output = []
+    for line in lines:
+        match = STEP_PATTERN.match(line)
+        if match:
+            steps.append((int(match.group(1)), match.group(2), int(match.group(3), 16), int(match.group(4)), output))
+            output = []
+            continue
+        match = REPORT_PATTERN.match(line)
+        if match:
+            return (match.group(1) == "PASS"), steps, int(match.group(4))
+        output.append(line)
+    return False, steps, None
+
+def command(port, text, timeout_s=2.0):
+    # Returns (answer, lines).
+    port.reset_input_buffer()
+    port.write(("AT" + text + "\r").encode("ascii"))
+    lines = []
+    deadline = time.monotonic() + timeout_s
+    while time.monotonic() < deadline:
+        line = port.readline().decode("ascii", "replace").strip()
+        if not line:
+            continue
+        if (line == "OK") or line.startswith("ERROR"):
+            return line, lines
+        lines.append(line)
+    return "TIMEOUT", lines
+
+def upload(port, steps):
+    answer, _ = command(port, "$MACC")
+    if answer != "OK":
+        sys.exit("Macro clear failed: " + answer)
+    for step in steps:
+        answer, _ = command(port, "$MAC=" + step)
+        if answer != "OK":
+            sys.exit("Step '%s' write failed: %s" % (step, answer))
+    _, lines = command(port, "$MAC?")
+    if [line.split(":", 1)[1] for line in lines] != steps:
+        sys.exit("Macro read back mismatch")
+
+def self_test():
+    steps = ["$ADC?", "$THS?", "!$BAUD=1200"]
+    if check_steps(steps):
+        sys.exit("Self-test failed: valid macro rejected")
+    if not check_steps(["$PAT=" + "1" * MACRO_STEP_SIZE_BYTES]) or not check_steps(["$ADC?"] * 60):
+        sys.exit("Self-test failed: oversized macro accepted")
+    lines = ["VMCU=3300mV", "0:PASS,0x00,12ms", "T=21C H=40%", "1:PASS,0x00,15ms", "2:PASS,0x07,0ms", "MACRO=PASS,3/3,27ms"]
+    passed, report, total_ms = parse_report(lines)
+    if (not passed) or (len(report) != 3) or (report[1][4] != ["T=21C H=40%"]) or (report[2][2] != 7) or (total_ms != 27):
+        sys.exit("Self-test failed: report parsing")
+    passed, report, total_ms = parse_report(lines[:4])
+    if passed or (total_ms is not None):
+        sys.exit("Self-test failed: truncated report accepted")
+    print("Self-test passed")
+
+def main():
+    parser = argparse.ArgumentParser(description="CLI macro upload and execution.")
+    parser.add_argument("port", nargs="?", help="serial port")
+    parser.add_argument("--upload", default=None, help="macro file to store in the device")
+    parser.add_argument("--run", action="store_true", help="run the stored macro")
+    parser.add_argument("--timeout", type=float, default=60.0, help="macro execution timeout in seconds")
+    parser.add_argument("--check", default=None, help="only check a macro file against the firmware limits")
+    parser.add_argument("--self-test", action="store_true", help="check the macro checker and report parser")
+    args = parser.parse_args()
+    if args.self_test:
+        self_test()
+        return
+    if args.check is not None:
+        errors = check_steps(load_steps(args.check))
+        print("\n".join(errors) if errors else "OK")
+        sys.exit(1 if errors else 0)
+    if args.port is None:
+        sys.exit("Serial port is required")
+    import serial
+    with serial.Serial(args.port, CLI_BAUD_RATE, timeout=0.5) as port:
+        if args.upload is not None:
+            steps = load_steps(args.upload)
+            errors = check_steps(steps)
+            if errors:
+                sys.exit("\n".join(errors))
+            upload(port, steps)
+            print("%d steps stored" % len(steps))
+        if not args.run:
+            return
+        _, lines = command(port, "$MACR", args.timeout)
+    passed, report, total_ms = parse_report(lines)
+    for index, result, status, duration_ms, _ in report:
+        print("%3d %s status=0x%02X %6dms" % (index, result, status, duration_ms))
+    print("%s (%d/%d steps, %sms)" % ("PASS" if passed else "FAIL", sum(step[1] == "PASS" for step in report), len(report), total_ms))
+    sys.exit(0 if passed else 1)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+#
+# tkfx_cli_throughput.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Check the CLI terminal throughput and integrity at each baud rate.
+#
+# For each baud rate, the terminal is switched with AT$BAUD=<baud_rate> (the OK reply is sent at the previous
+# baud rate), then AT$PAT=<number_of_lines> makes the firmware send '<index[hex]>:<32 letters>' lines through
+# the DMA reply path. Every line is checked (sequence and content) so that any lost or corrupted byte is reported,
+# and the measured throughput is compared to the theoretical one (10 bits per byte).
+# The terminal is switched back to 9600 bauds at the end.
+#
+# Usage: tkfx_cli_throughput.py <port> [--baud-rates 19200,115200,460800] [--lines 500]
+#        tkfx_cli_throughput.py --self-test
+
+import argparse
+import sys
+import time
+
+CLI_BAUD_RATE = 9600
+BAUD_RATES = [19200, 38400, 57600, 115200, 230400, 460800]
+PATTERN_LINE_SIZE = 32
+SWITCH_DELAY_S = 0.05
+
+def pattern_line(index):
+    return "%X:" % index + "".join(chr(ord("A") + ((index + idx) % 26)) for idx in range(PATTERN_LINE_SIZE))
+
+def check_lines(lines, number_of_lines):
+    # Returns errors list.
+    errors = []
+    expected = 0
+    for line in lines:
+        try:
+            index = int(line.split(":")[0], 16)
+        except ValueError:
+            errors.append("corrupted line '%s'" % line)
+            continue
+        if index != expected:
+            errors.append("line %d received after line %d" % (index, expected - 1))
+        if line.split(":", 1)[1:] != pattern_line(index).split(":", 1)[1:]:
+            errors.append("line %d corrupted" % index)
+        expected = index + 1
+    if expected != number_of_lines:
+        errors.append("%d lines received, %d expected" % (expected, number_of_lines))
+    return errors
+
+def read_until_ok(port, timeout_s):
+    lines = []
+    raw_size = 0
+    deadline = time.monotonic() + timeout_s
+    while time.monotonic() < deadline:
+        raw = port.readline()
+        raw_size += len(raw)
+        line = raw.decode("ascii", "replace").strip()
+        if not line:
+            continue
+        if (line == "OK") or line.startswith("ERROR"):
+            return line, lines, raw_size
+        lines.append(line)
+    return "TIMEOUT", lines, raw_size
+
+def command(port, text, timeout_s=2.0):
+    port.reset_input_buffer()
+    port.write((text + "\r").encode("ascii"))
+    return read_until_ok(port, timeout_s)
+
+def switch(port, baud_rate):
+    answer, _, _ = command(port, "AT$BAUD=%d" % baud_rate)
+    if answer != "OK":
+        return False
+    port.baudrate = baud_rate
+    time.sleep(SWITCH_DELAY_S)
+    answer, _, _ = command(port, "AT")
+    return answer == "OK"
+
+def measure(port, baud_rate, number_of_lines):
+    # Returns (bytes per second, efficiency, errors).
+    timeout_s = 2.0 + (number_of_lines * (PATTERN_LINE_SIZE + 8) * 10.0 / baud_rate) * 2.0
+    start = time.monotonic()
+    answer, lines, raw_size = command(port, "AT$PAT=%d" % number_of_lines, timeout_s)
+    duration = time.monotonic() - start
+    errors = [] if answer == "OK" else ["command answer " + answer]
+    errors += check_lines(lines, number_of_lines)
+    rate = raw_size / duration
+    return rate, (rate * 10.0) / baud_rate, errors
+
+def self_test():
+    lines = [pattern_line(index) for index in range(300)]
+    if check_lines(lines, 300):
+        sys.exit("Self-test failed: valid capture rejected")
+    dropped = lines[:100] + [lines[100][:10] + lines[100][11:]] + lines[101:]
+    if not check_lines(dropped, 300):
+        sys.exit("Self-test failed: dropped byte not detected")
+    if not check_lines(lines[:150] + lines[151:], 300):
+        sys.exit("Self-test failed: dropped line not detected")
+    print("Self-test passed")
+
+def main():
+    parser = argparse.ArgumentParser(description="CLI terminal throughput and integrity check.")
+    parser.add_argument("port", nargs="?", help="serial port")
+    parser.add_argument("--baud-rates", default=",".join(str(baud_rate) for baud_rate in BAUD_RATES), help="comma separated baud rates")
+    parser.add_argument("--lines", type=int, default=500, help="number of pattern lines per baud rate")
+    parser.add_argument("--self-test", action="store_true", help="check the pattern checker")
+    args = parser.parse_args()
+    if args.self_test:
+        self_test()
+        return
+    if args.port is None:
+        sys.exit("Serial port is required")
+    import serial
+    failures = 0
+    with serial.Serial(args.port, CLI_BAUD_RATE, timeout=0.5) as port:
+        print("%10s %12s %10s  %s" % ("baud_rate", "bytes/s", "efficiency", "result"))
+        for baud_rate in [CLI_BAUD_RATE] + [int(value) for value in args.baud_rates.split(",")]:
+            if (baud_rate != port.baudrate) and (not switch(port, baud_rate)):
+                print("%10d %12s %10s  switch failed" % (baud_rate, "-", "-"))
+                failures += 1
+                continue
+            rate, efficiency, errors = measure(port, baud_rate, args.lines)
+            print("%10d %12.0f %9.0f%%  %s" % (baud_rate, rate, efficiency * 100.0, "OK" if not errors else "; ".join(errors[:3])))
+            failures += 1 if errors else 0
+        if port.baudrate != CLI_BAUD_RATE:
+            switch(port, CLI_BAUD_RATE)
+    sys.exit(1 if failures else 0)
+
+if __name__ == "__main__":
+    main()
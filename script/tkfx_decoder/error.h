@@ -0,0 +1,19 @@
+/*
+ * error.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __ERROR_H__
+#define __ERROR_H__
+
+/*
+ * Host replacement of the firmware error.h, so that host tools can include the middleware headers which only need the error code type.
+ */
+
+#include <stdint.h>
+
+typedef uint16_t ERROR_code_t;
+
+#endif /* __ERROR_H__ */
@@ -0,0 +1,700 @@
+/*
+ * tkfx_decode.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+/*
+ * Batch decoder of the TrackFox uplink frames, using the layouts of application/inc/tkfx_frames.h.
+ *
+ * Build:   gcc -O2 -mavx2 -I. -I../../application/inc -I../../middleware/fault/inc -I../../middleware/frame/inc tkfx_decoder.c tkfx_decode.c ../../middleware/frame/src/frame.c -o tkfx_decode
+ *          (drop -mavx2 for the scalar path only, types.h and error.h of this directory replace the firmware ones)
+ * Usage:   tkfx_decode [--columns] [--output <directory>] [<input_file>]
+ *              Input: one hexadecimal payload per line (stdin by default), the frame type is given by the payload size.
+ *              Output: one <frame>.csv file per frame type with the input line index, or with --columns one raw little endian
+ *              uint32 file per field (<frame>.<field>.u32). Error stack entries are always written in error_stack.csv.
+ *              Compact geolocation CSV files also give the decoded latitude and longitude in degrees.
+ *          tkfx_decode --bench [<number_of_frames>]
+ *          tkfx_decode --pack-bench [<number_of_frames>]
+ *              Firmware frame builders: former GCC big endian bit fields against FRAME_pack.
+ *          tkfx_decode --self-test
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "frame.h"
+#include "tkfx_decoder.h"
+#include "fault.h"
+#include "tkfx_frames.h"
+
+/*** TKFX DECODE local macros ***/
+
+#define TKFX_DECODE_LINE_SIZE_MAX       256
+#define TKFX_DECODE_PATH_SIZE_MAX       512
+#define TKFX_DECODE_BENCH_FRAMES        (1 << 22)
+#define TKFX_DECODE_PACK_VECTORS        1000
+#define TKFX_DECODE_POSITION_VECTORS    100000
+// Compact geolocation step in degrees, and tolerance on the decoded values (computed in double).
+#define TKFX_DECODE_LATITUDE_STEP       (180.0 / (double) (1UL << TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_SIZE_BITS))
+#define TKFX_DECODE_LONGITUDE_STEP      (360.0 / (double) (1UL << TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_SIZE_BITS))
+#define TKFX_DECODE_POSITION_EPSILON    1e-9
+
+/*** TKFX DECODE local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint8_t* frames;
+    uint32_t* index;
+    size_t number_of_frames;
+    size_t capacity;
+} TKFX_DECODE_batch_t;
+
+/*** TKFX DECODE local functions ***/
+
+/*******************************************************************/
+static int _TKFX_DECODE_parse_hex(const char* line, uint8_t* payload, size_t payload_size_max, size_t* payload_size) {
+    // Local variables.
+    int nibble = 0;
+    int high = -1;
+    // Characters loop (spaces are ignored).
+    (*payload_size) = 0;
+    for (; (*line) != '\0'; line++) {
+        if (((*line) == ' ') || ((*line) == '\t') || ((*line) == '\r') || ((*line) == '\n')) continue;
+        if (((*line) >= '0') && ((*line) <= '9')) nibble = (*line) - '0';
+        else if (((*line) >= 'a') && ((*line) <= 'f')) nibble = (*line) - 'a' + 10;
+        else if (((*line) >= 'A') && ((*line) <= 'F')) nibble = (*line) - 'A' + 10;
+        else return -1;
+        if (high < 0) {
+            high = nibble;
+            continue;
+        }
+        if ((*payload_size) >= payload_size_max) return -1;
+        payload[(*payload_size)++] = (uint8_t) ((high << 4) | nibble);
+        high = -1;
+    }
+    return ((high < 0) ? 0 : -1);
+}
+
+/*******************************************************************/
+static void _TKFX_DECODE_batch_add(TKFX_DECODE_batch_t* batch, size_t size_bytes, const uint8_t* payload, uint32_t index) {
+    // Grow buffers.
+    if ((batch -> number_of_frames) == (batch -> capacity)) {
+        batch -> capacity = ((batch -> capacity) == 0) ? 1024 : ((batch -> capacity) * 2);
+        batch -> frames = realloc(batch -> frames, (batch -> capacity) * size_bytes);
+        batch -> index = realloc(batch -> index, (batch -> capacity) * sizeof(uint32_t));
+        if (((batch -> frames) == NULL) || ((batch -> index) == NULL)) {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+    }
+    memcpy(&((batch -> frames)[(batch -> number_of_frames) * size_bytes]), payload, size_bytes);
+    (batch -> index)[(batch -> number_of_frames)++] = index;
+}
+
+/*******************************************************************/
+static FILE* _TKFX_DECODE_open(const char* directory, const char* name, const char* extension) {
+    // Local variables.
+    char path[TKFX_DECODE_PATH_SIZE_MAX];
+    FILE* file = NULL;
+    snprintf(path, sizeof(path), "%s/%s%s", directory, name, extension);
+    file = fopen(path, (extension[1] == 'c') ? "w" : "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Can't open %s\n", path);
+        exit(1);
+    }
+    return file;
+}
+
+/*******************************************************************/
+static void _TKFX_DECODE_write_batch(TKFX_DECODER_frame_t frame, const TKFX_DECODE_batch_t* batch, const char* directory, int columns_format) {
+    // Local variables.
+    const TKFX_DECODER_layout_t* layout = TKFX_DECODER_get_layout(frame);
+    uint32_t* columns[TKFX_DECODER_FIELDS_NUMBER_MAX];
+    char name[TKFX_DECODE_PATH_SIZE_MAX];
+    FILE* file = NULL;
+    double latitude_degrees = 0.0;
+    double longitude_degrees = 0.0;
+    size_t frame_idx = 0;
+    uint8_t idx = 0;
+    // Decode.
+    for (idx = 0; idx < (layout -> number_of_fields); idx++) {
+        columns[idx] = malloc((batch -> number_of_frames) * sizeof(uint32_t));
+        if (columns[idx] == NULL) {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+    }
+    TKFX_DECODER_decode_batch(frame, (batch -> frames), (layout -> size_bytes), (batch -> number_of_frames), columns);
+    // Write output.
+    if (columns_format != 0) {
+        snprintf(name, sizeof(name), "%s.index", (layout -> name));
+        file = _TKFX_DECODE_open(directory, name, ".u32");
+        fwrite((batch -> index), sizeof(uint32_t), (batch -> number_of_frames), file);
+        fclose(file);
+        for (idx = 0; idx < (layout -> number_of_fields); idx++) {
+            snprintf(name, sizeof(name), "%s.%s", (layout -> name), (layout -> fields)[idx].name);
+            file = _TKFX_DECODE_open(directory, name, ".u32");
+            fwrite(columns[idx], sizeof(uint32_t), (batch -> number_of_frames), file);
+            fclose(file);
+        }
+    }
+    else {
+        file = _TKFX_DECODE_open(directory, (layout -> name), ".csv");
+        fprintf(file, "index");
+        for (idx = 0; idx < (layout -> number_of_fields); idx++) {
+            fprintf(file, ",%s", (layout -> fields)[idx].name);
+        }
+        fprintf(file, (frame == TKFX_DECODER_FRAME_GEOLOC_COMPACT) ? ",latitude_degrees,longitude_degrees\n" : "\n");
+        for (frame_idx = 0; frame_idx < (batch -> number_of_frames); frame_idx++) {
+            fprintf(file, "%u", (batch -> index)[frame_idx]);
+            for (idx = 0; idx < (layout -> number_of_fields); idx++) {
+                fprintf(file, ",%u", columns[idx][frame_idx]);
+            }
+            if (frame == TKFX_DECODER_FRAME_GEOLOC_COMPACT) {
+                TKFX_DECODER_get_compact_position(columns[0][frame_idx], columns[1][frame_idx], &latitude_degrees, &longitude_degrees);
+                fprintf(file, ",%.6f,%.6f", latitude_degrees, longitude_degrees);
+            }
+            fprintf(file, "\n");
+        }
+        fclose(file);
+    }
+    for (idx = 0; idx < (layout -> number_of_fields); idx++) {
+        free(columns[idx]);
+    }
+}
+
+/*******************************************************************/
+static void _TKFX_DECODE_write_error_stack(const TKFX_DECODE_batch_t* batch, const char* directory) {
+    // Local variables.
+    TKFX_DECODER_error_stack_t error_stack;
+    FILE* file = _TKFX_DECODE_open(directory, "error_stack", ".csv");
+    size_t frame_idx = 0;
+    uint8_t idx = 0;
+    // One line per entry.
+    fprintf(file, "index,overflow_flag,remaining_number,code,count_min,count_max\n");
+    for (frame_idx = 0; frame_idx < (batch -> number_of_frames); frame_idx++) {
+        TKFX_DECODER_decode_error_stack(&((batch -> frames)[frame_idx * TKFX_SIGFOX_ERROR_STACK_DATA_SIZE]), &error_stack);
+        for (idx = 0; idx < error_stack.number_of_entries; idx++) {
+            fprintf(file, "%u,%u,%u,0x%04X,%u,", (batch -> index)[frame_idx], error_stack.overflow_flag, error_stack.remaining_number,
+                    error_stack.entries[idx].code, error_stack.entries[idx].count_min);
+            if (error_stack.entries[idx].count_max == UINT32_MAX) fprintf(file, "\n");
+            else fprintf(file, "%u\n", error_stack.entries[idx].count_max);
+        }
+    }
+    fclose(file);
+}
+
+/*******************************************************************/
+static int _TKFX_DECODE_decode(FILE* input, const char* directory, int columns_format) {
+    // Local variables.
+    TKFX_DECODE_batch_t batches[TKFX_DECODER_FRAME_LAST];
+    char line[TKFX_DECODE_LINE_SIZE_MAX];
+    uint8_t payload[TKFX_SIGFOX_ERROR_STACK_DATA_SIZE];
+    size_t payload_size = 0;
+    uint32_t line_idx = 0;
+    uint32_t rejected = 0;
+    TKFX_DECODER_frame_t frame = TKFX_DECODER_FRAME_STARTUP;
+    // Sort frames by type.
+    memset(batches, 0, sizeof(batches));
+    while (fgets(line, sizeof(line), input) != NULL) {
+        frame = TKFX_DECODER_FRAME_LAST;
+        if (_TKFX_DECODE_parse_hex(line, payload, sizeof(payload), &payload_size) == 0) {
+            frame = TKFX_DECODER_get_frame_type(payload_size);
+        }
+        if (frame == TKFX_DECODER_FRAME_LAST) {
+            rejected++;
+        }
+        else {
+            _TKFX_DECODE_batch_add(&(batches[frame]), payload_size, payload, line_idx);
+        }
+        line_idx++;
+    }
+    // Decode and write each type.
+    for (frame = TKFX_DECODER_FRAME_STARTUP; frame < TKFX_DECODER_FRAME_LAST; frame++) {
+        if (batches[frame].number_of_frames == 0) continue;
+        if (frame == TKFX_DECODER_FRAME_ERROR_STACK) {
+            _TKFX_DECODE_write_error_stack(&(batches[frame]), directory);
+        }
+        else {
+            _TKFX_DECODE_write_batch(frame, &(batches[frame]), directory, columns_format);
+        }
+        fprintf(stderr, "%-24s %zu\n", TKFX_DECODER_get_layout(frame) -> name, batches[frame].number_of_frames);
+        free(batches[frame].frames);
+        free(batches[frame].index);
+    }
+    if (rejected != 0) {
+        fprintf(stderr, "%-24s %u\n", "rejected lines", rejected);
+    }
+    return 0;
+}
+
+/*******************************************************************/
+static double _TKFX_DECODE_seconds(void) {
+    // Local variables.
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((double) now.tv_sec + ((double) now.tv_nsec * 1e-9));
+}
+
+/*******************************************************************/
+static int _TKFX_DECODE_bench(size_t number_of_frames) {
+    // Local variables.
+    TKFX_DECODER_frame_t frame = TKFX_DECODER_FRAME_STARTUP;
+    const TKFX_DECODER_layout_t* layout = NULL;
+    uint32_t* columns[2][TKFX_DECODER_FIELDS_NUMBER_MAX];
+    uint8_t* frames = NULL;
+    uint32_t seed = 0x12345678;
+    double start = 0.0;
+    double scalar_seconds = 0.0;
+    double batch_seconds = 0.0;
+    size_t idx = 0;
+    uint8_t field_idx = 0;
+    int errors = 0;
+    // Frames loop.
+    printf("%s path, %zu frames per type\n", (TKFX_DECODER_has_simd() != 0) ? "AVX2" : "scalar", number_of_frames);
+    printf("%-24s %14s %14s\n", "frame", "scalar [Mf/s]", "batch [Mf/s]");
+    for (frame = TKFX_DECODER_FRAME_STARTUP; frame < TKFX_DECODER_FRAME_ERROR_STACK; frame++) {
+        layout = TKFX_DECODER_get_layout(frame);
+        frames = malloc(number_of_frames * (layout -> size_bytes));
+        for (field_idx = 0; field_idx < (layout -> number_of_fields); field_idx++) {
+            columns[0][field_idx] = malloc(number_of_frames * sizeof(uint32_t));
+            columns[1][field_idx] = malloc(number_of_frames * sizeof(uint32_t));
+        }
+        for (idx = 0; idx < (number_of_frames * (layout -> size_bytes)); idx++) {
+            seed = (seed * 1103515245) + 12345;
+            frames[idx] = (uint8_t) (seed >> 16);
+        }
+        start = _TKFX_DECODE_seconds();
+        TKFX_DECODER_decode_batch_scalar(frame, frames, (layout -> size_bytes), number_of_frames, columns[0]);
+        scalar_seconds = _TKFX_DECODE_seconds() - start;
+        start = _TKFX_DECODE_seconds();
+        TKFX_DECODER_decode_batch(frame, frames, (layout -> size_bytes), number_of_frames, columns[1]);
+        batch_seconds = _TKFX_DECODE_seconds() - start;
+        for (field_idx = 0; field_idx < (layout -> number_of_fields); field_idx++) {
+            errors |= memcmp(columns[0][field_idx], columns[1][field_idx], number_of_frames * sizeof(uint32_t));
+            free(columns[0][field_idx]);
+            free(columns[1][field_idx]);
+        }
+        printf("%-24s %14.1f %14.1f\n", (layout -> name), (number_of_frames / scalar_seconds) * 1e-6, (number_of_frames / batch_seconds) * 1e-6);
+        free(frames);
+    }
+    if (errors != 0) {
+        printf("Batch and scalar outputs differ\n");
+    }
+    return ((errors != 0) ? 1 : 0);
+}
+
+/*******************************************************************/
+static void _TKFX_DECODE_write_bits(uint8_t* frame, uint32_t* bit_idx, uint32_t value, uint8_t size_bits) {
+    // Local variables.
+    uint8_t idx = 0;
+    // MSB first (same as the firmware fault encoder).
+    for (idx = size_bits; idx > 0; idx--) {
+        if (((value >> (idx - 1)) & 0b1) != 0) {
+            frame[(*bit_idx) >> 3] |= (uint8_t) (0b1 << (7 - ((*bit_idx) & 0b111)));
+        }
+        (*bit_idx)++;
+    }
+}
+
+#if (defined __GNUC__) && !(defined __clang__)
+// Former firmware frames representation: GCC big endian bit fields generated from the same layouts.
+#define TKFX_DECODE_BITFIELD(name, size_bits)   unsigned name : size_bits;
+#define TKFX_DECODE_UNION(type, size_bytes, fields) \
+    typedef union { \
+        uint8_t frame[size_bytes]; \
+        struct { fields(TKFX_DECODE_BITFIELD) } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)); \
+    } type;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wscalar-storage-order"
+TKFX_DECODE_UNION(TKFX_DECODE_startup_t, TKFX_SIGFOX_STARTUP_DATA_SIZE, TKFX_SIGFOX_STARTUP_FIELDS)
+TKFX_DECODE_UNION(TKFX_DECODE_monitoring_t, TKFX_SIGFOX_MONITORING_BASE_DATA_SIZE, TKFX_SIGFOX_MONITORING_BASE_FIELDS)
+TKFX_DECODE_UNION(TKFX_DECODE_monitoring_stack_usage_t, TKFX_SIGFOX_MONITORING_STACK_USAGE_DATA_SIZE, TKFX_SIGFOX_MONITORING_STACK_USAGE_FIELDS)
+TKFX_DECODE_UNION(TKFX_DECODE_geoloc_t, TKFX_SIGFOX_GEOLOC_DATA_SIZE, TKFX_SIGFOX_GEOLOC_FIELDS)
+TKFX_DECODE_UNION(TKFX_DECODE_geoloc_timeout_t, TKFX_SIGFOX_GEOLOC_TIMEOUT_DATA_SIZE, TKFX_SIGFOX_GEOLOC_TIMEOUT_FIELDS)
+TKFX_DECODE_UNION(TKFX_DECODE_diagnostics_t, TKFX_SIGFOX_DIAGNOSTICS_DATA_SIZE, TKFX_SIGFOX_DIAGNOSTICS_FIELDS)
+TKFX_DECODE_UNION(TKFX_DECODE_geoloc_compact_t, TKFX_SIGFOX_GEOLOC_COMPACT_DATA_SIZE, TKFX_SIGFOX_GEOLOC_COMPACT_FIELDS)
+// Monitoring status byte: former big endian declaration (MSB first) and native one of main.c (LSB first).
+typedef union {
+    struct {
+        unsigned gps_backup_status :1;
+        unsigned accelerometer_status :1;
+        unsigned lse_status :1;
+        unsigned lsi_status :1;
+        unsigned moving_flag :1;
+        unsigned alarm_flag :1;
+        unsigned tracker_mode :2;
+    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+    uint8_t all;
+} TKFX_DECODE_status_big_endian_t;
+#pragma GCC diagnostic pop
+typedef union {
+    struct {
+        unsigned tracker_mode :2;
+        unsigned alarm_flag :1;
+        unsigned moving_flag :1;
+        unsigned lsi_status :1;
+        unsigned lse_status :1;
+        unsigned accelerometer_status :1;
+        unsigned gps_backup_status :1;
+    } __attribute__((packed));
+    uint8_t all;
+} TKFX_DECODE_status_native_t;
+// Build a frame with both representations from the same values, returns 0 if they are bit identical.
+#define TKFX_DECODE_ASSIGN(name, size_bits)     bitfields.name = values[field_idx++];
+#define TKFX_DECODE_PACK_CHECK(function, type, fields) \
+    static int function(const uint32_t* values) { \
+        static const uint8_t layout[] = { fields(FRAME_FIELD_SIZE) }; \
+        type bitfields; \
+        uint8_t frame[sizeof(bitfields.frame)]; \
+        uint8_t field_idx = 0; \
+        memset(&bitfields, 0, sizeof(bitfields)); \
+        fields(TKFX_DECODE_ASSIGN) \
+        FRAME_pack(frame, layout, sizeof(layout), values); \
+        return memcmp(frame, bitfields.frame, sizeof(frame)); \
+    }
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+TKFX_DECODE_PACK_CHECK(_TKFX_DECODE_pack_check_startup, TKFX_DECODE_startup_t, TKFX_SIGFOX_STARTUP_FIELDS)
+TKFX_DECODE_PACK_CHECK(_TKFX_DECODE_pack_check_monitoring, TKFX_DECODE_monitoring_t, TKFX_SIGFOX_MONITORING_BASE_FIELDS)
+TKFX_DECODE_PACK_CHECK(_TKFX_DECODE_pack_check_monitoring_stack_usage, TKFX_DECODE_monitoring_stack_usage_t, TKFX_SIGFOX_MONITORING_STACK_USAGE_FIELDS)
+TKFX_DECODE_PACK_CHECK(_TKFX_DECODE_pack_check_geoloc, TKFX_DECODE_geoloc_t, TKFX_SIGFOX_GEOLOC_FIELDS)
+TKFX_DECODE_PACK_CHECK(_TKFX_DECODE_pack_check_geoloc_timeout, TKFX_DECODE_geoloc_timeout_t, TKFX_SIGFOX_GEOLOC_TIMEOUT_FIELDS)
+TKFX_DECODE_PACK_CHECK(_TKFX_DECODE_pack_check_diagnostics, TKFX_DECODE_diagnostics_t, TKFX_SIGFOX_DIAGNOSTICS_FIELDS)
+TKFX_DECODE_PACK_CHECK(_TKFX_DECODE_pack_check_geoloc_compact, TKFX_DECODE_geoloc_compact_t, TKFX_SIGFOX_GEOLOC_COMPACT_FIELDS)
+#pragma GCC diagnostic pop
+// Checks indexed by TKFX_DECODER_frame_t.
+static int (*const TKFX_DECODE_PACK_CHECK[TKFX_DECODER_FRAME_ERROR_STACK])(const uint32_t* values) = {
+    &_TKFX_DECODE_pack_check_startup,
+    &_TKFX_DECODE_pack_check_monitoring,
+    &_TKFX_DECODE_pack_check_monitoring_stack_usage,
+    &_TKFX_DECODE_pack_check_geoloc,
+    &_TKFX_DECODE_pack_check_geoloc_timeout,
+    &_TKFX_DECODE_pack_check_diagnostics,
+    &_TKFX_DECODE_pack_check_geoloc_compact
+};
+#endif
+
+/*******************************************************************/
+static int _TKFX_DECODE_pack_bench(size_t number_of_frames) {
+#if (defined __GNUC__) && !(defined __clang__)
+    // Local variables.
+    static const uint8_t layout[] = { TKFX_SIGFOX_GEOLOC_FIELDS(FRAME_FIELD_SIZE) };
+    TKFX_DECODE_geoloc_t bitfields;
+    uint8_t frame[TKFX_SIGFOX_GEOLOC_DATA_SIZE];
+    uint32_t* values = NULL;
+    uint32_t seed = 0x12345678;
+    uint8_t checksum[2] = { 0, 0 };
+    double start = 0.0;
+    double bitfields_seconds = 0.0;
+    double pack_seconds = 0.0;
+    size_t idx = 0;
+    uint8_t field_idx = 0;
+    // Random in range values.
+    values = malloc(number_of_frames * sizeof(layout) * sizeof(uint32_t));
+    if (values == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    for (idx = 0; idx < (number_of_frames * sizeof(layout)); idx++) {
+        seed = (seed * 1103515245) + 12345;
+        values[idx] = seed & ((0b1UL << layout[idx % sizeof(layout)]) - 1);
+    }
+    // Former bit fields builder.
+    memset(&bitfields, 0, sizeof(bitfields));
+    start = _TKFX_DECODE_seconds();
+    for (idx = 0; idx < number_of_frames; idx++) {
+        const uint32_t* frame_values = &(values[idx * sizeof(layout)]);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#define TKFX_DECODE_ASSIGN_BENCH(name, size_bits)   bitfields.name = frame_values[field_idx++];
+        field_idx = 0;
+        TKFX_SIGFOX_GEOLOC_FIELDS(TKFX_DECODE_ASSIGN_BENCH)
+#pragma GCC diagnostic pop
+        for (field_idx = 0; field_idx < sizeof(frame); field_idx++) {
+            checksum[0] ^= (uint8_t) (bitfields.frame[field_idx] + idx);
+        }
+    }
+    bitfields_seconds = _TKFX_DECODE_seconds() - start;
+    // Table driven packer.
+    start = _TKFX_DECODE_seconds();
+    for (idx = 0; idx < number_of_frames; idx++) {
+        FRAME_pack(frame, layout, sizeof(layout), &(values[idx * sizeof(layout)]));
+        for (field_idx = 0; field_idx < sizeof(frame); field_idx++) {
+            checksum[1] ^= (uint8_t) (frame[field_idx] + idx);
+        }
+    }
+    pack_seconds = _TKFX_DECODE_seconds() - start;
+    free(values);
+    printf("%zu geoloc frames (host timings, not representative of the Cortex-M0+ which has no unaligned access)\n", number_of_frames);
+    printf("%-24s %14.1f ns/frame\n", "big endian bit fields", (bitfields_seconds / number_of_frames) * 1e9);
+    printf("%-24s %14.1f ns/frame\n", "FRAME_pack", (pack_seconds / number_of_frames) * 1e9);
+    if (checksum[0] != checksum[1]) {
+        printf("Bit fields and packer outputs differ\n");
+        return 1;
+    }
+    return 0;
+#else
+    (void) number_of_frames;
+    printf("Bit fields reference requires GCC\n");
+    return 1;
+#endif
+}
+
+/*******************************************************************/
+static int _TKFX_DECODE_check_compact_position(uint32_t latitude_units, uint8_t north_flag, uint32_t longitude_units, uint8_t east_flag) {
+    // Local variables.
+    static const uint8_t layout[] = { TKFX_SIGFOX_GEOLOC_COMPACT_FIELDS(FRAME_FIELD_SIZE) };
+    uint8_t frame[TKFX_SIGFOX_GEOLOC_COMPACT_DATA_SIZE];
+    uint32_t values[sizeof(layout)] = { 0 };
+    uint32_t column_data[sizeof(layout)];
+    uint32_t* columns[sizeof(layout)];
+    double latitude_degrees = 0.0;
+    double longitude_degrees = 0.0;
+    double latitude_error = 0.0;
+    double longitude_error = 0.0;
+    uint8_t idx = 0;
+    // Encode as the firmware compact geolocation builder.
+    values[0] = (north_flag != 0) ? ((TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_FULL_SCALE >> 1) + latitude_units) : ((TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_FULL_SCALE >> 1) - latitude_units);
+    values[0] = FRAME_quantize(values[0], TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_FULL_SCALE, TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_SIZE_BITS);
+    values[1] = (east_flag != 0) ? ((TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_FULL_SCALE >> 1) + longitude_units) : ((TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_FULL_SCALE >> 1) - longitude_units);
+    values[1] = FRAME_quantize_wrap(values[1], TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_FULL_SCALE, TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_SIZE_BITS);
+    FRAME_pack(frame, layout, sizeof(layout), values);
+    // Decode.
+    for (idx = 0; idx < sizeof(layout); idx++) {
+        columns[idx] = &(column_data[idx]);
+    }
+    TKFX_DECODER_decode_batch(TKFX_DECODER_FRAME_GEOLOC_COMPACT, frame, sizeof(frame), 1, columns);
+    TKFX_DECODER_get_compact_position(column_data[0], column_data[1], &latitude_degrees, &longitude_degrees);
+    // Rounding error is at most half a step, one step for the saturated latitude code (north pole).
+    latitude_error = latitude_degrees - (((north_flag != 0) ? 1.0 : -1.0) * ((double) latitude_units / (double) TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(1, 0, 0)));
+    longitude_error = longitude_degrees - (((east_flag != 0) ? 1.0 : -1.0) * ((double) longitude_units / (double) TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(1, 0, 0)));
+    // Longitude wraps at the antimeridian (180 degrees east is decoded as 180 degrees west).
+    if (longitude_error > 180.0) longitude_error -= 360.0;
+    if (longitude_error < -180.0) longitude_error += 360.0;
+    if ((latitude_error < 0.0 ? -latitude_error : latitude_error) > ((column_data[0] == ((1UL << TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_SIZE_BITS) - 1)) ? TKFX_DECODE_LATITUDE_STEP : (TKFX_DECODE_LATITUDE_STEP / 2.0)) + TKFX_DECODE_POSITION_EPSILON) return 1;
+    if ((longitude_error < 0.0 ? -longitude_error : longitude_error) > ((TKFX_DECODE_LONGITUDE_STEP / 2.0) + TKFX_DECODE_POSITION_EPSILON)) return 1;
+    return 0;
+}
+
+/*******************************************************************/
+static int _TKFX_DECODE_self_test(void) {
+    // Local variables.
+    TKFX_DECODER_frame_t frame = TKFX_DECODER_FRAME_STARTUP;
+    const TKFX_DECODER_layout_t* layout = NULL;
+    TKFX_DECODER_error_stack_t error_stack;
+    uint8_t error_frame[TKFX_SIGFOX_ERROR_STACK_DATA_SIZE] = { 0 };
+    uint8_t frames[37 * TKFX_SIGFOX_ERROR_STACK_DATA_SIZE];
+    uint32_t column_data[2][TKFX_DECODER_FIELDS_NUMBER_MAX][37];
+    uint32_t* columns[2][TKFX_DECODER_FIELDS_NUMBER_MAX];
+    uint32_t bit_idx = 0;
+    uint32_t size_bits = 0;
+    uint32_t seed = 1;
+    uint32_t random = 0;
+    uint32_t latitude_units = 0;
+    uint32_t longitude_units = 0;
+    size_t idx = 0;
+    uint8_t field_idx = 0;
+    // Layouts must fill their frame exactly.
+    for (frame = TKFX_DECODER_FRAME_STARTUP; frame < TKFX_DECODER_FRAME_ERROR_STACK; frame++) {
+        layout = TKFX_DECODER_get_layout(frame);
+        size_bits = 0;
+        for (field_idx = 0; field_idx < (layout -> number_of_fields); field_idx++) {
+            size_bits += (layout -> fields)[field_idx].size_bits;
+        }
+        if ((size_bits != ((uint32_t) (layout -> size_bytes) * 8)) || ((layout -> number_of_fields) > TKFX_DECODER_FIELDS_NUMBER_MAX)) {
+            printf("Self-test failed: %s layout is %u bits\n", (layout -> name), size_bits);
+            return 1;
+        }
+        if (TKFX_DECODER_get_frame_type(layout -> size_bytes) != frame) {
+            printf("Self-test failed: %s size is not unique\n", (layout -> name));
+            return 1;
+        }
+    }
+    // Batch and scalar paths must match on odd strides and frame counts.
+    for (idx = 0; idx < sizeof(frames); idx++) {
+        seed = (seed * 1103515245) + 12345;
+        frames[idx] = (uint8_t) (seed >> 16);
+    }
+    for (frame = TKFX_DECODER_FRAME_STARTUP; frame < TKFX_DECODER_FRAME_ERROR_STACK; frame++) {
+        layout = TKFX_DECODER_get_layout(frame);
+        for (field_idx = 0; field_idx < (layout -> number_of_fields); field_idx++) {
+            columns[0][field_idx] = column_data[0][field_idx];
+            columns[1][field_idx] = column_data[1][field_idx];
+        }
+        TKFX_DECODER_decode_batch_scalar(frame, frames, TKFX_SIGFOX_ERROR_STACK_DATA_SIZE, 37, columns[0]);
+        TKFX_DECODER_decode_batch(frame, frames, TKFX_SIGFOX_ERROR_STACK_DATA_SIZE, 37, columns[1]);
+        if (memcmp(column_data[0], column_data[1], (layout -> number_of_fields) * sizeof(column_data[0][0])) != 0) {
+            printf("Self-test failed: %s batch and scalar outputs differ\n", (layout -> name));
+            return 1;
+        }
+    }
+#if (defined __GNUC__) && !(defined __clang__)
+    // Decoded fields must match the values written in the firmware bit fields.
+    {
+        TKFX_DECODE_geoloc_t geoloc;
+        TKFX_DECODE_startup_t startup;
+        memset(&geoloc, 0, sizeof(geoloc));
+        memset(&startup, 0, sizeof(startup));
+        geoloc.latitude_degrees = 43;
+        geoloc.latitude_minutes = 36;
+        geoloc.latitude_seconds = 98765;
+        geoloc.latitude_north_flag = 1;
+        geoloc.longitude_degrees = 1;
+        geoloc.longitude_minutes = 26;
+        geoloc.longitude_seconds = 12345;
+        geoloc.longitude_east_flag = 1;
+        geoloc.altitude_meters = 1234;
+        geoloc.gps_fix_duration_seconds = 42;
+        startup.reset_reason = 0x0C;
+        startup.commit_id = 0x0ABCDEF1;
+        startup.dirty_flag = 1;
+        for (field_idx = 0; field_idx < TKFX_DECODER_FIELDS_NUMBER_MAX; field_idx++) {
+            columns[0][field_idx] = column_data[0][field_idx];
+        }
+        TKFX_DECODER_decode_batch(TKFX_DECODER_FRAME_GEOLOC, geoloc.frame, TKFX_SIGFOX_GEOLOC_DATA_SIZE, 1, columns[0]);
+        if ((column_data[0][0][0] != 43) || (column_data[0][2][0] != 98765) || (column_data[0][3][0] != 1) || (column_data[0][6][0] != 12345) || (column_data[0][8][0] != 1234) || (column_data[0][9][0] != 42)) {
+            printf("Self-test failed: geoloc bit fields mismatch\n");
+            return 1;
+        }
+        TKFX_DECODER_decode_batch(TKFX_DECODER_FRAME_STARTUP, startup.frame, TKFX_SIGFOX_STARTUP_DATA_SIZE, 1, columns[0]);
+        if ((column_data[0][0][0] != 0x0C) || (column_data[0][4][0] != 0x0ABCDEF1) || (column_data[0][5][0] != 1)) {
+            printf("Self-test failed: startup bit fields mismatch\n");
+            return 1;
+        }
+    }
+    // Firmware packer must be bit identical to the former bit fields, including values larger than their field.
+    {
+        static const uint32_t GEOLOC_VALUES[] = { 43, 36, 98765, 1, 1, 26, 12345, 1, 1234, 42 };
+        static const uint8_t GEOLOC_FRAME[TKFX_SIGFOX_GEOLOC_DATA_SIZE] = { 0x2B, 0x93, 0x03, 0x9B, 0x01, 0x68, 0x60, 0x73, 0x04, 0xD2, 0x2A };
+        static const uint8_t GEOLOC_LAYOUT[] = { TKFX_SIGFOX_GEOLOC_FIELDS(FRAME_FIELD_SIZE) };
+        TKFX_DECODE_status_big_endian_t status_big_endian;
+        TKFX_DECODE_status_native_t status_native;
+        uint32_t values[TKFX_DECODER_FIELDS_NUMBER_MAX];
+        uint8_t packed[TKFX_SIGFOX_GEOLOC_DATA_SIZE];
+        FRAME_pack(packed, GEOLOC_LAYOUT, sizeof(GEOLOC_LAYOUT), GEOLOC_VALUES);
+        if (memcmp(packed, GEOLOC_FRAME, sizeof(packed)) != 0) {
+            printf("Self-test failed: geoloc golden frame\n");
+            return 1;
+        }
+        for (frame = TKFX_DECODER_FRAME_STARTUP; frame < TKFX_DECODER_FRAME_ERROR_STACK; frame++) {
+            layout = TKFX_DECODER_get_layout(frame);
+            for (idx = 0; idx < TKFX_DECODE_PACK_VECTORS; idx++) {
+                for (field_idx = 0; field_idx < (layout -> number_of_fields); field_idx++) {
+                    seed = (seed * 1103515245) + 12345;
+                    values[field_idx] = (seed << 16) | ((seed >> 16) & 0xFFFF);
+                    // Half of the vectors only use in range values.
+                    if (((idx & 0b1) != 0) && ((layout -> fields)[field_idx].size_bits < 32)) {
+                        values[field_idx] &= (0b1UL << (layout -> fields)[field_idx].size_bits) - 1;
+                    }
+                }
+                if (TKFX_DECODE_PACK_CHECK[frame](values) != 0) {
+                    printf("Self-test failed: %s packed frame differs from bit fields\n", (layout -> name));
+                    return 1;
+                }
+            }
+        }
+        for (idx = 0; idx < 256; idx++) {
+            status_big_endian.gps_backup_status = status_native.gps_backup_status = (idx >> 7) & 0b1;
+            status_big_endian.accelerometer_status = status_native.accelerometer_status = (idx >> 6) & 0b1;
+            status_big_endian.lse_status = status_native.lse_status = (idx >> 5) & 0b1;
+            status_big_endian.lsi_status = status_native.lsi_status = (idx >> 4) & 0b1;
+            status_big_endian.moving_flag = status_native.moving_flag = (idx >> 3) & 0b1;
+            status_big_endian.alarm_flag = status_native.alarm_flag = (idx >> 2) & 0b1;
+            status_big_endian.tracker_mode = status_native.tracker_mode = idx & 0b11;
+            if ((status_big_endian.all != idx) || (status_native.all != idx)) {
+                printf("Self-test failed: monitoring status byte\n");
+                return 1;
+            }
+        }
+    }
+#endif
+    // Compact geolocation error bounds: poles, equator, meridians, then random positions.
+    if ((_TKFX_DECODE_check_compact_position(TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(90, 0, 0), 1, TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(180, 0, 0), 1) != 0) ||
+        (_TKFX_DECODE_check_compact_position(TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(90, 0, 0), 0, TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(180, 0, 0), 0) != 0) ||
+        (_TKFX_DECODE_check_compact_position(0, 1, 0, 1) != 0) || (_TKFX_DECODE_check_compact_position(0, 0, 0, 0) != 0) ||
+        (_TKFX_DECODE_check_compact_position(TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(89, 59, 99999), 1, TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(179, 59, 99999), 1) != 0)) {
+        printf("Self-test failed: compact geoloc limits\n");
+        return 1;
+    }
+    for (idx = 0; idx < TKFX_DECODE_POSITION_VECTORS; idx++) {
+        seed = (seed * 1103515245) + 12345;
+        random = (seed & 0xFFFF0000);
+        seed = (seed * 1103515245) + 12345;
+        random |= (seed >> 16);
+        latitude_units = random % TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(90, 0, 0);
+        longitude_units = random % TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(180, 0, 0);
+        if (_TKFX_DECODE_check_compact_position(latitude_units, (uint8_t) (idx & 0b1), longitude_units, (uint8_t) ((idx >> 1) & 0b1)) != 0) {
+            printf("Self-test failed: compact geoloc error bound\n");
+            return 1;
+        }
+    }
+    // Error stack: full entry, offset entry in the same base, saturated count, then end marker.
+    _TKFX_DECODE_write_bits(error_frame, &bit_idx, 0b1010, FAULT_HEADER_SIZE_BITS);
+    _TKFX_DECODE_write_bits(error_frame, &bit_idx, 0, FAULT_TAG_SIZE_BITS);
+    _TKFX_DECODE_write_bits(error_frame, &bit_idx, 0x1234, FAULT_CODE_SIZE_BITS);
+    _TKFX_DECODE_write_bits(error_frame, &bit_idx, 2, FAULT_COUNT_SIZE_BITS);
+    _TKFX_DECODE_write_bits(error_frame, &bit_idx, 1, FAULT_TAG_SIZE_BITS);
+    _TKFX_DECODE_write_bits(error_frame, &bit_idx, 0x56, FAULT_OFFSET_SIZE_BITS);
+    _TKFX_DECODE_write_bits(error_frame, &bit_idx, 15, FAULT_COUNT_SIZE_BITS);
+    TKFX_DECODER_decode_error_stack(error_frame, &error_stack);
+    if ((error_stack.overflow_flag != 1) || (error_stack.remaining_number != 2) || (error_stack.number_of_entries != 2) ||
+        (error_stack.entries[0].code != 0x1234) || (error_stack.entries[0].count_min != 3) ||
+        (error_stack.entries[1].code != 0x1256) || (error_stack.entries[1].count_min != 1025) || (error_stack.entries[1].count_max != UINT32_MAX)) {
+        printf("Self-test failed: error stack\n");
+        return 1;
+    }
+    printf("Self-test passed\n");
+    return 0;
+}
+
+/*** TKFX DECODE functions ***/
+
+/*******************************************************************/
+int main(int argc, char** argv) {
+    // Local variables.
+    const char* directory = ".";
+    const char* input_path = NULL;
+    FILE* input = stdin;
+    int columns_format = 0;
+    int status = 0;
+    int idx = 0;
+    // Parse arguments.
+    for (idx = 1; idx < argc; idx++) {
+        if (strcmp(argv[idx], "--self-test") == 0) {
+            return _TKFX_DECODE_self_test();
+        }
+        if (strcmp(argv[idx], "--bench") == 0) {
+            return _TKFX_DECODE_bench(((idx + 1) < argc) ? (size_t) strtoul(argv[idx + 1], NULL, 0) : TKFX_DECODE_BENCH_FRAMES);
+        }
+        if (strcmp(argv[idx], "--pack-bench") == 0) {
+            return _TKFX_DECODE_pack_bench(((idx + 1) < argc) ? (size_t) strtoul(argv[idx + 1], NULL, 0) : TKFX_DECODE_BENCH_FRAMES);
+        }
+        if (strcmp(argv[idx], "--columns") == 0) {
+            columns_format = 1;
+        }
+        else if ((strcmp(argv[idx], "--output") == 0) && ((idx + 1) < argc)) {
+            directory = argv[++idx];
+        }
+        else {
+            input_path = argv[idx];
+        }
+    }
+    if (input_path != NULL) {
+        input = fopen(input_path, "r");
+        if (input == NULL) {
+            fprintf(stderr, "Can't open %s\n", input_path);
+            return 1;
+        }
+    }
+    status = _TKFX_DECODE_decode(input, directory, columns_format);
+    if (input != stdin) {
+        fclose(input);
+    }
+    return status;
+}
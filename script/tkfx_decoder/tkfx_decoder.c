@@ -0,0 +1,259 @@
+/*
+ * tkfx_decoder.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "tkfx_decoder.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "fault.h"
+#include "tkfx_frames.h"
+
+/*** TKFX DECODER local macros ***/
+
+// Fields are read with 64-bits big endian loads in a zero padded copy of the frame (error stack is the largest frame).
+#define TKFX_DECODER_LOAD_SIZE_BYTES        8
+#define TKFX_DECODER_FRAME_BUFFER_SIZE      (TKFX_SIGFOX_ERROR_STACK_DATA_SIZE + TKFX_DECODER_LOAD_SIZE_BYTES)
+#define TKFX_DECODER_COUNT_EXACT_MAX        8
+#define TKFX_DECODER_COUNT_CODE_SATURATED   ((1 << FAULT_COUNT_SIZE_BITS) - 1)
+// Compact geolocation units per degree (1/100000 minute).
+#define TKFX_DECODER_UNITS_PER_DEGREE       ((double) TKFX_SIGFOX_GEOLOC_COMPACT_UNITS(1, 0, 0))
+
+#define TKFX_DECODER_FIELD(name, size_bits) { #name, size_bits },
+
+/*** TKFX DECODER local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint8_t byte_index[TKFX_DECODER_FIELDS_NUMBER_MAX];
+    uint8_t shift_left[TKFX_DECODER_FIELDS_NUMBER_MAX];
+    uint8_t shift_right[TKFX_DECODER_FIELDS_NUMBER_MAX];
+    uint8_t max_byte_index;
+} TKFX_DECODER_plan_t;
+
+/*** TKFX DECODER local global variables ***/
+
+static const TKFX_DECODER_field_t TKFX_DECODER_STARTUP_FIELDS[] = { TKFX_SIGFOX_STARTUP_FIELDS(TKFX_DECODER_FIELD) };
+static const TKFX_DECODER_field_t TKFX_DECODER_MONITORING_FIELDS[] = { TKFX_SIGFOX_MONITORING_BASE_FIELDS(TKFX_DECODER_FIELD) };
+static const TKFX_DECODER_field_t TKFX_DECODER_MONITORING_STACK_USAGE_FIELDS[] = { TKFX_SIGFOX_MONITORING_STACK_USAGE_FIELDS(TKFX_DECODER_FIELD) };
+static const TKFX_DECODER_field_t TKFX_DECODER_GEOLOC_FIELDS[] = { TKFX_SIGFOX_GEOLOC_FIELDS(TKFX_DECODER_FIELD) };
+static const TKFX_DECODER_field_t TKFX_DECODER_GEOLOC_TIMEOUT_FIELDS[] = { TKFX_SIGFOX_GEOLOC_TIMEOUT_FIELDS(TKFX_DECODER_FIELD) };
+static const TKFX_DECODER_field_t TKFX_DECODER_DIAGNOSTICS_FIELDS[] = { TKFX_SIGFOX_DIAGNOSTICS_FIELDS(TKFX_DECODER_FIELD) };
+static const TKFX_DECODER_field_t TKFX_DECODER_GEOLOC_COMPACT_FIELDS[] = { TKFX_SIGFOX_GEOLOC_COMPACT_FIELDS(TKFX_DECODER_FIELD) };
+
+#define TKFX_DECODER_LAYOUT(name, size_bytes, fields) { name, size_bytes, (uint8_t) (sizeof(fields) / sizeof(TKFX_DECODER_field_t)), fields }
+
+static const TKFX_DECODER_layout_t TKFX_DECODER_LAYOUTS[TKFX_DECODER_FRAME_LAST] = {
+    TKFX_DECODER_LAYOUT("startup", TKFX_SIGFOX_STARTUP_DATA_SIZE, TKFX_DECODER_STARTUP_FIELDS),
+    TKFX_DECODER_LAYOUT("monitoring", TKFX_SIGFOX_MONITORING_BASE_DATA_SIZE, TKFX_DECODER_MONITORING_FIELDS),
+    TKFX_DECODER_LAYOUT("monitoring_stack_usage", TKFX_SIGFOX_MONITORING_STACK_USAGE_DATA_SIZE, TKFX_DECODER_MONITORING_STACK_USAGE_FIELDS),
+    TKFX_DECODER_LAYOUT("geoloc", TKFX_SIGFOX_GEOLOC_DATA_SIZE, TKFX_DECODER_GEOLOC_FIELDS),
+    TKFX_DECODER_LAYOUT("geoloc_timeout", TKFX_SIGFOX_GEOLOC_TIMEOUT_DATA_SIZE, TKFX_DECODER_GEOLOC_TIMEOUT_FIELDS),
+    TKFX_DECODER_LAYOUT("diagnostics", TKFX_SIGFOX_DIAGNOSTICS_DATA_SIZE, TKFX_DECODER_DIAGNOSTICS_FIELDS),
+    TKFX_DECODER_LAYOUT("geoloc_compact", TKFX_SIGFOX_GEOLOC_COMPACT_DATA_SIZE, TKFX_DECODER_GEOLOC_COMPACT_FIELDS),
+    { "error_stack", TKFX_SIGFOX_ERROR_STACK_DATA_SIZE, 0, NULL }
+};
+
+/*** TKFX DECODER local functions ***/
+
+/*******************************************************************/
+static void _TKFX_DECODER_build_plan(const TKFX_DECODER_layout_t* layout, TKFX_DECODER_plan_t* plan) {
+    // Local variables.
+    uint32_t offset_bits = 0;
+    uint8_t idx = 0;
+    // Each field is (load_be64(frame + byte_index) << shift_left) >> shift_right.
+    plan -> max_byte_index = 0;
+    for (idx = 0; idx < (layout -> number_of_fields); idx++) {
+        plan -> byte_index[idx] = (uint8_t) (offset_bits >> 3);
+        plan -> shift_left[idx] = (uint8_t) (offset_bits & 0b111);
+        plan -> shift_right[idx] = (uint8_t) (64 - (layout -> fields)[idx].size_bits);
+        if ((plan -> byte_index[idx]) > (plan -> max_byte_index)) {
+            plan -> max_byte_index = plan -> byte_index[idx];
+        }
+        offset_bits += (layout -> fields)[idx].size_bits;
+    }
+}
+
+/*******************************************************************/
+static inline uint64_t _TKFX_DECODER_load_be64(const uint8_t* data) {
+    // Local variables.
+    uint64_t value = 0;
+    memcpy(&value, data, sizeof(uint64_t));
+#if (defined __BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+/*******************************************************************/
+static void _TKFX_DECODER_decode_scalar(const TKFX_DECODER_layout_t* layout, const TKFX_DECODER_plan_t* plan, const uint8_t* frames, size_t stride_bytes, size_t first_frame, size_t number_of_frames, uint32_t** columns) {
+    // Local variables.
+    uint8_t buffer[TKFX_DECODER_FRAME_BUFFER_SIZE] = { 0 };
+    size_t frame_idx = 0;
+    uint8_t idx = 0;
+    // Frames loop.
+    for (frame_idx = first_frame; frame_idx < number_of_frames; frame_idx++) {
+        memcpy(buffer, &(frames[frame_idx * stride_bytes]), (layout -> size_bytes));
+        // Fields loop (no data dependent branch).
+        for (idx = 0; idx < (layout -> number_of_fields); idx++) {
+            columns[idx][frame_idx] = (uint32_t) ((_TKFX_DECODER_load_be64(&(buffer[plan -> byte_index[idx]])) << (plan -> shift_left[idx])) >> (plan -> shift_right[idx]));
+        }
+    }
+}
+
+/*******************************************************************/
+static inline uint32_t _TKFX_DECODER_read_bits(const uint8_t* buffer, uint32_t* bit_idx, uint8_t size_bits) {
+    // Local variables.
+    uint32_t value = (uint32_t) ((_TKFX_DECODER_load_be64(&(buffer[(*bit_idx) >> 3])) << ((*bit_idx) & 0b111)) >> (64 - size_bits));
+    (*bit_idx) += size_bits;
+    return value;
+}
+
+#ifdef __AVX2__
+/*******************************************************************/
+static size_t _TKFX_DECODER_decode_avx2(const TKFX_DECODER_layout_t* layout, const TKFX_DECODER_plan_t* plan, const uint8_t* frames, size_t stride_bytes, size_t number_of_frames, uint32_t** columns) {
+    // Local variables.
+    const __m256i bswap64 = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                             7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const __m256i pack32 = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m256i offsets = _mm256_setr_epi64x(0, (long long) stride_bytes, (long long) (2 * stride_bytes), (long long) (3 * stride_bytes));
+    size_t input_size = 0;
+    size_t frame_idx = 0;
+    __m256i value;
+    uint8_t idx = 0;
+    // 4 frames per iteration, the 64-bits loads of the last frames must not cross the end of the buffer.
+    input_size = ((number_of_frames - 1) * stride_bytes) + (layout -> size_bytes);
+    for (frame_idx = 0; (((frame_idx + 3) * stride_bytes) + (plan -> max_byte_index) + TKFX_DECODER_LOAD_SIZE_BYTES) <= input_size; frame_idx += 4) {
+        for (idx = 0; idx < (layout -> number_of_fields); idx++) {
+            // Gather the 4 frames bytes, swap to big endian and isolate the field.
+            value = _mm256_i64gather_epi64((const long long*) &(frames[(frame_idx * stride_bytes) + (plan -> byte_index[idx])]), offsets, 1);
+            value = _mm256_shuffle_epi8(value, bswap64);
+            value = _mm256_sll_epi64(value, _mm_cvtsi32_si128(plan -> shift_left[idx]));
+            value = _mm256_srl_epi64(value, _mm_cvtsi32_si128(plan -> shift_right[idx]));
+            // Pack the 4 values and store them in the field column.
+            value = _mm256_permutevar8x32_epi32(value, pack32);
+            _mm_storeu_si128((__m128i*) &(columns[idx][frame_idx]), _mm256_castsi256_si128(value));
+        }
+    }
+    return frame_idx;
+}
+#endif
+
+/*** TKFX DECODER functions ***/
+
+/*******************************************************************/
+const TKFX_DECODER_layout_t* TKFX_DECODER_get_layout(TKFX_DECODER_frame_t frame) {
+    return ((frame < TKFX_DECODER_FRAME_LAST) ? &(TKFX_DECODER_LAYOUTS[frame]) : NULL);
+}
+
+/*******************************************************************/
+TKFX_DECODER_frame_t TKFX_DECODER_get_frame_type(size_t size_bytes) {
+    // Local variables.
+    TKFX_DECODER_frame_t frame = TKFX_DECODER_FRAME_STARTUP;
+    // Search layout.
+    for (frame = TKFX_DECODER_FRAME_STARTUP; frame < TKFX_DECODER_FRAME_LAST; frame++) {
+        if (TKFX_DECODER_LAYOUTS[frame].size_bytes == size_bytes) break;
+    }
+    return frame;
+}
+
+/*******************************************************************/
+void TKFX_DECODER_decode_batch_scalar(TKFX_DECODER_frame_t frame, const uint8_t* frames, size_t stride_bytes, size_t number_of_frames, uint32_t** columns) {
+    // Local variables.
+    const TKFX_DECODER_layout_t* layout = TKFX_DECODER_get_layout(frame);
+    TKFX_DECODER_plan_t plan;
+    // Check parameters.
+    if ((layout == NULL) || ((layout -> number_of_fields) == 0) || (number_of_frames == 0)) return;
+    _TKFX_DECODER_build_plan(layout, &plan);
+    _TKFX_DECODER_decode_scalar(layout, &plan, frames, stride_bytes, 0, number_of_frames, columns);
+}
+
+/*******************************************************************/
+void TKFX_DECODER_decode_batch(TKFX_DECODER_frame_t frame, const uint8_t* frames, size_t stride_bytes, size_t number_of_frames, uint32_t** columns) {
+    // Local variables.
+    const TKFX_DECODER_layout_t* layout = TKFX_DECODER_get_layout(frame);
+    TKFX_DECODER_plan_t plan;
+    size_t first_frame = 0;
+    // Check parameters.
+    if ((layout == NULL) || ((layout -> number_of_fields) == 0) || (number_of_frames == 0)) return;
+    _TKFX_DECODER_build_plan(layout, &plan);
+#ifdef __AVX2__
+    first_frame = _TKFX_DECODER_decode_avx2(layout, &plan, frames, stride_bytes, number_of_frames, columns);
+#endif
+    // Remaining frames.
+    _TKFX_DECODER_decode_scalar(layout, &plan, frames, stride_bytes, first_frame, number_of_frames, columns);
+}
+
+/*******************************************************************/
+int TKFX_DECODER_has_simd(void) {
+#ifdef __AVX2__
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/*******************************************************************/
+void TKFX_DECODER_get_compact_position(uint32_t latitude_code, uint32_t longitude_code, double* latitude_degrees, double* longitude_degrees) {
+    // Codes are rounded multiples of full_scale / 2^size_bits from the south pole and the antimeridian.
+    (*latitude_degrees) = (((double) latitude_code * (double) TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_FULL_SCALE) / (double) (1UL << TKFX_SIGFOX_GEOLOC_COMPACT_LATITUDE_SIZE_BITS)) / TKFX_DECODER_UNITS_PER_DEGREE - 90.0;
+    (*longitude_degrees) = (((double) longitude_code * (double) TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_FULL_SCALE) / (double) (1UL << TKFX_SIGFOX_GEOLOC_COMPACT_LONGITUDE_SIZE_BITS)) / TKFX_DECODER_UNITS_PER_DEGREE - 180.0;
+}
+
+/*******************************************************************/
+void TKFX_DECODER_decode_error_stack(const uint8_t* frame, TKFX_DECODER_error_stack_t* error_stack) {
+    // Local variables.
+    uint8_t buffer[TKFX_DECODER_FRAME_BUFFER_SIZE] = { 0 };
+    uint32_t frame_size_bits = (TKFX_SIGFOX_ERROR_STACK_DATA_SIZE * 8);
+    uint32_t bit_idx = 0;
+    uint32_t header = 0;
+    uint16_t previous_code = 0;
+    uint16_t code = 0;
+    uint8_t previous_valid = 0;
+    uint8_t count_code = 0;
+    TKFX_DECODER_error_entry_t* entry = NULL;
+    // Copy frame in a padded buffer.
+    memcpy(buffer, frame, TKFX_SIGFOX_ERROR_STACK_DATA_SIZE);
+    header = _TKFX_DECODER_read_bits(buffer, &bit_idx, FAULT_HEADER_SIZE_BITS);
+    error_stack -> overflow_flag = (uint8_t) (header >> (FAULT_HEADER_SIZE_BITS - 1));
+    error_stack -> remaining_number = (uint8_t) (header & ((1 << (FAULT_HEADER_SIZE_BITS - 1)) - 1));
+    error_stack -> number_of_entries = 0;
+    // Entries loop.
+    while (((bit_idx + FAULT_TAG_SIZE_BITS + FAULT_OFFSET_SIZE_BITS + FAULT_COUNT_SIZE_BITS) <= frame_size_bits) && ((error_stack -> number_of_entries) < TKFX_DECODER_ERROR_ENTRIES_MAX)) {
+        if ((buffer[bit_idx >> 3] & (0x80 >> (bit_idx & 0b111))) == 0) {
+            // Full code.
+            if ((bit_idx + FAULT_TAG_SIZE_BITS + FAULT_CODE_SIZE_BITS + FAULT_COUNT_SIZE_BITS) > frame_size_bits) break;
+            bit_idx += FAULT_TAG_SIZE_BITS;
+            code = (uint16_t) _TKFX_DECODER_read_bits(buffer, &bit_idx, FAULT_CODE_SIZE_BITS);
+            if (code == 0) break;
+        }
+        else {
+            // Offset from the previous code base.
+            if (previous_valid == 0) break;
+            bit_idx += FAULT_TAG_SIZE_BITS;
+            code = (uint16_t) ((previous_code & ~((1 << FAULT_OFFSET_SIZE_BITS) - 1)) | _TKFX_DECODER_read_bits(buffer, &bit_idx, FAULT_OFFSET_SIZE_BITS));
+        }
+        count_code = (uint8_t) _TKFX_DECODER_read_bits(buffer, &bit_idx, FAULT_COUNT_SIZE_BITS);
+        entry = &((error_stack -> entries)[(error_stack -> number_of_entries)++]);
+        entry -> code = code;
+        entry -> count_code = count_code;
+        if (count_code < TKFX_DECODER_COUNT_EXACT_MAX) {
+            entry -> count_min = (uint32_t) (count_code + 1);
+            entry -> count_max = (uint32_t) (count_code + 1);
+        }
+        else {
+            entry -> count_min = (uint32_t) ((1 << (count_code - 5)) + 1);
+            entry -> count_max = (count_code == TKFX_DECODER_COUNT_CODE_SATURATED) ? UINT32_MAX : (uint32_t) (1 << (count_code - 4));
+        }
+        previous_code = code;
+        previous_valid = 1;
+    }
+}
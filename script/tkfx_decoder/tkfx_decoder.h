@@ -0,0 +1,151 @@
+/*
+ * tkfx_decoder.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TKFX_DECODER_H__
+#define __TKFX_DECODER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fault.h"
+#include "tkfx_frames.h"
+
+/*** TKFX DECODER macros ***/
+
+// Maximum number of fields of a fixed layout frame.
+#define TKFX_DECODER_FIELDS_NUMBER_MAX      16
+// Maximum number of entries of an error stack frame.
+#define TKFX_DECODER_ERROR_ENTRIES_MAX      ((TKFX_SIGFOX_ERROR_STACK_DATA_SIZE * 8) / (FAULT_TAG_SIZE_BITS + FAULT_OFFSET_SIZE_BITS + FAULT_COUNT_SIZE_BITS))
+
+/*** TKFX DECODER structures ***/
+
+/*!******************************************************************
+ * \enum TKFX_DECODER_frame_t
+ * \brief Uplink frames types.
+ *******************************************************************/
+typedef enum {
+    TKFX_DECODER_FRAME_STARTUP = 0,
+    TKFX_DECODER_FRAME_MONITORING,
+    TKFX_DECODER_FRAME_MONITORING_STACK_USAGE,
+    TKFX_DECODER_FRAME_GEOLOC,
+    TKFX_DECODER_FRAME_GEOLOC_TIMEOUT,
+    TKFX_DECODER_FRAME_DIAGNOSTICS,
+    TKFX_DECODER_FRAME_GEOLOC_COMPACT,
+    TKFX_DECODER_FRAME_ERROR_STACK,
+    TKFX_DECODER_FRAME_LAST
+} TKFX_DECODER_frame_t;
+
+/*!******************************************************************
+ * \struct TKFX_DECODER_field_t
+ * \brief Fixed layout frame field.
+ *******************************************************************/
+typedef struct {
+    const char* name;
+    uint8_t size_bits;
+} TKFX_DECODER_field_t;
+
+/*!******************************************************************
+ * \struct TKFX_DECODER_layout_t
+ * \brief Frame layout (number_of_fields is 0 for the error stack bit stream).
+ *******************************************************************/
+typedef struct {
+    const char* name;
+    uint8_t size_bytes;
+    uint8_t number_of_fields;
+    const TKFX_DECODER_field_t* fields;
+} TKFX_DECODER_layout_t;
+
+/*!******************************************************************
+ * \struct TKFX_DECODER_error_entry_t
+ * \brief Error stack frame entry.
+ *******************************************************************/
+typedef struct {
+    uint16_t code;
+    uint8_t count_code;
+    uint32_t count_min;
+    uint32_t count_max;
+} TKFX_DECODER_error_entry_t;
+
+/*!******************************************************************
+ * \struct TKFX_DECODER_error_stack_t
+ * \brief Decoded error stack frame.
+ *******************************************************************/
+typedef struct {
+    uint8_t overflow_flag;
+    uint8_t remaining_number;
+    uint8_t number_of_entries;
+    TKFX_DECODER_error_entry_t entries[TKFX_DECODER_ERROR_ENTRIES_MAX];
+} TKFX_DECODER_error_stack_t;
+
+/*** TKFX DECODER functions ***/
+
+/*!******************************************************************
+ * \fn const TKFX_DECODER_layout_t* TKFX_DECODER_get_layout(TKFX_DECODER_frame_t frame)
+ * \brief Get a frame layout.
+ * \param[in]   frame: Frame type.
+ * \param[out]  none
+ * \retval      Frame layout, NULL for an invalid type.
+ *******************************************************************/
+const TKFX_DECODER_layout_t* TKFX_DECODER_get_layout(TKFX_DECODER_frame_t frame);
+
+/*!******************************************************************
+ * \fn TKFX_DECODER_frame_t TKFX_DECODER_get_frame_type(size_t size_bytes)
+ * \brief Identify a frame from its payload size (all uplinks have different sizes).
+ * \param[in]   size_bytes: Payload size.
+ * \param[out]  none
+ * \retval      Frame type, TKFX_DECODER_FRAME_LAST if the size is unknown.
+ *******************************************************************/
+TKFX_DECODER_frame_t TKFX_DECODER_get_frame_type(size_t size_bytes);
+
+/*!******************************************************************
+ * \fn void TKFX_DECODER_decode_batch(TKFX_DECODER_frame_t frame, const uint8_t* frames, size_t stride_bytes, size_t number_of_frames, uint32_t** columns)
+ * \brief Decode frames of the same fixed layout type into one column per field.
+ * \param[in]   frame: Frame type (not TKFX_DECODER_FRAME_ERROR_STACK).
+ * \param[in]   frames: Frames buffer, frame i starts at frames[i * stride_bytes].
+ * \param[in]   stride_bytes: Distance between two frames, at least the frame size.
+ * \param[in]   number_of_frames: Number of frames to decode.
+ * \param[out]  columns: columns[field][i] receives the field value of frame i.
+ * \retval      none
+ *******************************************************************/
+void TKFX_DECODER_decode_batch(TKFX_DECODER_frame_t frame, const uint8_t* frames, size_t stride_bytes, size_t number_of_frames, uint32_t** columns);
+
+/*!******************************************************************
+ * \fn void TKFX_DECODER_decode_batch_scalar(TKFX_DECODER_frame_t frame, const uint8_t* frames, size_t stride_bytes, size_t number_of_frames, uint32_t** columns)
+ * \brief Same as TKFX_DECODER_decode_batch without the SIMD path (reference and benchmark).
+ *******************************************************************/
+void TKFX_DECODER_decode_batch_scalar(TKFX_DECODER_frame_t frame, const uint8_t* frames, size_t stride_bytes, size_t number_of_frames, uint32_t** columns);
+
+/*!******************************************************************
+ * \fn int TKFX_DECODER_has_simd(void)
+ * \brief Get SIMD path availability (build with -mavx2).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Non zero if TKFX_DECODER_decode_batch uses AVX2.
+ *******************************************************************/
+int TKFX_DECODER_has_simd(void);
+
+/*!******************************************************************
+ * \fn void TKFX_DECODER_get_compact_position(uint32_t latitude_code, uint32_t longitude_code, double* latitude_degrees, double* longitude_degrees)
+ * \brief Convert the coordinates codes of a compact geolocation frame.
+ * \param[in]   latitude_code: Latitude field value.
+ * \param[in]   longitude_code: Longitude field value.
+ * \param[out]  latitude_degrees: Latitude (positive north).
+ * \param[out]  longitude_degrees: Longitude (positive east).
+ * \retval      none
+ *******************************************************************/
+void TKFX_DECODER_get_compact_position(uint32_t latitude_code, uint32_t longitude_code, double* latitude_degrees, double* longitude_degrees);
+
+/*!******************************************************************
+ * \fn void TKFX_DECODER_decode_error_stack(const uint8_t* frame, TKFX_DECODER_error_stack_t* error_stack)
+ * \brief Decode an error stack frame.
+ * \param[in]   frame: Frame of TKFX_SIGFOX_ERROR_STACK_DATA_SIZE bytes.
+ * \param[out]  error_stack: Decoded entries.
+ * \retval      none
+ *******************************************************************/
+void TKFX_DECODER_decode_error_stack(const uint8_t* frame, TKFX_DECODER_error_stack_t* error_stack);
+
+#endif /* __TKFX_DECODER_H__ */
@@ -0,0 +1,20 @@
+/*
+ * types.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TYPES_H__
+#define __TYPES_H__
+
+/*
+ * Host replacement of the firmware types.h, so that host tools can build the middleware modules which only need the standard types.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef char char_t;
+
+#endif /* __TYPES_H__ */
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+#
+# tkfx_error_frame.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Decode the aggregated error stack uplink frame (12 bytes, middleware/fault).
+# The bit fields sizes are read from the firmware header so that both sides stay consistent.
+#
+# Usage: tkfx_error_frame.py <frame_hex> [<frame_hex> ...]
+
+import argparse
+import os
+import re
+import sys
+
+ROOT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+FAULT_FILE = os.path.join(ROOT_DIR, "middleware", "fault", "inc", "fault.h")
+
+def parse_sizes(path):
+    with open(path) as f:
+        content = f.read()
+    sizes = {}
+    for name in ["HEADER", "TAG", "CODE", "OFFSET", "COUNT"]:
+        sizes[name] = int(re.search(r"#define FAULT_" + name + r"_SIZE_BITS\s+(\d+)", content).group(1))
+    return sizes
+
+def decode_count(count_code):
+    # Returns (min, max) occurrences, max is None when saturated.
+    if count_code < 8:
+        return (count_code + 1, count_code + 1)
+    return ((1 << (count_code - 5)) + 1, None if count_code == 15 else (1 << (count_code - 4)))
+
+def decode(frame, sizes):
+    bits = "".join("{:08b}".format(byte) for byte in frame)
+    position = 0
+
+    def read(size_bits):
+        nonlocal position
+        value = int(bits[position:position + size_bits], 2)
+        position += size_bits
+        return value
+
+    header = read(sizes["HEADER"])
+    overflow = (header >> (sizes["HEADER"] - 1)) & 0b1
+    remaining = header & ((1 << (sizes["HEADER"] - 1)) - 1)
+    full_size = sizes["TAG"] + sizes["CODE"] + sizes["COUNT"]
+    offset_size = sizes["TAG"] + sizes["OFFSET"] + sizes["COUNT"]
+    entries = []
+    previous_code = None
+    while (len(bits) - position) >= offset_size:
+        tag = int(bits[position])
+        if tag == 0:
+            if (len(bits) - position) < full_size:
+                break
+            read(sizes["TAG"])
+            code = read(sizes["CODE"])
+            if code == 0:
+                break
+        else:
+            if previous_code is None:
+                break
+            read(sizes["TAG"])
+            code = (previous_code & ~((1 << sizes["OFFSET"]) - 1)) | read(sizes["OFFSET"])
+        entries.append((code, decode_count(read(sizes["COUNT"]))))
+        previous_code = code
+    return overflow, remaining, entries
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode aggregated error stack frames.")
+    parser.add_argument("frames", nargs="+", help="frame payloads in hexadecimal")
+    parser.add_argument("--fault-file", default=FAULT_FILE, help="firmware fault.h path")
+    args = parser.parse_args()
+    sizes = parse_sizes(args.fault_file)
+    for frame_hex in args.frames:
+        try:
+            frame = bytes.fromhex(frame_hex)
+        except ValueError:
+            sys.exit("Invalid frame: " + frame_hex)
+        overflow, remaining, entries = decode(frame, sizes)
+        print("Frame %s: %d codes, %s entries pending%s" % (frame_hex.upper(), len(entries), ("%d+" % remaining) if remaining == 7 else remaining, ", codes lost (table full)" if overflow else ""))
+        for code, (count_min, count_max) in entries:
+            count = str(count_min) if count_min == count_max else ("%d-%d" % (count_min, count_max) if count_max else "%d+" % count_min)
+            print("    base 0x%02X00 offset 0x%02X (0x%04X) x %s" % (code >> 8, code & 0xFF, code, count))
+
+if __name__ == "__main__":
+    main()
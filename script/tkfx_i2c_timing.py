@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+#
+# tkfx_i2c_timing.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Sensors I2C bus timing model: report bus time and CPU active time per SHT3x measurement
+# and per MMA865x configuration write, in standard mode or fast mode, blocking or DMA transfers.
+
+import argparse
+import os
+import re
+
+CONFIGURATION_FILE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "drivers", "components", "inc", "mma865xfc_configuration.h")
+
+# SHT3x maximum conversion time per repeatability (ms).
+SHT3X_CONVERSION_MS = { "low": 4.5, "medium": 6.5, "high": 15.5 }
+# Software overhead per transfer (us): blocking driver polls every byte, DMA programs the channel once.
+CPU_OVERHEAD_PER_TRANSFER_US = { "blocking": 15.0, "dma": 25.0 }
+CPU_OVERHEAD_PER_BYTE_US = { "blocking": 3.0, "dma": 0.0 }
+
+def transfer_bits(data_size_bytes, start_count=1):
+    # START + address byte + ACK, then 9 bits per data byte, then STOP.
+    return (start_count * (1 + 9)) + (9 * data_size_bytes) + 1
+
+def transfer_time_us(data_size_bytes, frequency_hz):
+    return transfer_bits(data_size_bytes) * 1e6 / frequency_hz
+
+def parse_active_configuration(configuration_file):
+    # Registers addresses of the active configuration table, in table order.
+    registers = []
+    with open(configuration_file) as f:
+        content = f.read()
+    table = content[content.index("#define MMA865XFC_CONFIGURATION_ACTIVE("):]
+    table = table[:table.index("\n}\n")]
+    for match in re.finditer(r"\{MMA865XFC_REGISTER_(\w+),", table):
+        registers.append(match.group(1))
+    return registers
+
+REGISTER_ADDRESS = {
+    "XYZ_DATA_CFG": 0x0E, "FF_MT_CFG": 0x15, "FF_MT_THS": 0x17, "FF_MT_COUNT": 0x18, "ASLP_COUNT": 0x29,
+    "CTRL_REG1": 0x2A, "CTRL_REG2": 0x2B, "CTRL_REG3": 0x2C, "CTRL_REG4": 0x2D, "CTRL_REG5": 0x2E,
+}
+
+def configuration_transfers(registers, burst):
+    # Returns the list of data sizes (register address byte included) of each transfer.
+    if not burst:
+        return [2] * len(registers)
+    transfers = []
+    previous = None
+    for register in registers:
+        address = REGISTER_ADDRESS[register]
+        if (previous is not None) and (address == previous + 1):
+            transfers[-1] += 1
+        else:
+            transfers.append(2)
+        previous = address
+    return transfers
+
+def report(transfers, frequency_hz, mode, extra_bus_ms=0.0):
+    bus_us = sum(transfer_time_us(size, frequency_hz) for size in transfers) + (extra_bus_ms * 1000.0)
+    cpu_us = sum(CPU_OVERHEAD_PER_TRANSFER_US[mode] + (CPU_OVERHEAD_PER_BYTE_US[mode] * size) for size in transfers)
+    if mode == "blocking":
+        # CPU polls during the whole bus activity.
+        cpu_us += bus_us
+    return bus_us, cpu_us
+
+def main():
+    parser = argparse.ArgumentParser(description="Sensors I2C bus timing model.")
+    parser.add_argument("--configuration-file", default=CONFIGURATION_FILE, help="mma865xfc_configuration.h path")
+    parser.add_argument("--repeatability", default="low", choices=SHT3X_CONVERSION_MS.keys(), help="SHT3x repeatability")
+    args = parser.parse_args()
+    registers = parse_active_configuration(args.configuration_file)
+    print("%-28s %-10s %-9s %6s %10s %10s" % ("operation", "speed", "transfer", "xfers", "bus_us", "cpu_us"))
+    for frequency_hz, speed in ((100000, "100kHz"), (400000, "400kHz")):
+        for mode in ("blocking", "dma"):
+            # SHT3x single shot with clock stretching: command write then 6 bytes read held during conversion.
+            sht3x = [2, 6]
+            bus_us, cpu_us = report(sht3x, frequency_hz, mode, SHT3X_CONVERSION_MS[args.repeatability])
+            print("%-28s %-10s %-9s %6d %10.0f %10.0f" % ("sht3x_" + args.repeatability + "_stretching", speed, mode, len(sht3x), bus_us, cpu_us))
+            for burst in (False, True):
+                transfers = configuration_transfers(registers, burst)
+                bus_us, cpu_us = report(transfers, frequency_hz, mode)
+                print("%-28s %-10s %-9s %6d %10.0f %10.0f" % ("mma865x_active_" + ("burst" if burst else "single"), speed, mode, len(transfers), bus_us, cpu_us))
+
+if __name__ == "__main__":
+    main()
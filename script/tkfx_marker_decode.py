@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+#
+# tkfx_marker_decode.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Decode the TP2 (PA4) pulse codes emitted by the firmware when TKFX_MARKERS is defined and compute
+# per-phase duration and charge from a current capture.
+#
+# Pulse codes (middleware/marker/inc/marker.h): a burst of N short pulses followed by a guard time.
+#   N = state + 1                             TKFX_state_t entered (application/src/main.c)
+#   N = MARKER_PHASE_CODE_OFFSET + phase      MARKER_phase_t entered (a phase ending with _END closes the sub-phase)
+#
+# Marker capture formats:
+#   - logic analyzer CSV export with a header line (time in seconds, TP2 level), see --time-column and --marker-column.
+#   - virtual GPIO log, one edge per line: '<time_us> TP2 <0|1>' ('#' for comments).
+# Current capture: power analyzer CSV export with a header line (time in seconds, current in A), see --current-column.
+# It can be the same file as the marker capture when the analyzer records TP2 on a digital input.
+#
+# There is no host simulator in this tree: --simulate writes a virtual GPIO log and a current CSV of a synthetic
+# monitoring wake cycle. --self-test decodes a hand-written capture with the firmware timings (2us pulses, 2us gaps,
+# 250us guard time) and checks the result against hand-computed durations and charges.
+
+import argparse
+import csv
+import os
+import re
+import sys
+
+ROOT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+MAIN_FILE = os.path.join(ROOT_DIR, "application", "src", "main.c")
+MARKER_FILE = os.path.join(ROOT_DIR, "middleware", "marker", "inc", "marker.h")
+
+# Maximum gap between two pulses of the same code (s). The firmware gap is 2us and the guard time 250us (SysTick timed).
+GAP_S = 100e-6
+
+# Hand-written capture: STARTUP (1 pulse), WAKEUP (2), MEASURE (3) and SLEEP (9), firmware timings with edge jitter.
+SELF_TEST_GPIO_LOG = """
+# STARTUP
+0.0 TP2 1
+2.0 TP2 0
+# WAKEUP
+1000.0 TP2 1
+1002.1 TP2 0
+1004.0 TP2 1
+1006.0 TP2 0
+# MEASURE
+21000.0 TP2 1
+21002.0 TP2 0
+21003.9 TP2 1
+21006.0 TP2 0
+21008.2 TP2 1
+21010.1 TP2 0
+# SLEEP
+271000.0 TP2 1
+271002.0 TP2 0
+271004.0 TP2 1
+271006.0 TP2 0
+271008.0 TP2 1
+271010.0 TP2 0
+271012.0 TP2 1
+271014.0 TP2 0
+271016.0 TP2 1
+271018.0 TP2 0
+271020.0 TP2 1
+271022.0 TP2 0
+271024.0 TP2 1
+271026.0 TP2 0
+271028.0 TP2 1
+271030.0 TP2 0
+271032.0 TP2 1
+271034.0 TP2 0
+"""
+# Current steps (s, A): STARTUP 1ms at 1mA, WAKEUP 20ms at 2mA, MEASURE 250ms at 1mA, SLEEP 1s at 2uA.
+SELF_TEST_CURRENT = [(0.0, 1e-3), (0.001, 1e-3), (0.001, 2e-3), (0.021, 2e-3), (0.021, 1e-3), (0.271, 1e-3),
+                     (0.271, 2e-6), (1.271, 2e-6)]
+# Expected (count, duration_ms, charge_uC) per phase.
+SELF_TEST_EXPECTED = { "STARTUP": (1, 1.0, 1.0), "WAKEUP": (1, 20.0, 40.0), "MEASURE": (1, 250.0, 250.0), "SLEEP": (1, 1000.0, 2.0) }
+
+def parse_enum(path, name):
+    with open(path) as f:
+        content = f.read()
+    match = re.search(r"typedef enum \{(.*?)\} " + name + ";", content, re.S)
+    if match is None:
+        sys.exit("Enum " + name + " not found in " + path)
+    return [entry for entry in re.findall(r"^\s*(\w+)", match.group(1), re.M) if not entry.endswith("_LAST")]
+
+def parse_codes(main_file, marker_file):
+    # Returns code to (kind, name) dictionary.
+    with open(marker_file) as f:
+        offset = int(re.search(r"#define MARKER_PHASE_CODE_OFFSET\s+(\d+)", f.read()).group(1))
+    codes = {}
+    for idx, state in enumerate(parse_enum(main_file, "TKFX_state_t")):
+        codes[idx + 1] = ("state", state.replace("TKFX_STATE_", ""))
+    for idx, phase in enumerate(parse_enum(marker_file, "MARKER_phase_t")):
+        codes[offset + idx] = ("phase", phase.replace("MARKER_PHASE_", ""))
+    return codes
+
+def parse_gpio_log(lines):
+    # Virtual GPIO log rising edges (s).
+    edges = []
+    level = 0
+    for line in lines:
+        time_us, _, value = line.split()
+        if (int(value) != 0) and (level == 0):
+            edges.append(float(time_us) * 1e-6)
+        level = int(value)
+    return edges
+
+def load_rising_edges(path, time_column, marker_column, threshold):
+    with open(path) as f:
+        lines = [line for line in f if line.strip() and not line.startswith("#")]
+    if lines and re.match(r"^\s*[\d.]+\s+TP2\s+[01]\s*$", lines[0]):
+        return parse_gpio_log(lines)
+    # Analyzer CSV export.
+    edges = []
+    level = 0
+    for row in csv.DictReader(lines):
+        value = 1 if float(row[marker_column]) > threshold else 0
+        if (value != 0) and (level == 0):
+            edges.append(float(row[time_column]))
+        level = value
+    return edges
+
+def load_current(path, time_column, current_column):
+    with open(path) as f:
+        lines = [line for line in f if line.strip() and not line.startswith("#")]
+    return [(float(row[time_column]), float(row[current_column])) for row in csv.DictReader(lines)]
+
+def decode(edges, codes, gap_s):
+    # Group pulses into codes, returns (time, kind, name) list.
+    markers = []
+    idx = 0
+    while idx < len(edges):
+        start = edges[idx]
+        count = 1
+        while ((idx + count) < len(edges)) and ((edges[idx + count] - edges[idx + count - 1]) < gap_s):
+            count += 1
+        kind, name = codes.get(count, ("unknown", "CODE_%d" % count))
+        markers.append((start, kind, name))
+        idx += count
+    return markers
+
+def segments(markers, end_time):
+    # Returns (label, start, end) list: state, or state/phase while a sub-phase is open.
+    result = []
+    state = None
+    phase = None
+    for idx, (time, kind, name) in enumerate(markers):
+        if kind == "state":
+            state = name
+            phase = None
+        elif kind == "phase":
+            phase = None if name.endswith("_END") else name
+        else:
+            continue
+        stop = markers[idx + 1][0] if (idx + 1) < len(markers) else end_time
+        if state is not None:
+            result.append((state if phase is None else state + "/" + phase, time, stop))
+    return result
+
+def integrate(samples, start, stop):
+    # Trapezoidal charge (C) between start and stop.
+    charge = 0.0
+    for (t0, i0), (t1, i1) in zip(samples, samples[1:]):
+        a = max(t0, start)
+        b = min(t1, stop)
+        if b > a:
+            charge += 0.5 * (i0 + i1) * (b - a)
+    return charge
+
+def report(markers, samples, end_time):
+    table = {}
+    for label, start, stop in segments(markers, end_time):
+        entry = table.setdefault(label, [0, 0.0, 0.0])
+        entry[0] += 1
+        entry[1] += stop - start
+        entry[2] += integrate(samples, start, stop) if samples else 0.0
+    return table
+
+def simulate(codes, gap_s):
+    # Synthetic monitoring wake cycle: returns virtual GPIO log lines, current samples and expected sequence.
+    by_name = { name: code for code, (kind, name) in codes.items() }
+    sequence = [("SLEEP", 5.0, 2e-6), ("WAKEUP", 0.02, 2.1e-3), ("MEASURE", 0.25, 1.0e-3), ("MONITORING", 0.005, 2.1e-3),
+                ("RF_WAKE_UP", 0.004, 3.0e-3), ("RF_TX", 2.1, 25e-3), ("RF_IDLE", 0.5, 4.0e-3), ("RF_END", 0.001, 2.1e-3),
+                ("ERROR_STACK", 0.003, 0.3e-3), ("MODE_UPDATE", 0.1, 1.2e-3), ("OFF", 0.001, 0.3e-3), ("SLEEP", 1.0, 2e-6)]
+    pulse_s = gap_s / 20.0
+    time = 0.0
+    lines = []
+    samples = []
+    for name, duration, current in sequence:
+        for idx in range(by_name[name]):
+            lines.append("%.1f TP2 1" % (time * 1e6))
+            lines.append("%.1f TP2 0" % ((time + pulse_s) * 1e6))
+            time += 2 * pulse_s
+        samples.append((time, current))
+        time += duration
+        samples.append((time, current))
+    return lines, samples, [name for name, _, _ in sequence], time
+
+def self_test(codes, gap_s):
+    lines = [line for line in SELF_TEST_GPIO_LOG.splitlines() if line.strip() and not line.startswith("#")]
+    markers = decode(parse_gpio_log(lines), codes, gap_s)
+    table = report(markers, SELF_TEST_CURRENT, SELF_TEST_CURRENT[-1][0])
+    if sorted(table.keys()) != sorted(SELF_TEST_EXPECTED.keys()):
+        sys.exit("Self-test failed: decoded %s, expected %s" % (sorted(table.keys()), sorted(SELF_TEST_EXPECTED.keys())))
+    for label, (count, duration_ms, charge_uc) in SELF_TEST_EXPECTED.items():
+        entry = table[label]
+        if (entry[0] != count) or (abs(entry[1] * 1e3 - duration_ms) > 0.01) or (abs(entry[2] * 1e6 - charge_uc) > 0.01):
+            sys.exit("Self-test failed: %s decoded (%d, %.3f ms, %.3f uC), expected (%d, %.3f ms, %.3f uC)"
+                     % (label, entry[0], entry[1] * 1e3, entry[2] * 1e6, count, duration_ms, charge_uc))
+    print("Self-test passed (%d markers, %.1f uC)" % (len(markers), sum(entry[2] for entry in table.values()) * 1e6))
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode TP2 pulse codes and compute per-phase charge.")
+    parser.add_argument("capture", nargs="?", help="marker capture (analyzer CSV or virtual GPIO log)")
+    parser.add_argument("--current", help="current capture CSV (default: same file as marker capture if it has the current column)")
+    parser.add_argument("--time-column", default="Time [s]", help="CSV time column name")
+    parser.add_argument("--marker-column", default="TP2", help="CSV TP2 column name")
+    parser.add_argument("--current-column", default="Current [A]", help="CSV current column name")
+    parser.add_argument("--threshold", type=float, default=0.5, help="TP2 logic threshold (analog exports)")
+    parser.add_argument("--gap-us", type=float, default=GAP_S * 1e6, help="maximum gap between pulses of a code")
+    parser.add_argument("--main-file", default=MAIN_FILE, help="firmware main.c path")
+    parser.add_argument("--marker-file", default=MARKER_FILE, help="firmware marker.h path")
+    parser.add_argument("--simulate", metavar="PREFIX", help="write PREFIX_gpio.log and PREFIX_current.csv synthetic captures")
+    parser.add_argument("--self-test", action="store_true", help="check the decoder against a hand-written capture")
+    args = parser.parse_args()
+    codes = parse_codes(args.main_file, args.marker_file)
+    gap_s = args.gap_us * 1e-6
+    if args.self_test:
+        self_test(codes, gap_s)
+        return
+    if args.simulate is not None:
+        lines, samples, _, _ = simulate(codes, gap_s)
+        with open(args.simulate + "_gpio.log", "w") as f:
+            f.write("\n".join(lines) + "\n")
+        with open(args.simulate + "_current.csv", "w") as f:
+            f.write(args.time_column + "," + args.current_column + "\n")
+            f.writelines("%.7f,%.6e\n" % sample for sample in samples)
+        return
+    if args.capture is None:
+        sys.exit("No capture given (or use --simulate / --self-test)")
+    edges = load_rising_edges(args.capture, args.time_column, args.marker_column, args.threshold)
+    markers = decode(edges, codes, gap_s)
+    samples = []
+    if args.current is not None:
+        samples = load_current(args.current, args.time_column, args.current_column)
+    elif not args.capture.endswith(".log"):
+        try:
+            samples = load_current(args.capture, args.time_column, args.current_column)
+        except KeyError:
+            samples = []
+    end_time = samples[-1][0] if samples else (edges[-1] if edges else 0.0)
+    table = report(markers, samples, end_time)
+    print("%-28s %6s %12s %12s %10s" % ("phase", "count", "time_ms", "charge_uC", "mean_mA"))
+    for label, (count, duration, charge) in sorted(table.items(), key=lambda item: -item[1][2]):
+        mean = (charge / duration * 1e3) if (samples and duration > 0) else float("nan")
+        print("%-28s %6d %12.3f %12.3f %10.3f" % (label, count, duration * 1e3, charge * 1e6, mean))
+    unknown = [name for _, kind, name in markers if kind == "unknown"]
+    if unknown:
+        print("Unknown codes: " + ", ".join(sorted(set(unknown))))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+#
+# tkfx_mma865x_current.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Print the accelerometer supply current of each tracker mode profile defined in
+# application/src/main.c (TKFX_MMA865XFC_* macros), using the MMA865x datasheet current model
+# (typical supply current versus output data rate and oversampling mode, VDD=2.5V, 25C).
+
+import argparse
+import os
+import re
+import sys
+
+MAIN_FILE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "application", "src", "main.c")
+
+# Typical current (uA) per ODR (Hz) for MODS = normal, low noise low power, high resolution, low power.
+CURRENT_MODEL_UA = {
+    800.0:  (165, 165, 165, 165),
+    400.0:  (165, 165, 165, 44),
+    200.0:  (85, 85, 165, 24),
+    100.0:  (44, 44, 165, 14),
+    50.0:   (24, 24, 165, 8),
+    12.5:   (24, 8, 165, 6),
+    6.25:   (24, 8, 165, 6),
+    1.56:   (24, 8, 165, 6),
+}
+STANDBY_CURRENT_UA = 1.8
+
+DR_HZ = { "800HZ": 800.0, "400HZ": 400.0, "200HZ": 200.0, "100HZ": 100.0, "50HZ": 50.0, "12HZ5": 12.5, "6HZ25": 6.25, "1HZ56": 1.56 }
+MODS_INDEX = { "NORMAL": 0, "LNLP": 1, "HR": 2, "LP": 3 }
+
+def parse_profiles(main_file):
+    # Extract per tracker mode profile macros.
+    profiles = {}
+    current = None
+    with open(main_file) as f:
+        for line in f:
+            match = re.match(r"#ifdef TKFX_MODE_(\w+)", line)
+            if match:
+                current = match.group(1).lower()
+                continue
+            if line.startswith("#endif"):
+                current = None
+                continue
+            match = re.match(r"#define TKFX_MMA865XFC_(DR|MODS|ASLP_RATE|SMODS|ASLP_DELAY_MS)\s+(\S+)", line)
+            if (current is not None) and match:
+                profiles.setdefault(current, {})[match.group(1)] = match.group(2).split("_")[-1]
+    return profiles
+
+def current_ua(odr, mods):
+    return CURRENT_MODEL_UA[DR_HZ[odr]][MODS_INDEX[mods]]
+
+def main():
+    parser = argparse.ArgumentParser(description="Accelerometer current per tracker mode profile.")
+    parser.add_argument("--main-file", default=MAIN_FILE, help="firmware main.c path")
+    parser.add_argument("--moving-ratio", type=float, default=0.05, help="fraction of time the asset is moving")
+    args = parser.parse_args()
+    profiles = parse_profiles(args.main_file)
+    if not profiles:
+        sys.exit("No profile found in " + args.main_file)
+    print("%-8s %-12s %-12s %10s %10s %10s %10s %10s" % ("profile", "wake", "sleep", "aslp_s", "wake_uA", "parked_uA", "avg_uA", "standby_uA"))
+    for name, profile in profiles.items():
+        wake_ua = current_ua(profile["DR"], profile["MODS"])
+        sleep_ua = current_ua(profile["ASLP_RATE"], profile["SMODS"])
+        average_ua = (args.moving_ratio * wake_ua) + ((1.0 - args.moving_ratio) * sleep_ua)
+        print("%-8s %-12s %-12s %10.1f %10.1f %10.1f %10.1f %10.1f" % (name, profile["DR"] + "/" + profile["MODS"], profile["ASLP_RATE"] + "/" + profile["SMODS"], int(profile["ASLP_DELAY_MS"]) / 1000.0, wake_ua, sleep_ua, average_ua, STANDBY_CURRENT_UA))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+#
+# tkfx_motion_replay.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Replay recorded accelerometer IRQ timestamp traces through the start detection leaky bucket
+# and report false-start and detection latency. The firmware middleware/motion/src/motion.c is built
+# on the host (gcc) and driven through ctypes, so that the replay always matches the embedded detector.
+#
+# Trace format (CSV, one event per line, '#' for comments):
+#   <timestamp_ms>,irq      accelerometer interrupt
+#   <timestamp_ms>,start    ground truth: the tracker really starts moving
+#   <timestamp_ms>,stop     ground truth: the tracker is stopped again
+#
+# The firmware only evaluates the bucket when waking up (RTC wakeup period or motion IRQ), which is reproduced
+# by evaluating the detector on each IRQ and on each wakeup tick (--wakeup-period-ms).
+
+import argparse
+import ctypes
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+
+ROOT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+MAIN_FILE = os.path.join(ROOT_DIR, "application", "src", "main.c")
+UNITS_PER_EVENT = 1000
+# Accelerometer data rates (MMA865XFC_CONFIGURATION_DR_ODR_MHZ).
+DR_ODR_MHZ = { "800HZ": 800000, "400HZ": 400000, "200HZ": 200000, "100HZ": 100000, "50HZ": 50000, "12HZ5": 12500, "6HZ25": 6250, "1HZ56": 1563 }
+MOTION_FILE = os.path.join(ROOT_DIR, "middleware", "motion", "src", "motion.c")
+# Host types.h replacement shared with the batch decoder, firmware ramfunc.h and motion.h.
+INCLUDE_DIRS = [
+    os.path.join(ROOT_DIR, "script", "tkfx_decoder"),
+    os.path.join(ROOT_DIR, "application", "inc"),
+    os.path.join(ROOT_DIR, "middleware", "motion", "inc"),
+]
+
+class BucketConfiguration(ctypes.Structure):
+    # Mirror of MOTION_bucket_configuration_t.
+    _fields_ = [
+        ("fill_per_event", ctypes.c_uint32),
+        ("leak_per_second", ctypes.c_uint32),
+        ("start_threshold", ctypes.c_uint32),
+        ("capacity", ctypes.c_uint32),
+    ]
+
+class Bucket:
+
+    def __init__(self, library, fill_per_event, leak_per_second, start_threshold, capacity):
+        self.library = library
+        # Keep a reference: the motion module only stores the configuration pointer.
+        self.configuration = BucketConfiguration(fill_per_event, leak_per_second, start_threshold, capacity)
+
+    def reset(self):
+        self.library.MOTION_init(ctypes.byref(self.configuration))
+
+    def add_event(self, timestamp_ms):
+        self.library.MOTION_add_event(timestamp_ms & 0xFFFFFFFF)
+
+    def is_start_detected(self, timestamp_ms):
+        return self.library.MOTION_is_start_detected(timestamp_ms & 0xFFFFFFFF) != 0
+
+def build_motion(build_dir):
+    # Compile the firmware motion module as a host shared library.
+    library_path = os.path.join(build_dir, "libmotion.so")
+    command = ["gcc", "-O2", "-shared", "-fPIC", "-Wno-attributes"]
+    command += ["-I" + include_dir for include_dir in INCLUDE_DIRS]
+    command += [MOTION_FILE, "-o", library_path]
+    subprocess.run(command, check=True)
+    library = ctypes.CDLL(library_path)
+    library.MOTION_init.argtypes = [ctypes.POINTER(BucketConfiguration)]
+    library.MOTION_init.restype = None
+    library.MOTION_add_event.argtypes = [ctypes.c_uint32]
+    library.MOTION_add_event.restype = None
+    library.MOTION_is_start_detected.argtypes = [ctypes.c_uint32]
+    library.MOTION_is_start_detected.restype = ctypes.c_uint8
+    return library
+
+def parse_profiles(main_file):
+    # Extract per-profile bucket parameters from the firmware configuration.
+    profiles = {}
+    with open(main_file) as f:
+        content = f.read()
+    # Fill per event is scaled from 1.56Hz to the accelerometer wake data rate of the profile (TKFX_MOTION_FILL_PER_EVENT).
+    wake_odr_mhz = {}
+    for match in re.finditer(r"#ifdef TKFX_MODE_(\w+)\s*\n#define TKFX_MMA865XFC_DR\s+MMA865XFC_CONFIGURATION_DR_(\w+)", content):
+        wake_odr_mhz[match.group(1).lower()] = DR_ODR_MHZ[match.group(2)]
+    pattern = re.compile(r"#ifdef TKFX_MODE_(\w+)\s*\n\s*static const TKFX_configuration_t TKFX_CONFIG = \{\s*TKFX_MMA865XFC_ACTIVE_CONFIGURATION,\s*\{([^}]*)\}")
+    for match in pattern.finditer(content):
+        name = match.group(1).lower()
+        values = [v.strip() for v in match.group(2).split(",")]
+        if values[0] == "TKFX_MOTION_FILL_PER_EVENT":
+            values[0] = (UNITS_PER_EVENT * DR_ODR_MHZ["1HZ56"]) // wake_odr_mhz[name]
+        profiles[name] = [int(v) for v in values]
+    return profiles
+
+def load_trace(path):
+    events = []
+    with open(path) as f:
+        for line in f:
+            line = line.split("#")[0].strip()
+            if not line:
+                continue
+            timestamp, label = [field.strip() for field in line.split(",")[:2]]
+            events.append((int(float(timestamp)), label.lower()))
+    events.sort()
+    return events
+
+def generate_trace(duration_s, trips, noise_rate_hz, moving_rate_hz, seed):
+    # Synthetic trace: sparse noise IRQs (vibrations, parking) and dense IRQs during trips.
+    rng = random.Random(seed)
+    events = []
+    duration_ms = duration_s * 1000
+    t = 0.0
+    while True:
+        t += rng.expovariate(noise_rate_hz) * 1000
+        if t >= duration_ms:
+            break
+        events.append((int(t), "irq"))
+    for _ in range(trips):
+        start_ms = rng.randrange(0, duration_ms)
+        length_ms = rng.randrange(60000, 1800000)
+        events.append((start_ms, "start"))
+        events.append((min(start_ms + length_ms, duration_ms), "stop"))
+        t = float(start_ms)
+        while True:
+            t += rng.expovariate(moving_rate_hz) * 1000
+            if t >= (start_ms + length_ms) or t >= duration_ms:
+                break
+            events.append((int(t), "irq"))
+    events.sort()
+    return events
+
+def replay(events, bucket, wakeup_period_ms):
+    bucket.reset()
+    moving_truth = False
+    truth_start_ms = None
+    detected = False
+    false_starts = 0
+    latencies = []
+    missed = 0
+    starts = 0
+    next_tick_ms = wakeup_period_ms
+    def evaluate(timestamp_ms):
+        nonlocal detected, false_starts, truth_start_ms
+        if detected or not bucket.is_start_detected(timestamp_ms):
+            return
+        detected = True
+        if moving_truth and truth_start_ms is not None:
+            latencies.append(timestamp_ms - truth_start_ms)
+            truth_start_ms = None
+        elif not moving_truth:
+            false_starts += 1
+    for timestamp_ms, label in events:
+        # Wakeup ticks between events.
+        while next_tick_ms < timestamp_ms:
+            evaluate(next_tick_ms)
+            next_tick_ms += wakeup_period_ms
+        if label == "irq":
+            bucket.add_event(timestamp_ms)
+            evaluate(timestamp_ms)
+        elif label == "start":
+            starts += 1
+            moving_truth = True
+            truth_start_ms = timestamp_ms
+            # A detection already latched before the real start is not a valid detection.
+            detected = False
+        elif label == "stop":
+            if truth_start_ms is not None:
+                missed += 1
+            moving_truth = False
+            truth_start_ms = None
+            # Stop detection resets the detector (TKFX_STATE_OFF).
+            detected = False
+            bucket.reset()
+    if truth_start_ms is not None:
+        missed += 1
+    duration_h = max(events[-1][0] if events else 0, 1) / 3600000.0
+    return {
+        "starts": starts,
+        "detected": len(latencies),
+        "missed": missed,
+        "false_starts": false_starts,
+        "false_starts_per_hour": false_starts / duration_h,
+        "latency_mean_s": (sum(latencies) / len(latencies) / 1000.0) if latencies else float("nan"),
+        "latency_max_s": (max(latencies) / 1000.0) if latencies else float("nan"),
+    }
+
+def main():
+    parser = argparse.ArgumentParser(description="Replay IRQ traces through the tracker start detector.")
+    parser.add_argument("traces", nargs="*", help="CSV trace files (timestamp_ms,label)")
+    parser.add_argument("--main-file", default=MAIN_FILE, help="firmware main.c to read profiles from")
+    parser.add_argument("--profile", default=None, help="car, bike or hiking (default: all)")
+    parser.add_argument("--fill", type=int, help="override fill per event")
+    parser.add_argument("--leak", type=int, help="override leak per second")
+    parser.add_argument("--threshold", type=int, help="override start threshold")
+    parser.add_argument("--capacity", type=int, help="override capacity")
+    parser.add_argument("--wakeup-period-ms", type=int, default=10000, help="RTC wakeup period")
+    parser.add_argument("--synthetic", type=int, metavar="HOURS", help="generate a synthetic trace of the given duration")
+    parser.add_argument("--trips", type=int, default=10, help="synthetic trace number of trips")
+    parser.add_argument("--noise-rate", type=float, default=0.002, help="synthetic noise IRQ rate (Hz)")
+    parser.add_argument("--moving-rate", type=float, default=0.5, help="synthetic moving IRQ rate (Hz)")
+    parser.add_argument("--seed", type=int, default=0, help="synthetic trace seed")
+    args = parser.parse_args()
+    profiles = parse_profiles(args.main_file)
+    if not profiles:
+        sys.exit("No profile found in " + args.main_file)
+    if args.profile is not None:
+        profiles = { args.profile: profiles[args.profile] }
+    traces = [(path, load_trace(path)) for path in args.traces]
+    if args.synthetic is not None:
+        traces.append(("synthetic", generate_trace(args.synthetic * 3600, args.trips, args.noise_rate, args.moving_rate, args.seed)))
+    if not traces:
+        sys.exit("No trace to replay (give trace files or --synthetic)")
+    with tempfile.TemporaryDirectory() as build_dir:
+        library = build_motion(build_dir)
+        print("%-8s %-24s %6s %8s %6s %8s %10s %10s %10s" % ("profile", "trace", "starts", "detected", "missed", "false", "false/h", "lat_mean", "lat_max"))
+        for name, parameters in profiles.items():
+            fill, leak, threshold, capacity = parameters
+            bucket = Bucket(library, args.fill or fill, args.leak or leak, threshold if args.threshold is None else args.threshold, args.capacity or capacity)
+            for path, events in traces:
+                result = replay(events, bucket, args.wakeup_period_ms)
+                print("%-8s %-24s %6d %8d %6d %8d %10.3f %10.1f %10.1f" % (name, path[-24:], result["starts"], result["detected"], result["missed"], result["false_starts"], result["false_starts_per_hour"], result["latency_mean_s"], result["latency_max_s"]))
+
+if __name__ == "__main__":
+    main()
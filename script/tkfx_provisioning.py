@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+#
+# tkfx_provisioning.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Batch provisioning of Sigfox credentials through the CLI binary provisioning session (middleware/provisioning).
+#
+# Transaction:
+#   1. AT$PROV=<baud_rate> at 9600 bauds (the highest baud rate accepted by the firmware is negotiated).
+#   2. After OK, the host switches to the session baud rate and sends one request frame:
+#      sync, data size, data (EP ID, EP key, EP library NVM data), CRC-16/CCITT over data size and data (big endian).
+#   3. The firmware writes and reads back the NVM area and answers: sync, result, CRC of the read back area.
+#   4. The terminal goes back to 9600 bauds, the EP ID is read back with AT$ID? as a last check.
+#
+# Credentials file: CSV with 'id' and 'key' columns (hexadecimal), optional 'nvm' column.
+# Each provisioned unit is appended to the report file, already provisioned IDs are skipped on restart.
+#
+# Usage: tkfx_provisioning.py <port> <credentials.csv> [--report report.csv]
+#        tkfx_provisioning.py --self-test
+
+import argparse
+import csv
+import os
+import re
+import sys
+import time
+
+PROVISIONING_FILE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "middleware", "provisioning", "inc", "provisioning.h")
+
+# Sigfox EP library sizes (sigfox_types.h).
+SIGFOX_EP_ID_SIZE_BYTES = 4
+SIGFOX_EP_KEY_SIZE_BYTES = 16
+SIGFOX_NVM_DATA_SIZE_BYTES = 4
+
+CLI_BAUD_RATE = 9600
+BAUD_RATES = [460800, 230400, 115200, 57600, 38400, 19200]
+SWITCH_DELAY_S = 0.05
+TIMEOUT_S = 2.0
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if (crc & 0x8000) else (crc << 1) & 0xFFFF
+    return crc
+
+def parse_protocol(path):
+    with open(path) as f:
+        content = f.read()
+    sync = int(re.search(r"#define PROVISIONING_SYNC\s+(\w+)", content).group(1), 0)
+    match = re.search(r"typedef enum \{([^{}]*?)\} PROVISIONING_result_t;", content, re.S)
+    results = [entry.replace("PROVISIONING_RESULT_", "") for entry in re.findall(r"^\s*(\w+)", match.group(1), re.M) if not entry.endswith("_LAST")]
+    return sync, results
+
+def build_request(sync, data):
+    body = bytes([len(data)]) + data
+    crc = crc16(body)
+    return bytes([sync]) + body + bytes([crc >> 8, crc & 0xFF])
+
+def build_data(row):
+    ep_id = bytes.fromhex(row["id"])
+    ep_key = bytes.fromhex(row["key"])
+    nvm = bytes.fromhex(row.get("nvm") or ("00" * SIGFOX_NVM_DATA_SIZE_BYTES))
+    if (len(ep_id) != SIGFOX_EP_ID_SIZE_BYTES) or (len(ep_key) != SIGFOX_EP_KEY_SIZE_BYTES) or (len(nvm) != SIGFOX_NVM_DATA_SIZE_BYTES):
+        raise ValueError("invalid credentials size for ID " + row["id"])
+    return ep_id + ep_key + nvm
+
+class Device:
+
+    def __init__(self, port):
+        self.port = port
+
+    def command(self, command):
+        self.port.reset_input_buffer()
+        self.port.write((command + "\r").encode("ascii"))
+        lines = []
+        deadline = time.monotonic() + TIMEOUT_S
+        while time.monotonic() < deadline:
+            line = self.port.readline().decode("ascii", "replace").strip()
+            if not line:
+                continue
+            if line == "OK" or line.startswith("ERROR"):
+                return line, lines
+            lines.append(line)
+        return "TIMEOUT", lines
+
+    def provision(self, data, sync, baud_rates):
+        # Returns (result, baud_rate).
+        for baud_rate in baud_rates:
+            answer, _ = self.command("AT$PROV=%d" % baud_rate)
+            if answer != "OK":
+                continue
+            self.port.baudrate = baud_rate
+            time.sleep(SWITCH_DELAY_S)
+            try:
+                self.port.write(build_request(sync, data))
+                response = self.port.read(4)
+            finally:
+                self.port.baudrate = CLI_BAUD_RATE
+            if (len(response) != 4) or (response[0] != sync):
+                return "NO_RESPONSE", baud_rate
+            if response[1] != 0:
+                return response[1], baud_rate
+            if ((response[2] << 8) | response[3]) != crc16(data):
+                return "CRC_MISMATCH", baud_rate
+            return 0, baud_rate
+        return "NOT_SUPPORTED", None
+
+def provision_unit(device, data, sync, results, baud_rates):
+    start = time.monotonic()
+    result, baud_rate = device.provision(data, sync, baud_rates)
+    if isinstance(result, int):
+        result = results[result] if result < len(results) else "RESULT_%d" % result
+    if result == "SUCCESS":
+        # Give the firmware time to restart the AT driver.
+        time.sleep(SWITCH_DELAY_S)
+        answer, lines = device.command("AT$ID?")
+        if (answer != "OK") or (not lines) or (lines[-1].upper() != data[:SIGFOX_EP_ID_SIZE_BYTES].hex().upper()):
+            result = "ID_CHECK"
+    return result, baud_rate, time.monotonic() - start
+
+class SimulatedPort:
+    # Firmware behaviour model used by the self-test.
+
+    def __init__(self, sync, max_baud_rate, corrupt=False):
+        self.sync = sync
+        self.max_baud_rate = max_baud_rate
+        self.corrupt = corrupt
+        self.baudrate = CLI_BAUD_RATE
+        self.session = None
+        self.nvm = bytearray(SIGFOX_EP_ID_SIZE_BYTES + SIGFOX_EP_KEY_SIZE_BYTES + SIGFOX_NVM_DATA_SIZE_BYTES)
+        self.output = b""
+
+    def reset_input_buffer(self):
+        self.output = b""
+
+    def write(self, data):
+        if self.session is not None:
+            if self.baudrate != self.session:
+                return
+            self.session = None
+            if self.corrupt:
+                data = data[:5] + bytes([data[5] ^ 0x01]) + data[6:]
+            size = data[1]
+            result = 1 if size != len(self.nvm) else (2 if crc16(data[1:-2]) != ((data[-2] << 8) | data[-1]) else 0)
+            if result == 0:
+                self.nvm[:] = data[2:-2]
+            crc = crc16(bytes(self.nvm))
+            self.output += bytes([self.sync, result, crc >> 8, crc & 0xFF])
+            return
+        command = data.decode("ascii").strip()
+        if command.startswith("AT$PROV="):
+            baud_rate = int(command.split("=")[1])
+            if baud_rate > self.max_baud_rate:
+                self.output += b"ERROR_0x0201\r\n"
+            else:
+                self.output += b"OK\r\n"
+                self.session = baud_rate
+        elif command == "AT$ID?":
+            self.output += self.nvm[:SIGFOX_EP_ID_SIZE_BYTES].hex().upper().encode("ascii") + b"\r\nOK\r\n"
+        else:
+            self.output += b"ERROR\r\n"
+
+    def readline(self):
+        if b"\n" not in self.output:
+            line, self.output = self.output, b""
+        else:
+            line, self.output = self.output.split(b"\n", 1)
+            line += b"\n"
+        return line
+
+    def read(self, size):
+        data, self.output = self.output[:size], self.output[size:]
+        return data
+
+def self_test(sync, results):
+    global SWITCH_DELAY_S
+    SWITCH_DELAY_S = 0.0
+    if crc16(b"123456789") != 0x29B1:
+        sys.exit("Self-test failed: CRC-16/CCITT reference")
+    data = build_data({ "id": "0012ABCD", "key": "00112233445566778899AABBCCDDEEFF" })
+    result, baud_rate, _ = provision_unit(Device(SimulatedPort(sync, 115200)), data, sync, results, BAUD_RATES)
+    if (result != "SUCCESS") or (baud_rate != 115200):
+        sys.exit("Self-test failed: %s at %s bauds" % (result, baud_rate))
+    result, _, _ = provision_unit(Device(SimulatedPort(sync, 115200, corrupt=True)), data, sync, results, BAUD_RATES)
+    if result != "ERROR_CRC":
+        sys.exit("Self-test failed: corrupted frame gives " + str(result))
+    print("Self-test passed (request %d bytes at %d bauds)" % (len(build_request(sync, data)), baud_rate))
+
+def load_done(path):
+    if not os.path.exists(path):
+        return set()
+    with open(path) as f:
+        return set(row["id"].upper() for row in csv.DictReader(f) if row["result"] == "SUCCESS")
+
+def main():
+    parser = argparse.ArgumentParser(description="Batch Sigfox credentials provisioning.")
+    parser.add_argument("port", nargs="?", help="serial port of the programming jig")
+    parser.add_argument("credentials", nargs="?", help="credentials CSV file (id, key, optional nvm)")
+    parser.add_argument("--report", default="provisioning_report.csv", help="report CSV file (appended)")
+    parser.add_argument("--max-baud-rate", type=int, default=BAUD_RATES[0], help="highest baud rate to negotiate")
+    parser.add_argument("--provisioning-file", default=PROVISIONING_FILE, help="firmware provisioning.h path")
+    parser.add_argument("--self-test", action="store_true", help="check the protocol against a simulated device")
+    args = parser.parse_args()
+    sync, results = parse_protocol(args.provisioning_file)
+    if args.self_test:
+        self_test(sync, results)
+        return
+    if (args.port is None) or (args.credentials is None):
+        sys.exit("Serial port and credentials file are required")
+    import serial
+    baud_rates = [baud_rate for baud_rate in BAUD_RATES if baud_rate <= args.max_baud_rate]
+    done = load_done(args.report)
+    with open(args.credentials) as f:
+        rows = [row for row in csv.DictReader(f) if row["id"].upper() not in done]
+    new_report = not os.path.exists(args.report)
+    with serial.Serial(args.port, CLI_BAUD_RATE, timeout=TIMEOUT_S) as port, open(args.report, "a", newline="") as report:
+        writer = csv.writer(report)
+        if new_report:
+            writer.writerow(["time", "id", "result", "baud_rate", "duration_ms"])
+        device = Device(port)
+        idx = 0
+        while idx < len(rows):
+            row = rows[idx]
+            input("Insert unit for ID %s and press Enter (Ctrl+C to stop)..." % row["id"].upper())
+            result, baud_rate, duration = provision_unit(device, build_data(row), sync, results, baud_rates)
+            writer.writerow([time.strftime("%Y-%m-%d %H:%M:%S"), row["id"].upper(), result, baud_rate, int(duration * 1000)])
+            report.flush()
+            print("%s: %s (%s bauds, %d ms)" % (row["id"].upper(), result, baud_rate, duration * 1000))
+            # Keep the credentials of a failed unit for the next one.
+            if result == "SUCCESS":
+                idx += 1
+
+if __name__ == "__main__":
+    main()
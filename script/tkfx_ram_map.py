@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+#
+# tkfx_ram_map.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# RAM map report: parse the GNU linker map file of a build and print the static RAM usage
+# per output section and per module, including the working buffers shared by the GPS, radio
+# and CLI phases (overlay), the RAM functions, the heap and the stack reservations.
+
+import argparse
+import os
+import re
+
+RAM_ORIGIN = 0x20000000
+RAM_SIZE_BYTES = 8192
+
+OUTPUT_SECTION = re.compile(r"^(\.[\w.]+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)")
+INPUT_SECTION = re.compile(r"^ (\.[\w.]+|COMMON)\s*$|^ (\.[\w.]+|COMMON)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*)$")
+INPUT_SECTION_CONTINUED = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*)$")
+
+def in_ram(address, ram_size_bytes):
+    return (RAM_ORIGIN <= address < (RAM_ORIGIN + ram_size_bytes))
+
+def module_name(object_path):
+    # Archive members are reported as "lib.a(member.o)".
+    match = re.search(r"\(([^)]+)\)$", object_path)
+    if match:
+        return match.group(1)
+    return os.path.basename(object_path)
+
+def parse_map(map_file, ram_size_bytes):
+    output_sections = {}
+    input_sections = []
+    with open(map_file) as f:
+        lines = f.read().splitlines()
+    # Skip discarded sections and memory configuration.
+    start = 0
+    for idx, line in enumerate(lines):
+        if line.startswith("Linker script and memory map"):
+            start = idx + 1
+            break
+    current_output = None
+    pending_input = None
+    for line in lines[start:]:
+        match = OUTPUT_SECTION.match(line)
+        if match:
+            address = int(match.group(2), 16)
+            size = int(match.group(3), 16)
+            current_output = match.group(1)
+            if in_ram(address, ram_size_bytes) and (size > 0):
+                output_sections[current_output] = (address, size)
+            pending_input = None
+            continue
+        if line.startswith(".") and (not line.startswith(" ")):
+            # Output section name alone, address on next line.
+            current_output = line.split()[0]
+            pending_input = None
+            continue
+        match = INPUT_SECTION.match(line)
+        if match:
+            if match.group(1) is not None:
+                pending_input = match.group(1)
+                continue
+            entry = (match.group(2), int(match.group(3), 16), int(match.group(4), 16), match.group(5))
+            pending_input = None
+        else:
+            match = INPUT_SECTION_CONTINUED.match(line)
+            if (match is None) or (pending_input is None):
+                continue
+            entry = (pending_input, int(match.group(1), 16), int(match.group(2), 16), match.group(3))
+            pending_input = None
+        name, address, size, object_path = entry
+        if in_ram(address, ram_size_bytes) and (size > 0):
+            input_sections.append((current_output, name, address, size, module_name(object_path)))
+    return output_sections, input_sections
+
+def report(output_sections, input_sections, ram_size_bytes, top):
+    print("Output sections (RAM):")
+    total = 0
+    for name, (address, size) in sorted(output_sections.items(), key=lambda item: item[1][0]):
+        print("    %-16s 0x%08X %6d bytes" % (name, address, size))
+        total += size
+    print("    %-16s %17d bytes / %d (%.1f%%)" % ("total", total, ram_size_bytes, (100.0 * total) / ram_size_bytes))
+    print("Modules (static RAM):")
+    modules = {}
+    for output, name, address, size, module in input_sections:
+        if output in (".heap", ".stack_dummy"):
+            continue
+        modules[module] = modules.get(module, 0) + size
+    for module, size in sorted(modules.items(), key=lambda item: -item[1])[:top]:
+        print("    %-32s %6d bytes" % (module, size))
+    print("Shared working buffers:")
+    overlay = [entry for entry in input_sections if entry[1].endswith("overlay_buffer")]
+    if len(overlay) == 0:
+        print("    not found (middleware/overlay not linked)")
+    for output, name, address, size, module in overlay:
+        print("    %-32s 0x%08X %6d bytes (GPS, radio and CLI phases)" % (name, address, size))
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="TKFX RAM map report.")
+    parser.add_argument("map_file", help="GNU linker map file (e.g. hw1-1/tkfx.map).")
+    parser.add_argument("--ram-size", type=int, default=RAM_SIZE_BYTES, help="RAM size in bytes.")
+    parser.add_argument("--top", type=int, default=20, help="Number of modules to list.")
+    args = parser.parse_args()
+    output_sections, input_sections = parse_map(args.map_file, args.ram_size)
+    report(output_sections, input_sections, args.ram_size, args.top)
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#
+# tkfx_stack_usage.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Worst-case stack estimate: parse the compiler call graph (.ci files from -fcallgraph-info=su)
+# and stack usage (.su files from -fstack-usage) of a build directory, then print the deepest
+# call chain of main and of each interrupt handler against the reserved stack size.
+
+import argparse
+import os
+import re
+
+STACK_SIZE_BYTES = 1024
+# Cortex-M0+ exception entry pushes 8 registers.
+EXCEPTION_FRAME_BYTES = 32
+ROOT_PATTERN = re.compile(r"^(main|\w+_IRQHandler|\w+_Handler)$")
+
+NODE = re.compile(r'^node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE = re.compile(r'^edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+LABEL_SIZE = re.compile(r"(\d+) bytes \((\w+(?:,\w+)*)\)")
+SU_LINE = re.compile(r"^(.+):(\d+):(\d+):(\S+)\s+(\d+)\s+(\S+)$")
+
+class Function:
+
+    def __init__(self, name):
+        self.name = name
+        self.frame_bytes = None
+        self.qualifier = ""
+        self.callees = set()
+
+def function_name(title):
+    # Static functions are prefixed by their file name.
+    return title.split(":")[-1]
+
+def parse_build(build_directory):
+    functions = {}
+    su_frames = {}
+    for root, directories, files in os.walk(build_directory):
+        for file_name in files:
+            path = os.path.join(root, file_name)
+            if file_name.endswith(".su"):
+                with open(path) as f:
+                    for line in f:
+                        match = SU_LINE.match(line.strip())
+                        if match:
+                            name = match.group(4)
+                            su_frames[name] = max(su_frames.get(name, 0), int(match.group(5)))
+            if file_name.endswith(".ci"):
+                with open(path) as f:
+                    for line in f:
+                        match = NODE.match(line)
+                        if match:
+                            name = function_name(match.group(1))
+                            function = functions.setdefault(name, Function(name))
+                            size = LABEL_SIZE.search(match.group(2).replace("\\n", " "))
+                            if size:
+                                function.frame_bytes = max(function.frame_bytes or 0, int(size.group(1)))
+                                function.qualifier = size.group(2)
+                            continue
+                        match = EDGE.match(line)
+                        if match:
+                            source = functions.setdefault(function_name(match.group(1)), Function(function_name(match.group(1))))
+                            source.callees.add(function_name(match.group(2)))
+    # Functions without call graph information (-fstack-usage only).
+    for name, frame_bytes in su_frames.items():
+        function = functions.setdefault(name, Function(name))
+        if function.frame_bytes is None:
+            function.frame_bytes = frame_bytes
+    return functions
+
+def worst_case(functions, name, indirect_bytes, memo, path, warnings):
+    if name in memo:
+        return memo[name]
+    if name in path:
+        warnings.add("recursion: " + " -> ".join(path[path.index(name):] + [name]))
+        return (0, [])
+    function = functions.get(name)
+    if name == "__indirect_call":
+        return (indirect_bytes, ["<indirect>"])
+    if (function is None) or (function.frame_bytes is None):
+        warnings.add("no stack information: " + name)
+        return (0, [name + "?"])
+    if "dynamic" in function.qualifier:
+        warnings.add("dynamic stack: " + name)
+    deepest = (0, [])
+    for callee in sorted(function.callees):
+        result = worst_case(functions, callee, indirect_bytes, memo, path + [name], warnings)
+        if result[0] > deepest[0]:
+            deepest = result
+    memo[name] = (function.frame_bytes + deepest[0], [name] + deepest[1])
+    return memo[name]
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="TKFX worst-case stack estimate.")
+    parser.add_argument("build_directory", help="Build directory containing .ci and .su files (e.g. hw1-1).")
+    parser.add_argument("--stack-size", type=int, default=STACK_SIZE_BYTES, help="Reserved stack size in bytes.")
+    parser.add_argument("--indirect-bytes", type=int, default=0, help="Stack allowance for indirect calls (callbacks).")
+    parser.add_argument("--top", type=int, default=15, help="Number of largest frames to list.")
+    args = parser.parse_args()
+    functions = parse_build(args.build_directory)
+    memo = {}
+    warnings = set()
+    roots = sorted(name for name in functions if ROOT_PATTERN.match(name) and (functions[name].frame_bytes is not None))
+    results = {}
+    print("Worst-case call chains:")
+    for root in roots:
+        results[root] = worst_case(functions, root, args.indirect_bytes, memo, [], warnings)
+        print("    %-28s %5d bytes  %s" % (root, results[root][0], " > ".join(results[root][1])))
+    print("Largest frames:")
+    frames = sorted((f for f in functions.values() if f.frame_bytes is not None), key=lambda f: -f.frame_bytes)
+    for function in frames[:args.top]:
+        print("    %-40s %5d bytes (%s)" % (function.name, function.frame_bytes, function.qualifier or "su"))
+    main_bytes = results.get("main", (0, []))[0]
+    handlers = sorted((results[root][0] + EXCEPTION_FRAME_BYTES for root in roots if root != "main"), reverse=True)
+    single = main_bytes + (handlers[0] if len(handlers) > 0 else 0)
+    # NVIC priorities 0 to 3: at most 4 nested handlers.
+    nested = main_bytes + sum(handlers[:4])
+    print("Estimate:")
+    print("    main + deepest handler      %5d / %d bytes (%.0f%%)" % (single, args.stack_size, (100.0 * single) / args.stack_size))
+    print("    main + 4 nested handlers    %5d / %d bytes (%.0f%%)" % (nested, args.stack_size, (100.0 * nested) / args.stack_size))
+    if len(warnings) > 0:
+        print("Warnings (estimate is a lower bound for these functions):")
+        for warning in sorted(warnings):
+            print("    " + warning)
@@ -0,0 +1,257 @@
+#!/usr/bin/env python3
+#
+# tkfx_stream_capture.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Capture the binary sensors stream started by AT$STRM=<channels_mask>,<period_ms>.
+#
+# Records are sent as raw bytes right after the OK reply of the command, until the next command. The record layout
+# (sync byte, channels enumeration) is read from middleware/stream/inc/stream.h so that the tool follows the
+# firmware definition. Each record is checked (checksum, sequence counter) and the decoder resynchronizes on
+# the next sync byte after any corrupted record or text reply. Samples are written as a CSV file (one row
+# per record) and optionally as a columnar directory (one raw little endian .bin file per channel, or a single
+# Parquet file when pyarrow is installed).
+#
+# Usage: tkfx_stream_capture.py <port> --channels VSRC_MV,TEMPERATURE_DEGREES --period 100 --output capture.csv
+#                               [--baud-rate 115200] [--duration 60] [--columnar capture_columns]
+#        tkfx_stream_capture.py --self-test
+
+import argparse
+import array
+import csv
+import os
+import re
+import struct
+import sys
+import time
+
+CLI_BAUD_RATE = 9600
+STREAM_HEADER_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "middleware", "stream", "inc", "stream.h")
+STREAM_HEADER_FORMAT = "<BBBI"
+
+# MMA8653FC in +/-2g mode: 16-bits left justified words, 1g = 16384.
+ACC_RAW_PER_G = 16384.0
+
+def parse_header(path=STREAM_HEADER_PATH):
+    # Returns (sync byte, channels names list in mask bit order).
+    with open(path, "r") as header:
+        text = header.read()
+    sync = int(re.search(r"#define\s+STREAM_SYNC\s+(0x[0-9A-Fa-f]+|\d+)", text).group(1), 0)
+    enum = re.search(r"typedef enum \{([^}]*)\}\s*STREAM_channel_t;", text).group(1)
+    channels = []
+    for name in re.findall(r"STREAM_CHANNEL_(\w+)", enum):
+        if name != "LAST":
+            channels.append(name)
+    return sync, channels
+
+def parse_mask(text, channels):
+    # Accepts a hexadecimal mask or a comma separated list of channel names.
+    try:
+        return int(text, 16)
+    except ValueError:
+        mask = 0
+        for name in text.split(","):
+            mask |= (1 << channels.index(name.strip().upper()))
+        return mask
+
+def scale(channel, value):
+    if channel.startswith("ACC_"):
+        return value / ACC_RAW_PER_G
+    return value
+
+def column_name(channel):
+    return channel.replace("_RAW", "_G").lower() if channel.startswith("ACC_") else channel.lower()
+
+class StreamDecoder:
+
+    def __init__(self, sync, channels):
+        self.sync = sync
+        self.channels = channels
+        self.buffer = bytearray()
+        self.sequence = None
+        self.checksum_errors = 0
+        self.lost_records = 0
+        self.skipped_bytes = 0
+
+    def record_size(self, mask):
+        return struct.calcsize(STREAM_HEADER_FORMAT) + (2 * bin(mask).count("1")) + 1
+
+    def feed(self, data):
+        # Returns the list of decoded records (time_ms, {channel: value}).
+        records = []
+        self.buffer += data
+        while True:
+            start = self.buffer.find(self.sync)
+            if start < 0:
+                self.skipped_bytes += len(self.buffer)
+                self.buffer.clear()
+                break
+            self.skipped_bytes += start
+            del self.buffer[:start]
+            if len(self.buffer) < struct.calcsize(STREAM_HEADER_FORMAT):
+                break
+            _, sequence, mask, time_ms = struct.unpack_from(STREAM_HEADER_FORMAT, self.buffer)
+            size = self.record_size(mask)
+            if (mask >> len(self.channels)) != 0:
+                # Not a record header: resynchronize on the next sync byte.
+                self.skipped_bytes += 1
+                del self.buffer[:1]
+                continue
+            if len(self.buffer) < size:
+                break
+            checksum = 0
+            for byte in self.buffer[1:size - 1]:
+                checksum ^= byte
+            if checksum != self.buffer[size - 1]:
+                self.checksum_errors += 1
+                self.skipped_bytes += 1
+                del self.buffer[:1]
+                continue
+            if self.sequence is not None:
+                self.lost_records += (sequence - self.sequence - 1) & 0xFF
+            self.sequence = sequence
+            values = struct.unpack_from("<%dh" % bin(mask).count("1"), self.buffer, struct.calcsize(STREAM_HEADER_FORMAT))
+            selected = [channel for idx, channel in enumerate(self.channels) if (mask >> idx) & 0b1]
+            records.append((time_ms, dict(zip(selected, values))))
+            del self.buffer[:size]
+        return records
+
+def encode_record(sync, sequence, mask, time_ms, values):
+    # Firmware record builder (used by the self-test).
+    record = bytearray(struct.pack(STREAM_HEADER_FORMAT, sync, sequence & 0xFF, mask, time_ms & 0xFFFFFFFF))
+    record += struct.pack("<%dh" % len(values), *values)
+    checksum = 0
+    for byte in record[1:]:
+        checksum ^= byte
+    return bytes(record + bytes([checksum]))
+
+class CaptureWriter:
+
+    def __init__(self, csv_path, columnar_path, channels):
+        self.channels = channels
+        self.csv_file = open(csv_path, "w", newline="")
+        self.csv_writer = csv.writer(self.csv_file)
+        self.csv_writer.writerow(["time_ms"] + [column_name(channel) for channel in channels])
+        self.columnar_path = columnar_path
+        self.columns = {"time_ms": array.array("I")}
+        for channel in channels:
+            self.columns[column_name(channel)] = array.array("d")
+        self.count = 0
+
+    def write(self, time_ms, values):
+        row = [time_ms]
+        self.columns["time_ms"].append(time_ms)
+        for channel in self.channels:
+            value = scale(channel, values[channel])
+            row.append(value)
+            self.columns[column_name(channel)].append(value)
+        self.csv_writer.writerow(row)
+        self.count += 1
+
+    def close(self):
+        self.csv_file.close()
+        if self.columnar_path is None:
+            return
+        try:
+            import pyarrow
+            import pyarrow.parquet
+            table = pyarrow.table({name: list(column) for name, column in self.columns.items()})
+            pyarrow.parquet.write_table(table, self.columnar_path + ".parquet")
+        except ImportError:
+            os.makedirs(self.columnar_path, exist_ok=True)
+            for name, column in self.columns.items():
+                with open(os.path.join(self.columnar_path, "%s.%s.bin" % (name, column.typecode)), "wb") as column_file:
+                    if sys.byteorder != "little":
+                        column = array.array(column.typecode, column)
+                        column.byteswap()
+                    column.tofile(column_file)
+
+def command(port, text, timeout_s=2.0):
+    port.reset_input_buffer()
+    port.write((text + "\r").encode("ascii"))
+    deadline = time.monotonic() + timeout_s
+    while time.monotonic() < deadline:
+        line = port.readline().decode("ascii", "replace").strip()
+        if (line == "OK") or line.startswith("ERROR"):
+            return line
+    return "TIMEOUT"
+
+def self_test():
+    sync, channels = parse_header()
+    decoder = StreamDecoder(sync, channels)
+    mask = 0b10100101
+    selected = [idx for idx in range(len(channels)) if (mask >> idx) & 0b1]
+    stream = bytearray(b"OK\r\n")
+    for sequence in range(300):
+        values = [((sequence * 37) + idx * 1000) - 2000 for idx in selected]
+        # Values equal to the sync byte must not confuse the decoder.
+        values[0] = sync
+        stream += encode_record(sync, sequence, mask, sequence * 100, values)
+    records = []
+    for offset in range(0, len(stream), 13):
+        records += decoder.feed(stream[offset:offset + 13])
+    if (len(records) != 300) or decoder.lost_records or decoder.checksum_errors:
+        sys.exit("Self-test failed: valid stream rejected")
+    if records[299][1][channels[selected[1]]] != ((299 * 37) + selected[1] * 1000) - 2000:
+        sys.exit("Self-test failed: wrong value")
+    # Corrupted byte and dropped record.
+    decoder = StreamDecoder(sync, channels)
+    corrupted = bytearray()
+    for sequence in range(20):
+        if sequence == 10:
+            continue
+        record = bytearray(encode_record(sync, sequence, mask, sequence * 100, [sequence] * len(selected)))
+        if sequence == 5:
+            record[8] ^= 0x10
+        corrupted += record
+    records = decoder.feed(corrupted)
+    if (len(records) != 18) or (decoder.checksum_errors == 0) or (decoder.lost_records != 2):
+        sys.exit("Self-test failed: corruption not detected")
+    print("Self-test passed")
+
+def main():
+    parser = argparse.ArgumentParser(description="Binary sensors stream capture.")
+    parser.add_argument("port", nargs="?", help="serial port")
+    parser.add_argument("--channels", default="FF", help="hexadecimal mask or comma separated channel names")
+    parser.add_argument("--period", type=int, default=100, help="sampling period in ms")
+    parser.add_argument("--baud-rate", type=int, default=CLI_BAUD_RATE, help="terminal baud rate (switched with AT$BAUD)")
+    parser.add_argument("--duration", type=float, default=10.0, help="capture duration in seconds")
+    parser.add_argument("--output", default="stream.csv", help="CSV output file")
+    parser.add_argument("--columnar", default=None, help="columnar output path (Parquet if pyarrow is available, else raw columns directory)")
+    parser.add_argument("--self-test", action="store_true", help="check the record decoder")
+    args = parser.parse_args()
+    if args.self_test:
+        self_test()
+        return
+    if args.port is None:
+        sys.exit("Serial port is required")
+    import serial
+    sync, channels = parse_header()
+    mask = parse_mask(args.channels, channels)
+    selected = [channel for idx, channel in enumerate(channels) if (mask >> idx) & 0b1]
+    decoder = StreamDecoder(sync, channels)
+    writer = CaptureWriter(args.output, args.columnar, selected)
+    with serial.Serial(args.port, CLI_BAUD_RATE, timeout=0.1) as port:
+        if args.baud_rate != CLI_BAUD_RATE:
+            if command(port, "AT$BAUD=%d" % args.baud_rate) != "OK":
+                sys.exit("Baud rate switch failed")
+            port.baudrate = args.baud_rate
+            time.sleep(0.05)
+        answer = command(port, "AT$STRM=%X,%d" % (mask, args.period))
+        if answer != "OK":
+            sys.exit("Stream start failed: " + answer)
+        deadline = time.monotonic() + args.duration
+        while time.monotonic() < deadline:
+            for time_ms, values in decoder.feed(port.read(port.in_waiting or 1)):
+                writer.write(time_ms, values)
+        # Any command stops the stream.
+        command(port, "AT")
+        if port.baudrate != CLI_BAUD_RATE:
+            command(port, "AT$BAUD=%d" % CLI_BAUD_RATE)
+    writer.close()
+    print("%d records, %d lost, %d checksum errors, %d bytes skipped" % (writer.count, decoder.lost_records, decoder.checksum_errors, decoder.skipped_bytes))
+
+if __name__ == "__main__":
+    main()
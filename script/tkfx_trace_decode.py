@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+#
+# tkfx_trace_decode.py
+#
+#  Created on: 17 oct. 2026
+#      Author: Ludo
+#
+# Decode the events trace ring (middleware/trace) into a readable timeline.
+#
+# Input formats:
+#   - CLI capture of the $TRACE? command ('<index>:<timestamp_ms>,<event>,<data_8bits>,<data_16bits>' lines).
+#   - raw memory dump of the TRACE_ring_t structure (--bin), placed first in the .noinit section at the start of RAM.
+#     Example with J-Link Commander: savebin trace.bin 0x20000000 <sizeof(TRACE_ring_t)>
+#
+# Event names, state names, power domains and GPS outcomes are read from the firmware sources.
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+ROOT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+MAIN_FILE = os.path.join(ROOT_DIR, "application", "src", "main.c")
+TRACE_FILE = os.path.join(ROOT_DIR, "middleware", "trace", "inc", "trace.h")
+POWER_FILE = os.path.join(ROOT_DIR, "middleware", "power", "inc", "power.h")
+GPS_FILE = os.path.join(ROOT_DIR, "middleware", "gps", "inc", "gps.h")
+
+HEADER_FORMAT = "<IIII"
+RECORD_FORMAT = "<IBBH"
+RADIO_DISABLED = 0xFFFF
+
+def parse_enum(path, name, prefix):
+    with open(path) as f:
+        content = f.read()
+    match = re.search(r"typedef enum \{([^{}]*?)\} " + name + ";", content, re.S)
+    if match is None:
+        sys.exit("Enum " + name + " not found in " + path)
+    entries = [entry for entry in re.findall(r"^\s*(\w+)", match.group(1), re.M) if not entry.endswith("_LAST")]
+    return [entry.replace(prefix, "") for entry in entries]
+
+def parse_define(path, name):
+    with open(path) as f:
+        return int(re.search(r"#define " + name + r"\s+(\w+)", f.read()).group(1), 0)
+
+def load_cli(path):
+    # Returns (index, timestamp_ms, event, data_8bits, data_16bits) list.
+    records = []
+    with open(path) as f:
+        for line in f:
+            match = re.search(r"(\d+):(-?\d+),(\d+),(\d+),(\d+)", line)
+            if match is not None:
+                index, timestamp, event, data_8bits, data_16bits = [int(value) for value in match.groups()]
+                records.append((index, timestamp & 0xFFFFFFFF, event, data_8bits, data_16bits))
+    return records
+
+def load_bin(path, depth, magic):
+    with open(path, "rb") as f:
+        content = f.read()
+    header_size = struct.calcsize(HEADER_FORMAT)
+    record_size = struct.calcsize(RECORD_FORMAT)
+    if len(content) < (header_size + depth * record_size):
+        sys.exit("Dump too short: %d bytes, %d expected" % (len(content), header_size + depth * record_size))
+    ring_magic, index, index_check, boot_count = struct.unpack_from(HEADER_FORMAT, content, 0)
+    if (ring_magic != magic) or (index_check != ((~index) & 0xFFFFFFFF)):
+        sys.exit("Invalid trace ring (magic 0x%08X, index %d)" % (ring_magic, index))
+    records = []
+    for position in range(max(0, index - depth), index):
+        fields = struct.unpack_from(RECORD_FORMAT, content, header_size + (position % depth) * record_size)
+        records.append((position,) + fields)
+    return records
+
+def describe(event, data_8bits, data_16bits, names):
+    events, states, domains, gps = names
+    name = events[event] if event < len(events) else "EVENT_%d" % event
+    if name == "RESET":
+        flags = [flag for bit, flag in enumerate(["FW", "OBL", "PIN", "POR", "SFT", "IWDG", "WWDG", "LPWR"]) if data_8bits & (1 << bit)]
+        return name, "boot %d flags %s" % (data_16bits, "|".join(flags) or "none")
+    if name == "STATE":
+        return name, states[data_8bits] if data_8bits < len(states) else str(data_8bits)
+    if name == "POWER":
+        return name, "%s %s" % (domains[data_8bits] if data_8bits < len(domains) else str(data_8bits), "on" if data_16bits else "off")
+    if name == "RADIO":
+        if data_16bits == RADIO_DISABLED:
+            return name, "%d bytes dropped (radio disabled)" % data_8bits
+        return name, "%d bytes status 0x%04X%s" % (data_8bits, data_16bits, "" if data_16bits == 0 else " ERROR")
+    if name == "GPS":
+        return name, "%s after %d s" % (gps[data_8bits] if data_8bits < len(gps) else str(data_8bits), data_16bits)
+    return name, "0x%02X 0x%04X" % (data_8bits, data_16bits)
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode the firmware events trace.")
+    parser.add_argument("capture", help="CLI $TRACE? capture or raw ring dump (--bin)")
+    parser.add_argument("--bin", action="store_true", help="capture is a raw TRACE_ring_t memory dump")
+    parser.add_argument("--main-file", default=MAIN_FILE, help="firmware main.c path")
+    parser.add_argument("--trace-file", default=TRACE_FILE, help="firmware trace.h path")
+    parser.add_argument("--power-file", default=POWER_FILE, help="firmware power.h path")
+    parser.add_argument("--gps-file", default=GPS_FILE, help="firmware gps.h path")
+    args = parser.parse_args()
+    names = (parse_enum(args.trace_file, "TRACE_event_t", "TRACE_EVENT_"),
+             parse_enum(args.main_file, "TKFX_state_t", "TKFX_STATE_"),
+             parse_enum(args.power_file, "POWER_domain_t", "POWER_DOMAIN_"),
+             parse_enum(args.gps_file, "GPS_acquisition_status_t", "GPS_ACQUISITION_"))
+    if args.bin:
+        records = load_bin(args.capture, parse_define(args.trace_file, "TRACE_DEPTH"), parse_define(args.trace_file, "TRACE_MAGIC"))
+    else:
+        records = load_cli(args.capture)
+    if not records:
+        sys.exit("No trace record found")
+    previous_ms = None
+    for index, timestamp_ms, event, data_8bits, data_16bits in records:
+        name, details = describe(event, data_8bits, data_16bits, names)
+        if name == "RESET":
+            print("-" * 60)
+            previous_ms = None
+        delta = "" if previous_ms is None else "+%d ms" % ((timestamp_ms - previous_ms) & 0xFFFFFFFF)
+        print("%6d %12.3f %12s  %-6s %s" % (index, timestamp_ms / 1000.0, delta, name, details))
+        previous_ms = timestamp_ms
+
+if __name__ == "__main__":
+    main()
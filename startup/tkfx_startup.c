@@ -5,6 +5,7 @@
  *      Author: ARM
  */
 
+#include "ram.h"
 #include "types.h"
 
 /*----------------------------------------------------------------------------
@@ -13,6 +14,9 @@
 extern uint32_t __etext;
 extern uint32_t __data_start__;
 extern uint32_t __data_end__;
+extern uint32_t __ramfunc_load__;
+extern uint32_t __ramfunc_start__;
+extern uint32_t __ramfunc_end__;
 #ifdef __STARTUP_COPY_MULTIPLE
 extern uint32_t __copy_table_start__;
 extern uint32_t __copy_table_end__;
@@ -21,6 +25,7 @@ extern uint32_t __zero_table_end__;
 #endif
 extern uint32_t __bss_start__;
 extern uint32_t __bss_end__;
+extern uint32_t __HeapLimit;
 extern uint32_t __StackTop;
 
 /*----------------------------------------------------------------------------
@@ -56,7 +61,7 @@ void Reset_Handler(void); /* Reset Handler */
 static uint8_t stack[__STACK_SIZE]          __attribute__ ((aligned(8), used, section(".stack")));
 
 #ifndef __HEAP_SIZE
-#define __HEAP_SIZE     0x00000C00
+#define __HEAP_SIZE     0x00000000 /* No dynamic allocation */
 #endif
 #if __HEAP_SIZE > 0
 static uint8_t heap[__HEAP_SIZE]            __attribute__ ((aligned(8), used, section(".heap")));
@@ -165,6 +170,7 @@ const pFunc __Vectors[] __attribute__ ((section(".vectors"))) = {
 void Reset_Handler(void) {
     uint32_t* pSrc, * pDest;
     uint32_t* pTable __attribute__((unused));
+    uint32_t* pStack;
 
     /*  Firstly it copies data from read only memory to RAM. There are two schemes
      *  to copy. One can copy more than one sections. Another can only copy
@@ -210,6 +216,22 @@ void Reset_Handler(void) {
     }
 #endif /*__STARTUP_COPY_MULTIPLE */
 
+    /*  Copy functions executed from RAM (.ramfunc section).
+     *
+     *  The ranges of copy from/to are specified by following symbols
+     *    __ramfunc_load__: LMA of start of the section to copy from
+     *    __ramfunc_start__: VMA of start of the section to copy to
+     *    __ramfunc_end__: VMA of end of the section to copy to
+     *
+     *  All addresses must be aligned to 4 bytes boundary.
+     */
+    pSrc = &__ramfunc_load__;
+    pDest = &__ramfunc_start__;
+
+    for (; pDest < &__ramfunc_end__;) {
+        *pDest++ = *pSrc++;
+    }
+
     /*  This part of work usually is done in C library startup code. Otherwise,
      *  define this macro to enable it in this startup.
      *
@@ -252,6 +274,20 @@ void Reset_Handler(void) {
     }
 #endif /* __STARTUP_CLEAR_BSS_MULTIPLE || __STARTUP_CLEAR_BSS */
 
+    /*  Paint the free RAM and the stack below the current stack pointer.
+     *
+     *  The area between __HeapLimit and the stack pointer is filled with
+     *  RAM_PAINT_PATTERN so that the stack high-water mark can be computed
+     *  at run time. The free RAM between the heap and the stack limit acts
+     *  as a guard area to detect stack overflows.
+     */
+    __asm volatile ("mov %0, sp" : "=r" (pStack));
+    pDest = &__HeapLimit;
+
+    for (; pDest < pStack;) {
+        *pDest++ = RAM_PAINT_PATTERN;
+    }
+
 #ifndef __NO_SYSTEM_INIT
     SystemInit();
 #endif